@@ -12,32 +12,186 @@ class Clock {
 }
 #include <string>
 #include <functional>
+#include <future>
+#include <cstddef>
+#include <functional>
+#include <iterator>
 #include <string>
 #include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <array>
+#include <cstddef>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
+#if __has_include(<string_view>)
+#include <string_view>
+namespace stdx = std;
+#elif __has_include(<experimental/string_view>)
+#include <experimental/string_view>
+namespace stdx = std::experimental;
+#else
+#error Must have a string_view type, either from <string_view> or from <experimental/string_view>.
+#endif
 namespace Db {
 
 class Cursor {
    public:
     virtual bool next() = 0;
 
+
     template<typename T>
     T get(int colIndex);
 
+
+    template<typename... Ts, typename Consumer>
+    void forEachRow(Consumer &&consumer) {
+        ensureColumnCount(sizeof...(Ts));
+        static constexpr std::array<ColumnType, sizeof...(Ts)> types{{columnTypeOf<Ts>()...}};
+        using ConsumerType = std::remove_reference_t<Consumer>;
+
+        RowReader reader = [](const void *consumerPointer, const Value *values) {
+            auto &rowConsumer = *static_cast<ConsumerType *>(const_cast<void *>(consumerPointer));
+            consumeRow<Ts...>(rowConsumer, values, std::index_sequence_for<Ts...>());
+        };
+        readRows(types.data(), static_cast<int>(sizeof...(Ts)), reader, &consumer);
+    }
+
+
+    template<typename... Ts>
+    std::vector<std::tuple<Ts...>> rows() {
+        std::vector<std::tuple<Ts...>> result;
+        forEachRow<Ts...>([&result](Ts... values) {
+            result.emplace_back(std::move(values)...);
+        });
+        return result;
+    }
+
    protected:
+
+    enum class ColumnType {
+        Integer = 1,
+        Float = 2,
+        Text = 3,
+        Blob = 4,
+        Null = 5
+    };
+
+
+    struct Value {
+        long long integer;
+        double real;
+        const char *text;
+        size_t size;
+    };
+
+
+    using RowReader = void (*)(const void *consumer, const Value *values);
+
+
+    virtual void readRows(const ColumnType *types, int count, RowReader reader, const void *consumer) = 0;
+
+    [[noreturn]] static void throwTypeMismatch(int colIndex, ColumnType expected, ColumnType actual);
+
+    virtual int getColumnCount() = 0;
+
     virtual void ensureNextWasInvoked() = 0;
 
     virtual void ensureIndexInBounds(int colIndex) = 0;
 
     virtual int getInt(int colIndex) = 0;
 
+    virtual long long getInt64(int colIndex) = 0;
+
     virtual double getDouble(int colIndex) = 0;
 
     virtual std::string getString(int colIndex) = 0;
 
+    virtual stdx::string_view getStringView(int colIndex) = 0;
+
     virtual bool getBool(int colIndex) = 0;
+
+   private:
+    void ensureColumnCount(int expectedCount);
+
+    template<typename T>
+    static constexpr ColumnType columnTypeOf();
+
+    template<typename T>
+    static T decode(const Value &value);
+
+    template<typename... Ts, typename Consumer, size_t... Is>
+    static void consumeRow(Consumer &consumer, const Value *values, std::index_sequence<Is...>) {
+        consumer(decode<Ts>(values[Is])...);
+    }
 };
+
+
+
+template<>
+constexpr Cursor::ColumnType Cursor::columnTypeOf<int>() {
+    return ColumnType::Integer;
+}
+
+template<>
+constexpr Cursor::ColumnType Cursor::columnTypeOf<long long>() {
+    return ColumnType::Integer;
+}
+
+template<>
+constexpr Cursor::ColumnType Cursor::columnTypeOf<bool>() {
+    return ColumnType::Integer;
+}
+
+template<>
+constexpr Cursor::ColumnType Cursor::columnTypeOf<double>() {
+    return ColumnType::Float;
+}
+
+template<>
+constexpr Cursor::ColumnType Cursor::columnTypeOf<stdx::string_view>() {
+    return ColumnType::Text;
+}
+
+template<>
+constexpr Cursor::ColumnType Cursor::columnTypeOf<std::string>() {
+    return ColumnType::Text;
+}
+
+template<>
+inline int Cursor::decode(const Value &value) {
+    return static_cast<int>(value.integer);
+}
+
+template<>
+inline long long Cursor::decode(const Value &value) {
+    return value.integer;
+}
+
+template<>
+inline double Cursor::decode(const Value &value) {
+    return value.real;
+}
+
+template<>
+inline bool Cursor::decode(const Value &value) {
+    return value.integer != 0;
+}
+
+template<>
+inline stdx::string_view Cursor::decode(const Value &value) {
+    return stdx::string_view(value.text, value.size);
+}
+
+template<>
+inline std::string Cursor::decode(const Value &value) {
+    return std::string(value.text, value.size);
+}
 }
 #if __has_include(<optional>)
 #include <optional>
@@ -52,13 +206,51 @@ namespace Db {
 
 class Statement {
    public:
+
+    enum class BatchMode {
+
+        ContinueOnFailure,
+
+        AbortOnFailure
+    };
+
+    struct BatchFailure {
+
+        size_t row;
+        std::string message;
+    };
+
+    struct BatchResult {
+        size_t executedRows;
+        std::vector<BatchFailure> failures;
+    };
+
     template<typename T>
     void bind(int colIndex, T value);
 
     template<typename T>
     T execute();
 
+
+    template<typename Rows>
+    BatchResult executeBatch(const Rows &rows, BatchMode mode = BatchMode::ContinueOnFailure) {
+        auto row = std::begin(rows);
+        auto end = std::end(rows);
+        return executeBatchRows([&]() {
+            if (row == end) {
+                return false;
+            }
+            using Row = typename std::decay<decltype(*row)>::type;
+            bindRow(*row, std::make_index_sequence<std::tuple_size<Row>::value>());
+            ++row;
+            return true;
+        }, mode);
+    }
+
    protected:
+
+    virtual BatchResult executeBatchRows(const std::function<bool()> &bindNextRow, BatchMode mode) = 0;
+
     virtual void executeVoid() = 0;
 
     virtual stdx::optional<int> executeOptionalInt() = 0;
@@ -71,30 +263,153 @@ class Statement {
 
     virtual void bindInt(int colIndex, int value) = 0;
 
+    virtual void bindInt64(int colIndex, long long value) = 0;
+
     virtual void bindDouble(int colIndex, double value) = 0;
 
     virtual void bindString(int colIndex, std::string value) = 0;
 
     virtual void bindBool(int colIndex, bool value) = 0;
+
+   private:
+    template<typename Row, size_t... Is>
+    void bindRow(const Row &row, std::index_sequence<Is...>) {
+
+        (bind(static_cast<int>(Is) + 1, std::get<Is>(row)), ...);
+    }
 };
 }
+#include <string>
+#include <vector>
+
 namespace Db {
 
+
+struct TableChanges {
+    std::string table;
+    std::vector<long long> insertedRowIds;
+    std::vector<long long> updatedRowIds;
+    std::vector<long long> deletedRowIds;
+};
+
+inline bool operator==(const TableChanges &first, const TableChanges &second) {
+    return first.table == second.table &&
+        first.insertedRowIds == second.insertedRowIds &&
+        first.updatedRowIds == second.updatedRowIds &&
+        first.deletedRowIds == second.deletedRowIds;
+}
+}
+namespace Db {
+
+
+enum class TransactionMode {
+
+    Deferred,
+
+    Immediate,
+
+    Exclusive
+};
+
 class Database {
    public:
-    virtual void executeTransaction(std::function<void()> transact) const = 0;
+
+    virtual void executeTransaction(std::function<void()> transact,
+                                    TransactionMode mode = TransactionMode::Deferred) const = 0;
+
+
+    virtual std::future<void> submitTransaction(std::function<void()> transact) const = 0;
 
     [[nodiscard]] virtual std::shared_ptr<Statement> createStatement(std::string sql) const = 0;
+
+
+    virtual int addChangeListener(std::function<void(const std::vector<TableChanges> &)> listener) const = 0;
+
+    virtual void removeChangeListener(int listenerId) const = 0;
+
+
+    [[nodiscard]] virtual long long dataVersion() const = 0;
 };
 }
 #include <string>
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace Db {
+
+enum class JournalMode {
+    Delete,
+    Truncate,
+    Persist,
+    Memory,
+    Wal,
+    Off
+};
+
+enum class Synchronous {
+    Off,
+    Normal,
+    Full,
+    Extra
+};
+
+enum class TempStore {
+    Default,
+    File,
+    Memory
+};
+
+
+struct BusyPolicy {
+
+    std::chrono::milliseconds timeout{0};
+
+
+
+    std::chrono::milliseconds initialBackoff{1};
+    std::chrono::milliseconds maxBackoff{64};
+
+
+
+    int transactionRetries = 0;
+};
+
+
+struct Options {
+    stdx::optional<JournalMode> journalMode;
+    stdx::optional<Synchronous> synchronous;
+
+    stdx::optional<int64_t> mmapSize;
+
+    stdx::optional<int> cacheSize;
+
+    stdx::optional<int> pageSize;
+    stdx::optional<TempStore> tempStore;
+
+    bool uri = false;
+
+    size_t statementCacheCapacity = 64;
 
+
+    size_t readerConnections = 0;
+    BusyPolicy busyPolicy;
+
+
+    bool writerThread = false;
+
+    size_t maxGroupedTransactions = 64;
+
+    bool profiling = false;
+};
+}
 namespace Db {
 
 class Client {
    public:
-    static void create(std::string dbPath);
+    static void create(std::string dbPath, const Options &options = Options());
 
     static std::shared_ptr<Database> get();
 
@@ -122,6 +437,17 @@ class Draft {
 
     friend bool operator==(const Draft &first, const Draft &second);
 };
+#include <chrono>
+#include <cstddef>
+
+
+struct DraftFlushPolicy {
+
+    std::chrono::milliseconds debounce{500};
+
+
+    size_t dirtyBytesThreshold = 16 * 1024;
+};
 #include <string>
 #include <ctime>
 
@@ -148,17 +474,132 @@ class Note {
 #include <string>
 
 
+
 namespace NoteDb {
 
-const int version = 2;
+const int version = 6;
 
-void initialize(std::string path);
+void initialize(std::string path, const Db::Options &options = Db::Options());
+}
+#include <cstddef>
+#include <ctime>
+#include <string>
+#include <vector>
 
-  namespace {
+class NoteMatch {
+   public:
+    struct Range {
+        size_t start;
+        size_t length;
 
-void createSchema(const std::shared_ptr<Db::Database> &db);
-}
-}
+        friend bool operator==(const Range &first, const Range &second);
+    };
+
+    NoteMatch(int id,
+              std::string title,
+              std::string snippet,
+              std::vector<Range> titleMatches,
+              std::vector<Range> snippetMatches,
+              std::time_t lastUpdateDate);
+
+    [[nodiscard]] int getId() const;
+
+    [[nodiscard]] std::string getTitle() const;
+
+    [[nodiscard]] std::string getSnippet() const;
+
+    [[nodiscard]] std::vector<Range> getTitleMatches() const;
+
+    [[nodiscard]] std::vector<Range> getSnippetMatches() const;
+
+    [[nodiscard]] std::time_t getLastUpdateTime() const;
+
+    friend bool operator==(const NoteMatch &first, const NoteMatch &second);
+
+   private:
+    int id;
+    std::string title;
+    std::string snippet;
+    std::vector<Range> titleMatches;
+    std::vector<Range> snippetMatches;
+    std::time_t lastUpdateDate;
+};
+#include <string>
+#include <ctime>
+
+class NoteSummary {
+   public:
+    NoteSummary(int id, std::string title, std::string snippet, std::time_t lastUpdateDate);
+
+    [[nodiscard]] int getId() const;
+
+    [[nodiscard]] std::string getTitle() const;
+
+    [[nodiscard]] std::string getSnippet() const;
+
+    [[nodiscard]] std::time_t getLastUpdateTime() const;
+
+    friend bool operator==(const NoteSummary &first, const NoteSummary &second);
+
+   private:
+    int id;
+    std::string title;
+    std::string snippet;
+    std::time_t lastUpdateDate;
+};
+#include <ctime>
+#include <vector>
+
+class NotesPage {
+   public:
+    class Key {
+       public:
+        Key(std::time_t lastUpdateDate, int id);
+
+        [[nodiscard]] std::time_t getLastUpdateTime() const;
+
+        [[nodiscard]] int getId() const;
+
+        friend bool operator==(const Key &first, const Key &second);
+
+       private:
+        std::time_t lastUpdateDate;
+        int id;
+    };
+
+    NotesPage(std::vector<Note> notes, stdx::optional<Key> nextKey);
+
+    [[nodiscard]] std::vector<Note> getNotes() const;
+
+    [[nodiscard]] stdx::optional<Key> getNextKey() const;
+
+    friend bool operator==(const NotesPage &first, const NotesPage &second);
+
+   private:
+    std::vector<Note> notes;
+    stdx::optional<Key> nextKey;
+};
+#include <vector>
+
+
+class NotesChange {
+   public:
+    NotesChange(std::vector<int> insertedIds, std::vector<int> updatedIds, std::vector<int> deletedIds);
+
+    [[nodiscard]] std::vector<int> getInsertedIds() const;
+
+    [[nodiscard]] std::vector<int> getUpdatedIds() const;
+
+    [[nodiscard]] std::vector<int> getDeletedIds() const;
+
+    friend bool operator==(const NotesChange &first, const NotesChange &second);
+
+   private:
+    std::vector<int> insertedIds;
+    std::vector<int> updatedIds;
+    std::vector<int> deletedIds;
+};
+#include <functional>
 #include <vector>
 
 
@@ -166,9 +607,12 @@ void createSchema(const std::shared_ptr<Db::Database> &db);
 
 class NotesInteractor {
    public:
-    virtual void insertNote(Draft note) = 0;
 
-    virtual void updateNote(int id, Draft note) = 0;
+
+    virtual Note insertNote(Draft note) = 0;
+
+
+    virtual stdx::optional<Note> updateNote(int id, Draft note) = 0;
 
     virtual void updateNewDraftTitle(std::string title) = 0;
 
@@ -178,10 +622,49 @@ class NotesInteractor {
 
     virtual void updateExistingDraftDescription(int id, std::string description) = 0;
 
+
+
+
+
+
+
+
+    virtual void insertInNewDraftDescription(size_t offset, std::string text) = 0;
+
+
+
+
+
+
+
+    virtual void eraseFromNewDraftDescription(size_t offset, size_t count) = 0;
+
+
+
+
+
+    virtual void insertInExistingDraftDescription(int id, size_t offset, std::string text) = 0;
+
+
+
+
+
+    virtual void eraseFromExistingDraftDescription(int id, size_t offset, size_t count) = 0;
+
     virtual std::vector<Note> getAllNotes() = 0;
 
+    virtual NotesPage getNotesPage(size_t size, stdx::optional<NotesPage::Key> after) = 0;
+
+    virtual void forEachNote(const std::function<void(Note)> &consumer) = 0;
+
+    virtual std::vector<NoteSummary> getNoteSummaries() = 0;
+
+    virtual stdx::optional<Note> getNoteById(int id) = 0;
+
     virtual std::vector<Note> getNotesByText(std::string text) = 0;
 
+    virtual std::vector<NoteMatch> getNotesByText(std::string text, size_t limit) = 0;
+
     virtual stdx::optional<Draft> getNewDraft() = 0;
 
     virtual stdx::optional<Draft> getExistingDraft(int id) = 0;
@@ -193,13 +676,22 @@ class NotesInteractor {
     virtual void deleteExistingDraft(int id) = 0;
 
     virtual void persistChanges() = 0;
+
+
+    virtual int subscribe(std::function<void(NotesChange)> listener) = 0;
+
+    virtual void unsubscribe(int subscriptionId) = 0;
 };
 #include <memory>
+#include <string>
 
 
 class NotesInteractorFactory {
    public:
-    static std::shared_ptr<NotesInteractor> create();
+    static std::shared_ptr<NotesInteractor> create(size_t noteCacheBudget = 0,
+                                                   stdx::optional<DraftFlushPolicy> draftFlushPolicy = stdx::nullopt,
+                                                   bool preloadDrafts = false,
+                                                   const stdx::optional<std::string> &draftLogPath = stdx::nullopt);
 };
 #include <string>
 #include <ctime>
@@ -208,7 +700,13 @@ namespace Time::Format {
 
 typedef std::string ISO_8601;
 
+const size_t length = 20;
+
 ISO_8601 format(std::time_t time);
 
-std::time_t parse(ISO_8601 formattedTime);
+char *format(std::time_t time, char *buffer);
+
+std::time_t parse(stdx::string_view formattedTime);
+
+stdx::optional<std::time_t> tryParse(stdx::string_view formattedTime);
 }
@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <cstdio>
+#include "benchmark.hpp"
+
+namespace Bench {
+
+/* PRIVATE */ namespace {
+
+// Upper bound of the measured iterations, to avoid to collect too many samples for the fastest benchmarks.
+const size_t maxIterations = 1000000;
+
+// Every benchmark runs at least for this time, unless it reaches maxIterations before.
+const std::chrono::milliseconds minTime(300);
+
+struct Entry {
+    std::string name;
+    Function function;
+    size_t minIterations;
+};
+
+std::vector<Entry> &registry() {
+    // A function-local static avoids any issue with the initialization order of the static registrations.
+    static std::vector<Entry> entries;
+    return entries;
+}
+
+std::string formatDuration(double nanos) {
+    char buffer[32];
+    if (nanos < 1e3) {
+        snprintf(buffer, sizeof buffer, "%.0fns", nanos);
+    } else if (nanos < 1e6) {
+        snprintf(buffer, sizeof buffer, "%.2fus", nanos / 1e3);
+    } else if (nanos < 1e9) {
+        snprintf(buffer, sizeof buffer, "%.2fms", nanos / 1e6);
+    } else {
+        snprintf(buffer, sizeof buffer, "%.2fs", nanos / 1e9);
+    }
+    return buffer;
+}
+
+double percentile(const std::vector<std::chrono::nanoseconds> &sorted, double fraction) {
+    auto index = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1));
+    return static_cast<double>(sorted[index].count());
+}
+
+void report(const std::string &name, const State &state) {
+    auto sorted = state.samples();
+    if (sorted.empty()) {
+        printf("%-56s no iterations\n", name.c_str());
+        return;
+    }
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0;
+    for (auto sample : sorted) {
+        total += static_cast<double>(sample.count());
+    }
+    double mean = total / static_cast<double>(sorted.size());
+    printf("%-56s %9zu it  mean %10s  p50 %10s  p90 %10s  p99 %10s",
+           name.c_str(),
+           sorted.size(),
+           formatDuration(mean).c_str(),
+           formatDuration(percentile(sorted, 0.5)).c_str(),
+           formatDuration(percentile(sorted, 0.9)).c_str(),
+           formatDuration(percentile(sorted, 0.99)).c_str());
+    if (state.itemsPerIteration() > 0) {
+        double itemsPerSecond = static_cast<double>(state.itemsPerIteration()) * 1e9 / mean;
+        printf("  %14.0f items/s", itemsPerSecond);
+    }
+    printf("\n");
+    fflush(stdout);
+}
+}
+
+State::State(size_t minIterations, std::chrono::nanoseconds minTime) :
+    minIterations(minIterations),
+    minTime(minTime) {}
+
+bool State::keepRunning() {
+    auto now = Clock::now();
+    if (started) {
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - iterationStart) - pausedTime;
+        iterationSamples.push_back(elapsed);
+        totalTime += elapsed;
+    }
+    started = true;
+    bool enoughIterations = iterationSamples.size() >= minIterations && totalTime >= minTime;
+    if (enoughIterations || iterationSamples.size() >= maxIterations) {
+        return false;
+    }
+    pausedTime = std::chrono::nanoseconds(0);
+    iterationStart = Clock::now();
+    return true;
+}
+
+void State::pauseTiming() {
+    pauseStart = Clock::now();
+}
+
+void State::resumeTiming() {
+    pausedTime += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - pauseStart);
+}
+
+void State::setItemsPerIteration(size_t items) {
+    this->items = items;
+}
+
+const std::vector<std::chrono::nanoseconds> &State::samples() const {
+    return iterationSamples;
+}
+
+size_t State::itemsPerIteration() const {
+    return items;
+}
+
+bool add(std::string name, Function function, size_t minIterations) {
+    registry().push_back(Entry{std::move(name), std::move(function), minIterations});
+    return true;
+}
+
+int runAll(const std::string &filter) {
+    for (auto &entry : registry()) {
+        if (entry.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        auto state = State(entry.minIterations, minTime);
+        entry.function(state);
+        report(entry.name, state);
+    }
+    return 0;
+}
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Bench {
+
+/**
+ * Drives the iterations of a single benchmark and collects the wall time of each of them.
+ */
+class State {
+   public:
+    State(size_t minIterations, std::chrono::nanoseconds minTime);
+
+    /**
+     * Must be used as the condition of the benchmark loop.
+     * It measures the iteration which just ended and decides if another one should run.
+     *
+     * @return true if another iteration should run, false otherwise.
+     */
+    bool keepRunning();
+
+    /**
+     * Stops measuring the current iteration, e.g. to exclude its setup.
+     */
+    void pauseTiming();
+
+    /**
+     * Resumes measuring the current iteration after pauseTiming() was invoked.
+     */
+    void resumeTiming();
+
+    /**
+     * Sets the number of items (e.g. rows) processed by each iteration, used to report the throughput.
+     */
+    void setItemsPerIteration(size_t items);
+
+    [[nodiscard]] const std::vector<std::chrono::nanoseconds> &samples() const;
+
+    [[nodiscard]] size_t itemsPerIteration() const;
+
+   private:
+    using Clock = std::chrono::steady_clock;
+
+    size_t minIterations;
+    std::chrono::nanoseconds minTime;
+    std::chrono::nanoseconds totalTime{0};
+    std::chrono::nanoseconds pausedTime{0};
+    Clock::time_point iterationStart;
+    Clock::time_point pauseStart;
+    bool started = false;
+    size_t items = 0;
+    std::vector<std::chrono::nanoseconds> iterationSamples;
+};
+
+using Function = std::function<void(State &state)>;
+
+/**
+ * Registers a benchmark which will be run by runAll().
+ *
+ * @param name the name printed in the report.
+ * @param function the benchmark body.
+ * @param minIterations the minimum number of measured iterations.
+ * @return always true, so it can be used to initialize a static variable.
+ */
+bool add(std::string name, Function function, size_t minIterations = 10);
+
+/**
+ * Runs all the registered benchmarks whose name contains the given filter and prints their report.
+ *
+ * @param filter the text which should be contained in the name of the benchmarks to run.
+ * @return the exit code of the process.
+ */
+int runAll(const std::string &filter);
+}
+
+// Defines and registers a benchmark with the name "{suite}.{name}".
+#define BENCHMARK(suite, name) BENCHMARK_N(suite, name, 10)
+
+// Like BENCHMARK() but runs at least the given number of iterations, useful for the slow benchmarks.
+#define BENCHMARK_N(suite, name, minIterations) \
+    static void suite##_##name##_Benchmark(Bench::State &state); \
+    static const bool suite##_##name##_registered = \
+        Bench::add(#suite "." #name, suite##_##name##_Benchmark, minIterations); \
+    static void suite##_##name##_Benchmark(Bench::State &state)
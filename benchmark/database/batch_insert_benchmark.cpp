@@ -0,0 +1,93 @@
+#include <cstdio>
+#include <tuple>
+#include <vector>
+#include "benchmark.hpp"
+#include "database/sqlite_database.hpp"
+
+/* PRIVATE */ namespace {
+
+const char *const dbPath = "batch_insert_benchmark.db";
+
+const int rowsPerIteration = 1000;
+
+void removeDbFiles() {
+    std::remove(dbPath);
+    std::remove((std::string(dbPath) + "-journal").c_str());
+}
+
+std::shared_ptr<Db::Sql::Database> createDb() {
+    removeDbFiles();
+    // The SQLite defaults, so every implicit transaction is synced.
+    auto db = std::make_shared<Db::Sql::Database>(dbPath, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+    db->createStatement(
+        "CREATE TABLE notes ("
+        "title TEXT NOT NULL, "
+        "description TEXT NOT NULL, "
+        "last_update_date TEXT NOT NULL"
+        ")"
+    )->execute<void>();
+    return db;
+}
+
+std::vector<std::tuple<std::string, std::string, std::string>> createRows() {
+    std::vector<std::tuple<std::string, std::string, std::string>> rows;
+    for (int i = 0; i < rowsPerIteration; i++) {
+        rows.emplace_back("title " + std::to_string(i),
+                          "description of the note number " + std::to_string(i),
+                          "2019-10-26T10:19:25Z");
+    }
+    return rows;
+}
+
+void insertRow(const std::shared_ptr<Db::Sql::Database> &db,
+               const std::tuple<std::string, std::string, std::string> &row) {
+    auto stmt = db->createStatement("INSERT INTO notes (title, description, last_update_date) "
+                                    "VALUES (?, ?, ?)");
+    stmt->bind(1, std::get<0>(row));
+    stmt->bind(2, std::get<1>(row));
+    stmt->bind(3, std::get<2>(row));
+    stmt->execute<void>();
+}
+}
+
+// Every row pays its own implicit transaction, like the repeated calls to NotesRepositoryImpl::insert().
+BENCHMARK_N(BatchInsert, perRowAutocommit, 3) {
+    auto db = createDb();
+    auto rows = createRows();
+    state.setItemsPerIteration(rowsPerIteration);
+    while (state.keepRunning()) {
+        for (auto &row : rows) {
+            insertRow(db, row);
+        }
+    }
+    db = nullptr;
+    removeDbFiles();
+}
+
+BENCHMARK(BatchInsert, perRowInTransaction) {
+    auto db = createDb();
+    auto rows = createRows();
+    state.setItemsPerIteration(rowsPerIteration);
+    while (state.keepRunning()) {
+        db->executeTransaction([&] {
+            for (auto &row : rows) {
+                insertRow(db, row);
+            }
+        });
+    }
+    db = nullptr;
+    removeDbFiles();
+}
+
+BENCHMARK(BatchInsert, executeBatch) {
+    auto db = createDb();
+    auto rows = createRows();
+    state.setItemsPerIteration(rowsPerIteration);
+    while (state.keepRunning()) {
+        auto stmt = db->createStatement("INSERT INTO notes (title, description, last_update_date) "
+                                        "VALUES (?, ?, ?)");
+        stmt->executeBatch(rows);
+    }
+    db = nullptr;
+    removeDbFiles();
+}
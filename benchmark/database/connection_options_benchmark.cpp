@@ -0,0 +1,140 @@
+#include <cstdio>
+#include "benchmark.hpp"
+#include "database/sqlite_database.hpp"
+
+/* PRIVATE */ namespace {
+
+const char *const dbPath = "connection_options_benchmark.db";
+
+const int prefilledRows = 10000;
+
+Db::Options rollbackJournalProfile() {
+    // The SQLite defaults: rollback journal and full sync.
+    return Db::Options();
+}
+
+Db::Options walProfile() {
+    auto options = Db::Options();
+    options.journalMode = Db::JournalMode::Wal;
+    options.synchronous = Db::Synchronous::Normal;
+    return options;
+}
+
+Db::Options walMmapProfile() {
+    auto options = walProfile();
+    options.mmapSize = 256 * 1024 * 1024;
+    options.cacheSize = -16 * 1024;
+    options.tempStore = Db::TempStore::Memory;
+    return options;
+}
+
+void removeDbFiles() {
+    std::remove(dbPath);
+    std::remove((std::string(dbPath) + "-journal").c_str());
+    std::remove((std::string(dbPath) + "-wal").c_str());
+    std::remove((std::string(dbPath) + "-shm").c_str());
+}
+
+std::shared_ptr<Db::Sql::Database> createDb(const Db::Options &options, int rows) {
+    removeDbFiles();
+    auto db = std::make_shared<Db::Sql::Database>(dbPath, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, options);
+    db->createStatement(
+        "CREATE TABLE notes ("
+        "title TEXT NOT NULL, "
+        "description TEXT NOT NULL, "
+        "last_update_date TEXT NOT NULL"
+        ")"
+    )->execute<void>();
+    db->executeTransaction([&] {
+        for (int i = 0; i < rows; i++) {
+            auto stmt = db->createStatement("INSERT INTO notes (title, description, last_update_date) "
+                                            "VALUES (?, ?, ?)");
+            stmt->bind(1, "title " + std::to_string(i));
+            stmt->bind(2, "description of the note number " + std::to_string(i));
+            stmt->bind<std::string>(3, "2019-10-26T10:19:25Z");
+            stmt->execute<void>();
+        }
+    });
+    return db;
+}
+
+void benchmarkInsert(Bench::State &state, const Db::Options &options) {
+    auto db = createDb(options, 0);
+    int i = 0;
+    while (state.keepRunning()) {
+        // Every insert runs in its own implicit transaction, like NotesRepositoryImpl::insert().
+        auto stmt = db->createStatement("INSERT INTO notes (title, description, last_update_date) "
+                                        "VALUES (?, ?, ?)");
+        stmt->bind(1, "title " + std::to_string(i));
+        stmt->bind(2, "description of the note number " + std::to_string(i));
+        stmt->bind<std::string>(3, "2019-10-26T10:19:25Z");
+        stmt->execute<void>();
+        i++;
+    }
+    db = nullptr;
+    removeDbFiles();
+}
+
+void benchmarkPointRead(Bench::State &state, const Db::Options &options) {
+    auto db = createDb(options, prefilledRows);
+    int i = 0;
+    while (state.keepRunning()) {
+        auto stmt = db->createStatement("SELECT description FROM notes WHERE rowid = ?");
+        stmt->bind(1, 1 + (i * 7919) % prefilledRows);
+        auto description = stmt->execute<stdx::optional<std::string>>();
+        i++;
+    }
+    db = nullptr;
+    removeDbFiles();
+}
+
+void benchmarkScan(Bench::State &state, const Db::Options &options) {
+    auto db = createDb(options, prefilledRows);
+    state.setItemsPerIteration(prefilledRows);
+    while (state.keepRunning()) {
+        auto cursor = db->createStatement("SELECT rowid, title, description, last_update_date FROM notes")->
+            execute<std::shared_ptr<Db::Cursor>>();
+        while (cursor->next()) {
+            auto title = cursor->get<std::string>(1);
+        }
+    }
+    db = nullptr;
+    removeDbFiles();
+}
+}
+
+BENCHMARK(ConnectionOptions, insertRollbackJournal) {
+    benchmarkInsert(state, rollbackJournalProfile());
+}
+
+BENCHMARK(ConnectionOptions, insertWal) {
+    benchmarkInsert(state, walProfile());
+}
+
+BENCHMARK(ConnectionOptions, insertWalMmap) {
+    benchmarkInsert(state, walMmapProfile());
+}
+
+BENCHMARK(ConnectionOptions, pointReadRollbackJournal) {
+    benchmarkPointRead(state, rollbackJournalProfile());
+}
+
+BENCHMARK(ConnectionOptions, pointReadWal) {
+    benchmarkPointRead(state, walProfile());
+}
+
+BENCHMARK(ConnectionOptions, pointReadWalMmap) {
+    benchmarkPointRead(state, walMmapProfile());
+}
+
+BENCHMARK(ConnectionOptions, scanRollbackJournal) {
+    benchmarkScan(state, rollbackJournalProfile());
+}
+
+BENCHMARK(ConnectionOptions, scanWal) {
+    benchmarkScan(state, walProfile());
+}
+
+BENCHMARK(ConnectionOptions, scanWalMmap) {
+    benchmarkScan(state, walMmapProfile());
+}
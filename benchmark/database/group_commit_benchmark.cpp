@@ -0,0 +1,74 @@
+#include <cstdio>
+#include <future>
+#include <vector>
+#include "benchmark.hpp"
+#include "database/sqlite_database.hpp"
+
+/* PRIVATE */ namespace {
+
+const char *const dbPath = "group_commit_benchmark.db";
+
+const int callers = 4;
+
+const int transactionsPerCaller = 50;
+
+void removeDbFiles() {
+    std::remove(dbPath);
+    std::remove((std::string(dbPath) + "-journal").c_str());
+}
+
+std::shared_ptr<Db::Sql::Database> createDb(bool writerThread) {
+    removeDbFiles();
+    auto options = Db::Options();
+    options.writerThread = writerThread;
+    // The SQLite defaults, so every commit is synced.
+    auto db = std::make_shared<Db::Sql::Database>(dbPath, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, options);
+    db->createStatement("CREATE TABLE notes (title TEXT NOT NULL)")->execute<void>();
+    return db;
+}
+
+std::function<void()> insertNote(const std::shared_ptr<Db::Sql::Database> &db, int index) {
+    return [db, index] {
+        auto stmt = db->createStatement("INSERT INTO notes (title) VALUES (?)");
+        stmt->bind(1, "title " + std::to_string(index));
+        stmt->execute<void>();
+    };
+}
+
+// Every caller submits its transactions one by one, waiting for each commit like a synchronous mutation.
+void runCallers(const std::shared_ptr<Db::Sql::Database> &db) {
+    std::vector<std::future<void>> callerFutures;
+    for (int caller = 0; caller < callers; caller++) {
+        callerFutures.push_back(std::async(std::launch::async, [&db, caller] {
+            for (int i = 0; i < transactionsPerCaller; i++) {
+                db->submitTransaction(insertNote(db, caller * transactionsPerCaller + i)).get();
+            }
+        }));
+    }
+    for (auto &future : callerFutures) {
+        future.get();
+    }
+}
+}
+
+// Every transaction pays its own commit on the caller's thread.
+BENCHMARK_N(GroupCommit, callerThreads, 3) {
+    auto db = createDb(false);
+    state.setItemsPerIteration(callers * transactionsPerCaller);
+    while (state.keepRunning()) {
+        runCallers(db);
+    }
+    db = nullptr;
+    removeDbFiles();
+}
+
+// The transactions submitted by different callers while the writer is busy share the same commit.
+BENCHMARK_N(GroupCommit, writerThread, 3) {
+    auto db = createDb(true);
+    state.setItemsPerIteration(callers * transactionsPerCaller);
+    while (state.keepRunning()) {
+        runCallers(db);
+    }
+    db = nullptr;
+    removeDbFiles();
+}
@@ -0,0 +1,119 @@
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "benchmark.hpp"
+#include "database/sqlite_database.hpp"
+
+/* PRIVATE */ namespace {
+
+const char *const dbPath = "reader_pool_benchmark.db";
+
+const int prefilledRows = 10000;
+
+const int searchesPerThread = 8;
+
+void removeDbFiles() {
+    std::remove(dbPath);
+    std::remove((std::string(dbPath) + "-wal").c_str());
+    std::remove((std::string(dbPath) + "-shm").c_str());
+}
+
+std::shared_ptr<Db::Sql::Database> createDb(size_t readerConnections) {
+    removeDbFiles();
+    auto options = Db::Options();
+    options.journalMode = Db::JournalMode::Wal;
+    options.synchronous = Db::Synchronous::Normal;
+    options.readerConnections = readerConnections;
+    auto db = std::make_shared<Db::Sql::Database>(dbPath, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, options);
+    db->createStatement(
+        "CREATE TABLE notes ("
+        "title TEXT NOT NULL, "
+        "description TEXT NOT NULL, "
+        "last_update_date TEXT NOT NULL"
+        ")"
+    )->execute<void>();
+    db->executeTransaction([&] {
+        for (int i = 0; i < prefilledRows; i++) {
+            auto stmt = db->createStatement("INSERT INTO notes (title, description, last_update_date) "
+                                            "VALUES (?, ?, ?)");
+            stmt->bind(1, "title " + std::to_string(i));
+            stmt->bind(2, "description of the note number " + std::to_string(i));
+            stmt->bind<std::string>(3, "2019-10-26T10:19:25Z");
+            stmt->execute<void>();
+        }
+    });
+    return db;
+}
+
+// The same query used by NotesRepositoryImpl::getByText().
+int search(const std::shared_ptr<Db::Sql::Database> &db, const std::string &text) {
+    auto stmt = db->createStatement(
+        "SELECT rowid, title, description, last_update_date "
+        "FROM notes "
+        "WHERE title LIKE ?"
+        "OR description LIKE ?"
+    );
+    auto likeText = "%" + text + "%";
+    stmt->bind(1, likeText);
+    stmt->bind(2, likeText);
+    auto cursor = stmt->execute<std::shared_ptr<Db::Cursor>>();
+    int matches = 0;
+    while (cursor->next()) {
+        matches++;
+    }
+    return matches;
+}
+
+void benchmarkConcurrentSearch(Bench::State &state, size_t threads, bool pooled) {
+    auto db = createDb(pooled ? threads : 0);
+    // Without the pool, the single connection must be shared by the threads one at a time.
+    std::mutex connectionMutex;
+    state.setItemsPerIteration(threads * searchesPerThread);
+    while (state.keepRunning()) {
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < threads; t++) {
+            workers.emplace_back([&, t] {
+                for (int i = 0; i < searchesPerThread; i++) {
+                    auto text = std::to_string((t * searchesPerThread + i) % 97);
+                    if (pooled) {
+                        search(db, text);
+                    } else {
+                        std::lock_guard<std::mutex> lock(connectionMutex);
+                        search(db, text);
+                    }
+                }
+            });
+        }
+        for (auto &worker : workers) {
+            worker.join();
+        }
+    }
+    db = nullptr;
+    removeDbFiles();
+}
+}
+
+BENCHMARK(ReaderPool, search1ThreadSingleConnection) {
+    benchmarkConcurrentSearch(state, 1, false);
+}
+
+BENCHMARK(ReaderPool, search1ThreadPooled) {
+    benchmarkConcurrentSearch(state, 1, true);
+}
+
+BENCHMARK(ReaderPool, search4ThreadsSingleConnection) {
+    benchmarkConcurrentSearch(state, 4, false);
+}
+
+BENCHMARK(ReaderPool, search4ThreadsPooled) {
+    benchmarkConcurrentSearch(state, 4, true);
+}
+
+BENCHMARK(ReaderPool, search8ThreadsSingleConnection) {
+    benchmarkConcurrentSearch(state, 8, false);
+}
+
+BENCHMARK(ReaderPool, search8ThreadsPooled) {
+    benchmarkConcurrentSearch(state, 8, true);
+}
@@ -0,0 +1,8 @@
+#include <string>
+#include "benchmark.hpp"
+
+int main(int argc, char **argv) {
+    // The first argument, if any, filters the benchmarks by name.
+    std::string filter = argc > 1 ? argv[1] : "";
+    return Bench::runAll(filter);
+}
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include <cstdio>
+#include "benchmark.hpp"
+#include "database/sqlite_database.hpp"
+#include "note/drafts_repository_impl.hpp"
+
+/* PRIVATE */ namespace {
+
+const char *const dbPath = "drafts_repository_benchmark.db";
+
+const char *const logPath = "drafts_repository_benchmark.log";
+
+const int keystrokes = 100;
+
+const int openedDrafts = 10000;
+
+// 1% of the opened drafts.
+const int changedDrafts = 100;
+
+const size_t largeDescriptionSize = 256 * 1024;
+
+void removeDbFiles() {
+    std::remove(dbPath);
+    std::remove((std::string(dbPath) + "-journal").c_str());
+    std::remove(logPath);
+}
+
+std::shared_ptr<Db::Sql::Database> createDb() {
+    removeDbFiles();
+    // The SQLite defaults, so every commit is synced.
+    auto db = std::make_shared<Db::Sql::Database>(dbPath, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+    db->createStatement(
+        "CREATE TABLE pending_drafts_update ("
+        "title TEXT NOT NULL, "
+        "description TEXT NOT NULL"
+        ")"
+    )->execute<void>();
+    db->createStatement(
+        "CREATE TABLE pending_draft_creation ("
+        "id INTEGER PRIMARY KEY CHECK (id = 0), "
+        "title TEXT NOT NULL, "
+        "description TEXT NOT NULL"
+        ")"
+    )->execute<void>();
+    return db;
+}
+
+// The user types the description of a new draft, one character at a time.
+void typeDescription(DraftsRepositoryImpl &repository, bool persistEveryKeystroke) {
+    std::string description;
+    repository.updateNewTitle("title");
+    for (int i = 0; i < keystrokes; i++) {
+        description += 'a';
+        repository.updateNewDescription(description);
+        if (persistEveryKeystroke) {
+            repository.persist();
+        }
+    }
+}
+
+void openDrafts(DraftsRepositoryImpl &repository) {
+    for (int id = 1; id <= openedDrafts; id++) {
+        repository.updateExistingTitle(id, "title " + std::to_string(id));
+        repository.updateExistingDescription(id, "description of the draft number " + std::to_string(id));
+    }
+    repository.persist();
+}
+
+// Reads every stored draft and changes its title, like the user opening the notes one by one.
+void openAndChangeDrafts(DraftsRepositoryImpl &repository) {
+    for (int id = 1; id <= openedDrafts; id++) {
+        auto draft = repository.getExisting(id);
+        repository.updateExistingTitle(id, draft->getTitle() + " changed");
+    }
+}
+
+// Changes the first drafts, alternating their description so every iteration writes them.
+void changeDrafts(DraftsRepositoryImpl &repository, int count, int iteration) {
+    for (int id = 1; id <= count; id++) {
+        repository.updateExistingDescription(id, "description " + std::to_string(iteration % 2));
+    }
+}
+}
+
+BENCHMARK(DraftsRepository, persistEveryKeystroke) {
+    auto db = createDb();
+    auto repository = DraftsRepositoryImpl(db);
+    state.setItemsPerIteration(keystrokes);
+    while (state.keepRunning()) {
+        typeDescription(repository, true);
+    }
+    removeDbFiles();
+}
+
+BENCHMARK(DraftsRepository, writeBehind) {
+    auto db = createDb();
+    DraftFlushPolicy policy;
+    policy.debounce = std::chrono::milliseconds(20);
+    auto repository = DraftsRepositoryImpl(db, policy);
+    state.setItemsPerIteration(keystrokes);
+    while (state.keepRunning()) {
+        // The caller doesn't wait for the writes, which are coalesced by the background thread.
+        typeDescription(repository, false);
+    }
+    removeDbFiles();
+}
+
+BENCHMARK(DraftsRepository, logEveryKeystroke) {
+    auto db = createDb();
+    auto repository = DraftsRepositoryImpl(db, stdx::nullopt, false, std::string(logPath));
+    state.setItemsPerIteration(keystrokes);
+    while (state.keepRunning()) {
+        // Every keystroke survives a crash like persistEveryKeystroke, but it's only copied in the mapped log.
+        typeDescription(repository, false);
+    }
+    removeDbFiles();
+}
+
+BENCHMARK(DraftsRepository, persistAllOpenedDraftsChanged) {
+    auto db = createDb();
+    auto repository = DraftsRepositoryImpl(db);
+    openDrafts(repository);
+    int iteration = 0;
+    while (state.keepRunning()) {
+        changeDrafts(repository, openedDrafts, iteration++);
+        repository.persist();
+    }
+    removeDbFiles();
+}
+
+BENCHMARK(DraftsRepository, persistOnePercentOfOpenedDraftsChanged) {
+    auto db = createDb();
+    auto repository = DraftsRepositoryImpl(db);
+    openDrafts(repository);
+    int iteration = 0;
+    while (state.keepRunning()) {
+        changeDrafts(repository, changedDrafts, iteration++);
+        repository.persist();
+    }
+    removeDbFiles();
+}
+
+BENCHMARK(DraftsRepository, openStoredDraftsOneByOne) {
+    auto db = createDb();
+    {
+        auto repository = DraftsRepositoryImpl(db);
+        openDrafts(repository);
+    }
+    state.setItemsPerIteration(openedDrafts);
+    while (state.keepRunning()) {
+        auto repository = DraftsRepositoryImpl(db);
+        openAndChangeDrafts(repository);
+    }
+    removeDbFiles();
+}
+
+BENCHMARK(DraftsRepository, openStoredDraftsPreloaded) {
+    auto db = createDb();
+    {
+        auto repository = DraftsRepositoryImpl(db);
+        openDrafts(repository);
+    }
+    state.setItemsPerIteration(openedDrafts);
+    while (state.keepRunning()) {
+        // The drafts are read by the constructor in a single scan.
+        auto repository = DraftsRepositoryImpl(db, stdx::nullopt, true);
+        openAndChangeDrafts(repository);
+    }
+    removeDbFiles();
+}
+
+BENCHMARK(DraftsRepository, typeInLargeDescriptionReplacingIt) {
+    auto db = createDb();
+    auto repository = DraftsRepositoryImpl(db);
+    // The text of the editor, which is passed whole to the repository after every keystroke.
+    auto description = std::string(largeDescriptionSize, '-');
+    repository.updateExistingTitle(1, "title");
+    repository.updateExistingDescription(1, description);
+    state.setItemsPerIteration(keystrokes);
+    while (state.keepRunning()) {
+        for (int i = 0; i < keystrokes; i++) {
+            description.insert(largeDescriptionSize / 2 + i, 1, 'a');
+            repository.updateExistingDescription(1, description);
+        }
+    }
+    removeDbFiles();
+}
+
+BENCHMARK(DraftsRepository, typeInLargeDescriptionEditingIt) {
+    auto db = createDb();
+    auto repository = DraftsRepositoryImpl(db);
+    repository.updateExistingTitle(1, "title");
+    repository.updateExistingDescription(1, std::string(largeDescriptionSize, '-'));
+    state.setItemsPerIteration(keystrokes);
+    while (state.keepRunning()) {
+        for (int i = 0; i < keystrokes; i++) {
+            repository.insertInExistingDescription(1, largeDescriptionSize / 2 + i, "a");
+        }
+    }
+    removeDbFiles();
+}
@@ -0,0 +1,93 @@
+#include <tuple>
+#include <vector>
+#include "benchmark.hpp"
+#include "note/notes_repository_impl.hpp"
+#include "time/clock_impl.hpp"
+#include "core/include_macros.hpp"
+#include AMALGAMATION(database_client.hpp)
+#include AMALGAMATION(note_database_initializer.hpp)
+
+/* PRIVATE */ namespace {
+
+// The searched text is contained in 1 note every 1000.
+const char *const searchedText = "keyword777";
+
+std::shared_ptr<Db::Database> createDb(int notesCount) {
+    NoteDb::initialize(":memory:");
+    auto db = Db::Client::get();
+    std::vector<std::tuple<std::string, std::string, long long>> rows;
+    rows.reserve(notesCount);
+    for (int i = 0; i < notesCount; i++) {
+        rows.emplace_back("title " + std::to_string(i),
+                          "description of the note with the keyword" + std::to_string(i % 1000),
+                          1572085165LL);
+    }
+    db->executeTransaction([&] {
+        db->createStatement("INSERT INTO notes (title, description, last_update_date) VALUES (?, ?, ?)")->
+            executeBatch(rows);
+    });
+    return db;
+}
+
+// The implementation of NotesRepositoryImpl::getByText() before the full-text index, which scans the whole table.
+std::vector<Note> searchWithLike(const std::shared_ptr<Db::Database> &db) {
+    auto stmt = db->createStatement(
+        "SELECT rowid, title, description, last_update_date "
+        "FROM notes "
+        "WHERE title LIKE ? "
+        "OR description LIKE ?"
+    );
+    auto likeText = "%" + std::string(searchedText) + "%";
+    stmt->bind(1, likeText);
+    stmt->bind(2, likeText);
+    std::vector<Note> notes;
+    stmt->execute<std::shared_ptr<Db::Cursor>>()->forEachRow<int, std::string, std::string, long long>(
+        [&notes](int id, std::string title, std::string description, long long lastUpdateTime) {
+            notes.emplace_back(id, std::move(title), std::move(description), static_cast<std::time_t>(lastUpdateTime));
+        });
+    return notes;
+}
+
+void benchmarkLike(Bench::State &state, int notesCount) {
+    auto db = createDb(notesCount);
+    while (state.keepRunning()) {
+        searchWithLike(db);
+    }
+    db = nullptr;
+    Db::Client::release();
+}
+
+void benchmarkFullText(Bench::State &state, int notesCount) {
+    auto db = createDb(notesCount);
+    auto repository = NotesRepositoryImpl(db, std::make_shared<Time::ClockImpl>());
+    while (state.keepRunning()) {
+        repository.getByText(searchedText);
+    }
+    db = nullptr;
+    Db::Client::release();
+}
+}
+
+BENCHMARK(FullTextSearch, like10k) {
+    benchmarkLike(state, 10000);
+}
+
+BENCHMARK(FullTextSearch, fts10k) {
+    benchmarkFullText(state, 10000);
+}
+
+BENCHMARK(FullTextSearch, like100k) {
+    benchmarkLike(state, 100000);
+}
+
+BENCHMARK(FullTextSearch, fts100k) {
+    benchmarkFullText(state, 100000);
+}
+
+BENCHMARK_N(FullTextSearch, like1M, 3) {
+    benchmarkLike(state, 1000000);
+}
+
+BENCHMARK_N(FullTextSearch, fts1M, 3) {
+    benchmarkFullText(state, 1000000);
+}
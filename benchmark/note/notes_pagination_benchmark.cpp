@@ -0,0 +1,106 @@
+#include <string>
+#include <tuple>
+#include <vector>
+#include "benchmark.hpp"
+#include "note/notes_repository_impl.hpp"
+#include "time/clock_impl.hpp"
+#include "core/include_macros.hpp"
+#include AMALGAMATION(database_client.hpp)
+#include AMALGAMATION(note_database_initializer.hpp)
+
+/* PRIVATE */ namespace {
+
+const int notesCount = 100000;
+const size_t pageSize = 50;
+// The page read by the benchmarks of the deep pages, close to the end of the notes.
+const int deepPage = 1900;
+
+std::shared_ptr<Db::Database> createDb() {
+    NoteDb::initialize(":memory:");
+    auto db = Db::Client::get();
+    std::vector<std::tuple<std::string, std::string, long long>> rows;
+    rows.reserve(notesCount);
+    for (int i = 0; i < notesCount; i++) {
+        rows.emplace_back("title " + std::to_string(i),
+                          "description of the note number " + std::to_string(i),
+                          1572085165LL + i / 10);
+    }
+    db->executeTransaction([&] {
+        db->createStatement("INSERT INTO notes (title, description, last_update_date) VALUES (?, ?, ?)")->
+            executeBatch(rows);
+    });
+    return db;
+}
+
+// Reads a page skipping the previous ones with OFFSET, which steps all of them again.
+std::vector<Note> getPageWithOffset(const std::shared_ptr<Db::Database> &db, int page) {
+    auto stmt = db->createStatement(
+        "SELECT rowid, title, description, last_update_date "
+        "FROM notes "
+        "ORDER BY last_update_date DESC, rowid DESC "
+        "LIMIT ? OFFSET ?"
+    );
+    stmt->bind(1, static_cast<int>(pageSize));
+    stmt->bind(2, static_cast<int>(pageSize) * page);
+    std::vector<Note> notes;
+    stmt->execute<std::shared_ptr<Db::Cursor>>()->forEachRow<int, std::string, std::string, long long>(
+        [&notes](int id, std::string title, std::string description, long long lastUpdateTime) {
+            notes.emplace_back(id, std::move(title), std::move(description), static_cast<std::time_t>(lastUpdateTime));
+        });
+    return notes;
+}
+
+template<typename Body>
+void benchmarkRepository(Bench::State &state, Body body) {
+    auto db = createDb();
+    auto repository = NotesRepositoryImpl(db, std::make_shared<Time::ClockImpl>());
+    body(state, repository);
+    db = nullptr;
+    Db::Client::release();
+}
+}
+
+BENCHMARK(NotesPagination, getAll) {
+    benchmarkRepository(state, [](Bench::State &state, NotesRepositoryImpl &repository) {
+        while (state.keepRunning()) {
+            repository.getAll();
+        }
+    });
+}
+
+BENCHMARK(NotesPagination, firstPage) {
+    benchmarkRepository(state, [](Bench::State &state, NotesRepositoryImpl &repository) {
+        while (state.keepRunning()) {
+            repository.getPage(pageSize, stdx::nullopt);
+        }
+    });
+}
+
+BENCHMARK(NotesPagination, deepPageOffset) {
+    auto db = createDb();
+    while (state.keepRunning()) {
+        getPageWithOffset(db, deepPage);
+    }
+    db = nullptr;
+    Db::Client::release();
+}
+
+BENCHMARK(NotesPagination, deepPageKeyset) {
+    benchmarkRepository(state, [](Bench::State &state, NotesRepositoryImpl &repository) {
+        auto key = repository.getPage(pageSize * deepPage, stdx::nullopt).getNextKey();
+        while (state.keepRunning()) {
+            repository.getPage(pageSize, key);
+        }
+    });
+}
+
+BENCHMARK(NotesPagination, forEach) {
+    benchmarkRepository(state, [](Bench::State &state, NotesRepositoryImpl &repository) {
+        while (state.keepRunning()) {
+            size_t bytes = 0;
+            repository.forEach([&bytes](const Note &note) {
+                bytes += note.getDescription().size();
+            });
+        }
+    });
+}
@@ -0,0 +1,152 @@
+#include "benchmark.hpp"
+#include "database/sqlite_database.hpp"
+#include "note/notes_repository_impl.hpp"
+#include "time/clock_impl.hpp"
+#include "core/include_macros.hpp"
+#include AMALGAMATION(time_format.hpp)
+
+/* PRIVATE */ namespace {
+
+const int prefilledRows = 10000;
+
+std::shared_ptr<Db::Sql::Database> createDb() {
+    auto db = std::make_shared<Db::Sql::Database>(":memory:", SQLITE_OPEN_READWRITE);
+    db->createStatement(
+        "CREATE TABLE notes ("
+        "title TEXT NOT NULL, "
+        "description TEXT NOT NULL, "
+        "last_update_date INTEGER NOT NULL"
+        ")"
+    )->execute<void>();
+    // The table of the version 5 of the schema, which stored the dates as ISO-8601 text.
+    db->createStatement(
+        "CREATE TABLE notes_iso ("
+        "title TEXT NOT NULL, "
+        "description TEXT NOT NULL, "
+        "last_update_date TEXT NOT NULL"
+        ")"
+    )->execute<void>();
+    db->executeTransaction([&] {
+        for (int i = 0; i < prefilledRows; i++) {
+            auto stmt = db->createStatement("INSERT INTO notes (title, description, last_update_date) "
+                                            "VALUES (?, ?, ?)");
+            stmt->bind(1, "title " + std::to_string(i));
+            stmt->bind(2, "description of the note number " + std::to_string(i));
+            stmt->bind<long long>(3, 1572085165);
+            stmt->execute<void>();
+        }
+        db->createStatement("INSERT INTO notes_iso (title, description, last_update_date) "
+                            "SELECT title, description, '2019-10-26T10:19:25Z' FROM notes")->execute<void>();
+    });
+    return db;
+}
+
+// The implementation of NotesRepositoryImpl::getAll() which reads every column with Cursor::get().
+std::vector<Note> getAllPerColumn(const std::shared_ptr<Db::Database> &db) {
+    std::vector<Note> notes;
+    auto stmt = db->createStatement("SELECT rowid, title, description, last_update_date FROM notes");
+    auto cursor = stmt->execute<std::shared_ptr<Db::Cursor>>();
+    while (cursor->next()) {
+        auto id = cursor->get<int>(0);
+        auto title = cursor->get<std::string>(1);
+        auto description = cursor->get<std::string>(2);
+        auto lastUpdateTime = cursor->get<long long>(3);
+        notes.emplace_back(id, title, description, static_cast<std::time_t>(lastUpdateTime));
+    }
+    return notes;
+}
+
+// The implementation of NotesRepositoryImpl::getAll() which parsed the dates stored as ISO-8601 text.
+std::vector<Note> getAllIsoDates(const std::shared_ptr<Db::Database> &db) {
+    std::vector<Note> notes;
+    auto stmt = db->createStatement("SELECT rowid, title, description, last_update_date FROM notes_iso");
+    stmt->execute<std::shared_ptr<Db::Cursor>>()->forEachRow<int, std::string, std::string, std::string>(
+        [&notes](int id, std::string title, std::string description, std::string lastUpdateTimeISO_8601) {
+            auto lastUpdateTime = Time::Format::parse(std::move(lastUpdateTimeISO_8601));
+            notes.emplace_back(id, std::move(title), std::move(description), lastUpdateTime);
+        });
+    return notes;
+}
+}
+
+BENCHMARK(NotesRepository, getAllPerColumn) {
+    auto db = createDb();
+    state.setItemsPerIteration(prefilledRows);
+    while (state.keepRunning()) {
+        auto notes = getAllPerColumn(db);
+    }
+}
+
+BENCHMARK(NotesRepository, getAllIsoDates) {
+    auto db = createDb();
+    state.setItemsPerIteration(prefilledRows);
+    while (state.keepRunning()) {
+        auto notes = getAllIsoDates(db);
+    }
+}
+
+BENCHMARK(NotesRepository, getAllTypedRows) {
+    auto db = createDb();
+    auto repository = NotesRepositoryImpl(db, std::make_shared<Time::ClockImpl>());
+    state.setItemsPerIteration(prefilledRows);
+    while (state.keepRunning()) {
+        auto notes = repository.getAll();
+    }
+}
+
+BENCHMARK(NotesRepository, getAllCached) {
+    auto db = createDb();
+    auto repository = NotesRepositoryImpl(db, std::make_shared<Time::ClockImpl>(), 16 * 1024 * 1024);
+    state.setItemsPerIteration(prefilledRows);
+    while (state.keepRunning()) {
+        auto notes = repository.getAll();
+    }
+}
+
+BENCHMARK(NotesRepository, insertAndGetAll) {
+    auto db = createDb();
+    auto repository = NotesRepositoryImpl(db, std::make_shared<Time::ClockImpl>());
+    while (state.keepRunning()) {
+        // The id of the inserted note was known only reading all the notes again.
+        repository.insert(Draft("title", "description"));
+        auto notes = repository.getAll();
+    }
+}
+
+BENCHMARK(NotesRepository, insert) {
+    auto db = createDb();
+    auto repository = NotesRepositoryImpl(db, std::make_shared<Time::ClockImpl>());
+    while (state.keepRunning()) {
+        auto note = repository.insert(Draft("title", "description"));
+    }
+}
+
+BENCHMARK(NotesRepository, scanPerColumn) {
+    auto db = createDb();
+    state.setItemsPerIteration(prefilledRows);
+    while (state.keepRunning()) {
+        auto cursor = db->createStatement("SELECT rowid, title, description, last_update_date FROM notes")->
+            execute<std::shared_ptr<Db::Cursor>>();
+        size_t bytes = 0;
+        while (cursor->next()) {
+            bytes += cursor->get<int>(0);
+            bytes += cursor->get<stdx::string_view>(1).size();
+            bytes += cursor->get<stdx::string_view>(2).size();
+            bytes += cursor->get<long long>(3);
+        }
+    }
+}
+
+BENCHMARK(NotesRepository, scanTypedRows) {
+    auto db = createDb();
+    state.setItemsPerIteration(prefilledRows);
+    while (state.keepRunning()) {
+        auto cursor = db->createStatement("SELECT rowid, title, description, last_update_date FROM notes")->
+            execute<std::shared_ptr<Db::Cursor>>();
+        size_t bytes = 0;
+        cursor->forEachRow<int, stdx::string_view, stdx::string_view, long long>(
+            [&bytes](int id, stdx::string_view title, stdx::string_view description, long long date) {
+                bytes += id + title.size() + description.size() + date;
+            });
+    }
+}
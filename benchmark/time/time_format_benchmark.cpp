@@ -0,0 +1,89 @@
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "benchmark.hpp"
+#include "core/include_macros.hpp"
+#include AMALGAMATION(time_format.hpp)
+
+/* PRIVATE */ namespace {
+
+const int formattedTimesCount = 10000;
+
+// The implementation of Time::Format::parse() based on std::get_time(), which depends on the locale.
+std::time_t parseWithStream(Time::Format::ISO_8601 formattedTime) {
+    tm tm{};
+    auto ss = std::istringstream(formattedTime);
+    ss >> std::get_time(&tm, "%Y-%m-%dT%TZ");
+    return timegm(&tm);
+}
+
+// The implementation of Time::Format::format() based on gmtime() and strftime().
+Time::Format::ISO_8601 formatWithStrftime(std::time_t time) {
+    char timeBuffer[sizeof "0000-00-00T00:00:00Z"];
+    strftime(timeBuffer, sizeof timeBuffer, "%FT%TZ", gmtime(&time));
+    return timeBuffer;
+}
+
+std::vector<Time::Format::ISO_8601> createFormattedTimes() {
+    std::vector<Time::Format::ISO_8601> formattedTimes;
+    formattedTimes.reserve(formattedTimesCount);
+    for (int i = 0; i < formattedTimesCount; i++) {
+        formattedTimes.push_back(Time::Format::format(1572085165 + i * 3607));
+    }
+    return formattedTimes;
+}
+}
+
+BENCHMARK(TimeFormat, parseWithStream) {
+    auto formattedTimes = createFormattedTimes();
+    state.setItemsPerIteration(formattedTimesCount);
+    while (state.keepRunning()) {
+        std::time_t sum = 0;
+        for (const auto &formattedTime : formattedTimes) {
+            sum += parseWithStream(formattedTime);
+        }
+    }
+}
+
+BENCHMARK(TimeFormat, parse) {
+    auto formattedTimes = createFormattedTimes();
+    state.setItemsPerIteration(formattedTimesCount);
+    while (state.keepRunning()) {
+        std::time_t sum = 0;
+        for (const auto &formattedTime : formattedTimes) {
+            sum += Time::Format::parse(formattedTime);
+        }
+    }
+}
+
+BENCHMARK(TimeFormat, formatWithStrftime) {
+    state.setItemsPerIteration(formattedTimesCount);
+    while (state.keepRunning()) {
+        size_t size = 0;
+        for (int i = 0; i < formattedTimesCount; i++) {
+            size += formatWithStrftime(1572085165 + i * 3607).size();
+        }
+    }
+}
+
+BENCHMARK(TimeFormat, format) {
+    state.setItemsPerIteration(formattedTimesCount);
+    while (state.keepRunning()) {
+        size_t size = 0;
+        for (int i = 0; i < formattedTimesCount; i++) {
+            size += Time::Format::format(1572085165 + i * 3607).size();
+        }
+    }
+}
+
+BENCHMARK(TimeFormat, formatInBuffer) {
+    state.setItemsPerIteration(formattedTimesCount);
+    while (state.keepRunning()) {
+        char buffer[Time::Format::length];
+        size_t size = 0;
+        for (int i = 0; i < formattedTimesCount; i++) {
+            size += Time::Format::format(1572085165 + i * 3607, buffer) - buffer;
+        }
+    }
+}
@@ -2,14 +2,98 @@
 
 #include <string>
 #include <functional>
+#include <future>
+#include <vector>
+#include "database_changes.hpp"
 #include "database_statement.hpp"
 
 namespace Db {
 
+/**
+ * Defines when the outermost transaction acquires the lock on the database.
+ */
+enum class TransactionMode {
+    // The lock is acquired by the first read or write.
+    Deferred,
+    // The write lock is acquired immediately, so the transaction can't fail upgrading it later.
+    Immediate,
+    // Like Immediate, but the other connections can't read too, unless the journal mode is WAL.
+    Exclusive
+};
+
 class Database {
    public:
-    virtual void executeTransaction(std::function<void()> transact) const = 0;
+    /**
+     * Executes the given function in a transaction, which is committed if the function returns normally or rolled
+     * back if it throws.
+     * When it's invoked inside another transaction, a nested transaction is created with a savepoint, so it can be
+     * rolled back without affecting the outer one. The nested transactions use the mode of the outermost one.
+     *
+     * @param transact the function executed in the transaction.
+     * @param mode defines when the outermost transaction acquires the lock on the database.
+     */
+    virtual void executeTransaction(std::function<void()> transact,
+                                    TransactionMode mode = TransactionMode::Deferred) const = 0;
+
+    /**
+     * Executes the given function in a transaction on the writer thread, when Options::writerThread is true, without
+     * blocking the caller. The transactions submitted while the writer is busy are committed together, each one in its
+     * own nested transaction. Otherwise, the transaction is executed immediately on the caller's thread.
+     * The returned future mustn't be awaited inside another transaction, since the writer waits for it to end.
+     *
+     * @param transact the function executed in the transaction.
+     * @return the future which is ready when the transaction is committed or holds the exception which caused its
+     * failure.
+     */
+    virtual std::future<void> submitTransaction(std::function<void()> transact) const = 0;
+
+    /**
+     * Executes the given function with submitTransaction() and waits until it's committed, so the transactions of the
+     * concurrent callers share a commit when Options::writerThread is true.
+     * When the calling thread is already in a transaction, the function is executed in a nested transaction instead,
+     * since the writer thread would wait for the transaction of the caller to end.
+     *
+     * @param transact the function executed in the transaction.
+     * @param mode the mode used when the transaction isn't executed by the writer thread, which always writes.
+     */
+    virtual void executeGroupedTransaction(std::function<void()> transact,
+                                           TransactionMode mode = TransactionMode::Deferred) const = 0;
 
     [[nodiscard]] virtual std::shared_ptr<Statement> createStatement(std::string sql) const = 0;
+
+    /**
+     * Executes the given function after the outermost transaction of the calling thread is committed, or immediately
+     * if the thread isn't in a transaction. It isn't executed if the transaction in which it's registered, or one of
+     * the transactions containing it, is rolled back.
+     * It's invoked on the thread which committed, once the connection isn't in a transaction anymore, before the
+     * change listeners.
+     *
+     * @param action the function executed after the commit.
+     */
+    virtual void executeAfterCommit(std::function<void()> action) const = 0;
+
+    /**
+     * @return true if the calling thread is executing a transaction, so its queries read the changes not committed yet.
+     */
+    [[nodiscard]] virtual bool isInTransaction() const = 0;
+
+    /**
+     * Registers a listener notified after the commits of this connection with the rows they changed, coalesced by
+     * rowid. It's invoked on the thread which committed, once the connection isn't in a transaction anymore, so it
+     * can read the database. The changes committed by other connections aren't notified.
+     *
+     * @param listener the function receiving the changes of the tables, sorted by table name.
+     * @return the id used to remove the listener.
+     */
+    virtual int addChangeListener(std::function<void(const std::vector<TableChanges> &)> listener) const = 0;
+
+    virtual void removeChangeListener(int listenerId) const = 0;
+
+    /**
+     * Reads the PRAGMA data_version of this connection, which changes only when another connection commits.
+     * It doesn't use the read-only connections, which see the commits of this connection as external changes, and it
+     * doesn't wait for the transactions of the other threads.
+     */
+    [[nodiscard]] virtual long long dataVersion() const = 0;
 };
 }
\ No newline at end of file
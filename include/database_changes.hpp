@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Db {
+
+/**
+ * The rows of a table changed by one or more committed transactions, coalesced by rowid, e.g. a row inserted and
+ * then updated is only inserted, while a row inserted and then deleted isn't reported at all.
+ * The rowids are sorted in ascending order.
+ */
+struct TableChanges {
+    std::string table;
+    std::vector<long long> insertedRowIds;
+    std::vector<long long> updatedRowIds;
+    std::vector<long long> deletedRowIds;
+};
+
+inline bool operator==(const TableChanges &first, const TableChanges &second) {
+    return first.table == second.table &&
+        first.insertedRowIds == second.insertedRowIds &&
+        first.updatedRowIds == second.updatedRowIds &&
+        first.deletedRowIds == second.deletedRowIds;
+}
+}
@@ -2,12 +2,13 @@
 
 #include <string>
 #include "database.hpp"
+#include "database_options.hpp"
 
 namespace Db {
 
 class Client {
    public:
-    static void create(std::string dbPath);
+    static void create(std::string dbPath, const Options &options = Options());
 
     static std::shared_ptr<Database> get();
 
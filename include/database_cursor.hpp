@@ -1,6 +1,13 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "std_string_view_compat.hpp"
 
 namespace Db {
 
@@ -8,20 +15,185 @@ class Cursor {
    public:
     virtual bool next() = 0;
 
+    /**
+     * Gets the value of the given column in the current row.
+     * When T is stdx::string_view, the value points to the memory of the database and it's valid only until the
+     * next invocation of next(), but it's read without any allocation.
+     *
+     * @param colIndex the index of the column, starting from 0.
+     * @return the value of the column converted to T.
+     */
     template<typename T>
     T get(int colIndex);
 
+    /**
+     * Steps all the remaining rows and passes the values of their columns to the given consumer.
+     * The number of columns is checked and the type read from every column is resolved once per statement, then the
+     * rows are read by a single virtual call, without the per-column checks of get().
+     * The stdx::string_view values are valid only during the invocation of the consumer.
+     *
+     * @tparam Ts the types of the columns, in the same order of the query.
+     * @param consumer the function invoked with the values of each row, e.g. [](int id, std::string title) {}.
+     */
+    template<typename... Ts, typename Consumer>
+    void forEachRow(Consumer &&consumer) {
+        ensureColumnCount(sizeof...(Ts));
+        static constexpr std::array<ColumnType, sizeof...(Ts)> types{{columnTypeOf<Ts>()...}};
+        using ConsumerType = std::remove_reference_t<Consumer>;
+        // A lambda without captures, so it's invoked for every row through a plain function pointer.
+        RowReader reader = [](const void *consumerPointer, const Value *values) {
+            auto &rowConsumer = *static_cast<ConsumerType *>(const_cast<void *>(consumerPointer));
+            consumeRow<Ts...>(rowConsumer, values, std::index_sequence_for<Ts...>());
+        };
+        readRows(types.data(), static_cast<int>(sizeof...(Ts)), reader, &consumer);
+    }
+
+    /**
+     * Steps all the remaining rows and decodes them like forEachRow().
+     *
+     * @tparam Ts the types of the columns, in the same order of the query.
+     * @return a tuple for each row.
+     */
+    template<typename... Ts>
+    std::vector<std::tuple<Ts...>> rows() {
+        std::vector<std::tuple<Ts...>> result;
+        forEachRow<Ts...>([&result](Ts... values) {
+            result.emplace_back(std::move(values)...);
+        });
+        return result;
+    }
+
    protected:
+    // The values are the same of the SQLite fundamental datatypes.
+    enum class ColumnType {
+        Integer = 1,
+        Float = 2,
+        Text = 3,
+        Blob = 4,
+        Null = 5
+    };
+
+    /**
+     * The raw value of a column in the current row, read without any conversion.
+     * Only the field of the type of the column is filled.
+     * The text points to the memory of the database and it's valid only until the next row is read.
+     */
+    struct Value {
+        long long integer;
+        double real;
+        const char *text;
+        size_t size;
+    };
+
+    /**
+     * Invoked with the values of every row read by readRows().
+     */
+    using RowReader = void (*)(const void *consumer, const Value *values);
+
+    /**
+     * Steps all the remaining rows and reads the values of their first columns.
+     *
+     * @param types the type of every column, which must be the type of all its values.
+     * @param count the number of columns to read, which must not exceed the number of columns of the query.
+     * @param reader the function invoked with the values of every row.
+     * @param consumer the object passed to the reader.
+     */
+    virtual void readRows(const ColumnType *types, int count, RowReader reader, const void *consumer) = 0;
+
+    [[noreturn]] static void throwTypeMismatch(int colIndex, ColumnType expected, ColumnType actual);
+
+    virtual int getColumnCount() = 0;
+
     virtual void ensureNextWasInvoked() = 0;
 
     virtual void ensureIndexInBounds(int colIndex) = 0;
 
     virtual int getInt(int colIndex) = 0;
 
+    virtual long long getInt64(int colIndex) = 0;
+
     virtual double getDouble(int colIndex) = 0;
 
     virtual std::string getString(int colIndex) = 0;
 
+    virtual stdx::string_view getStringView(int colIndex) = 0;
+
     virtual bool getBool(int colIndex) = 0;
+
+   private:
+    void ensureColumnCount(int expectedCount);
+
+    template<typename T>
+    static constexpr ColumnType columnTypeOf();
+
+    template<typename T>
+    static T decode(const Value &value);
+
+    template<typename... Ts, typename Consumer, size_t... Is>
+    static void consumeRow(Consumer &consumer, const Value *values, std::index_sequence<Is...>) {
+        consumer(decode<Ts>(values[Is])...);
+    }
 };
+
+/* TEMPLATES */
+
+template<>
+constexpr Cursor::ColumnType Cursor::columnTypeOf<int>() {
+    return ColumnType::Integer;
+}
+
+template<>
+constexpr Cursor::ColumnType Cursor::columnTypeOf<long long>() {
+    return ColumnType::Integer;
+}
+
+template<>
+constexpr Cursor::ColumnType Cursor::columnTypeOf<bool>() {
+    return ColumnType::Integer;
+}
+
+template<>
+constexpr Cursor::ColumnType Cursor::columnTypeOf<double>() {
+    return ColumnType::Float;
+}
+
+template<>
+constexpr Cursor::ColumnType Cursor::columnTypeOf<stdx::string_view>() {
+    return ColumnType::Text;
+}
+
+template<>
+constexpr Cursor::ColumnType Cursor::columnTypeOf<std::string>() {
+    return ColumnType::Text;
+}
+
+template<>
+inline int Cursor::decode(const Value &value) {
+    return static_cast<int>(value.integer);
+}
+
+template<>
+inline long long Cursor::decode(const Value &value) {
+    return value.integer;
+}
+
+template<>
+inline double Cursor::decode(const Value &value) {
+    return value.real;
+}
+
+template<>
+inline bool Cursor::decode(const Value &value) {
+    return value.integer != 0;
+}
+
+template<>
+inline stdx::string_view Cursor::decode(const Value &value) {
+    return stdx::string_view(value.text, value.size);
+}
+
+template<>
+inline std::string Cursor::decode(const Value &value) {
+    return std::string(value.text, value.size);
+}
 }
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "std_optional_compat.hpp"
+
+namespace Db {
+
+enum class JournalMode {
+    Delete,
+    Truncate,
+    Persist,
+    Memory,
+    Wal,
+    Off
+};
+
+enum class Synchronous {
+    Off,
+    Normal,
+    Full,
+    Extra
+};
+
+enum class TempStore {
+    Default,
+    File,
+    Memory
+};
+
+/**
+ * How a connection waits for the locks held by other connections, instead of failing immediately with SQLITE_BUSY.
+ * The default policy doesn't wait at all.
+ */
+struct BusyPolicy {
+    // The maximum time spent waiting for a single lock before the statement fails. When it's 0, it's never awaited.
+    std::chrono::milliseconds timeout{0};
+    // The first wait between two attempts, doubled at every attempt up to maxBackoff.
+    // Every wait is a random value between the half and the whole backoff, so the waiting connections don't retry
+    // all together.
+    std::chrono::milliseconds initialBackoff{1};
+    std::chrono::milliseconds maxBackoff{64};
+    // The maximum number of times an outermost transaction is executed again from the beginning after failing because
+    // the database is busy or locked, e.g. when a deferred transaction can't be upgraded to a write transaction.
+    // The transaction function must be safe to invoke again since its changes were rolled back.
+    int transactionRetries = 0;
+};
+
+/**
+ * The connection tuning applied once when the database is opened.
+ * The values which aren't set keep the SQLite defaults.
+ */
+struct Options {
+    stdx::optional<JournalMode> journalMode;
+    stdx::optional<Synchronous> synchronous;
+    // The maximum number of bytes of the database file accessed through memory-mapped I/O.
+    stdx::optional<int64_t> mmapSize;
+    // A positive value is a number of pages while a negative value is an amount of KiB, like in PRAGMA cache_size.
+    stdx::optional<int> cacheSize;
+    // It must be a power of two between 512 and 65536 and it's effective only before the database file is created.
+    stdx::optional<int> pageSize;
+    stdx::optional<TempStore> tempStore;
+    // When it's true, the database path can be an URI filename (e.g. "file:notes.db?cache=private").
+    bool uri = false;
+    // The maximum number of prepared statements cached by the connection. When it's 0, they aren't cached.
+    size_t statementCacheCapacity = 64;
+    // The number of read-only connections running the queries which don't write, next to the single writer connection.
+    // When it's greater than 0, the journal mode must be WAL so the readers don't block the writer and vice versa.
+    size_t readerConnections = 0;
+    BusyPolicy busyPolicy;
+    // When it's true, the transactions submitted with Database::submitTransaction() are executed on a dedicated thread.
+    // The statements executed outside a transaction by the other threads wait until the writer thread commits.
+    bool writerThread = false;
+    // The maximum number of submitted transactions committed together by the writer thread.
+    size_t maxGroupedTransactions = 64;
+    // When it's true, the execution statistics of every statement are collected, e.g. to find the slow queries.
+    bool profiling = false;
+};
+}
\ No newline at end of file
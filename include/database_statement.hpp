@@ -1,7 +1,13 @@
 #pragma once
 
+#include <cstddef>
+#include <functional>
+#include <iterator>
 #include <string>
 #include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
 #include "database_cursor.hpp"
 #include "std_optional_compat.hpp"
 
@@ -9,13 +15,83 @@ namespace Db {
 
 class Statement {
    public:
+    /**
+     * Defines what happens when a row of a batch fails.
+     */
+    enum class BatchMode {
+        // The failure is reported and the following rows are executed anyway, unless the failure rolled back the
+        // whole transaction (e.g. a full disk): in that case an exception is thrown like in AbortOnFailure.
+        ContinueOnFailure,
+        // All the rows of the batch are rolled back and an exception is thrown.
+        AbortOnFailure
+    };
+
+    struct BatchFailure {
+        // The index of the failed row in the batch, starting from 0.
+        size_t row;
+        std::string message;
+    };
+
+    struct BatchResult {
+        size_t executedRows;
+        std::vector<BatchFailure> failures;
+    };
+
     template<typename T>
     void bind(int colIndex, T value);
 
     template<typename T>
     T execute();
 
+    /**
+     * Gets the rowid of the last row inserted on the connection of this statement, read right after it was executed.
+     * It's read under the same lock of the execution, so the statements executed by the other threads don't change it.
+     *
+     * @return the rowid, or 0 if this statement was never executed or it can't change the DB.
+     */
+    [[nodiscard]] virtual long long lastInsertRowId() const = 0;
+
+    /**
+     * Gets the number of rows inserted, updated or deleted by the last execution of this statement.
+     *
+     * @return the number of rows, or 0 if this statement was never executed or it can't change the DB.
+     */
+    [[nodiscard]] virtual int changes() const = 0;
+
+    /**
+     * Executes this statement once for each row of the given range, in a single transaction.
+     * The values of each row are bound to the parameters of the statement, starting from the index 1.
+     * If a transaction is already running, the batch is nested in it, so it can be rolled back without affecting it.
+     *
+     * @param rows the range of the tuples to bind, e.g. std::vector<std::tuple<int, std::string>>.
+     * @param mode defines if the batch should continue after a row fails.
+     * @return the number of executed rows and the rows which failed.
+     */
+    template<typename Rows>
+    BatchResult executeBatch(const Rows &rows, BatchMode mode = BatchMode::ContinueOnFailure) {
+        auto row = std::begin(rows);
+        auto end = std::end(rows);
+        return executeBatchRows([&]() {
+            if (row == end) {
+                return false;
+            }
+            using Row = typename std::decay<decltype(*row)>::type;
+            bindRow(*row, std::make_index_sequence<std::tuple_size<Row>::value>());
+            ++row;
+            return true;
+        }, mode);
+    }
+
    protected:
+    /**
+     * Executes this statement until the given function doesn't bind any other row.
+     *
+     * @param bindNextRow binds the values of the next row and returns true, or returns false if there aren't rows.
+     * @param mode defines if the batch should continue after a row fails.
+     * @return the number of executed rows and the rows which failed.
+     */
+    virtual BatchResult executeBatchRows(const std::function<bool()> &bindNextRow, BatchMode mode) = 0;
+
     virtual void executeVoid() = 0;
 
     virtual stdx::optional<int> executeOptionalInt() = 0;
@@ -28,10 +104,19 @@ class Statement {
 
     virtual void bindInt(int colIndex, int value) = 0;
 
+    virtual void bindInt64(int colIndex, long long value) = 0;
+
     virtual void bindDouble(int colIndex, double value) = 0;
 
     virtual void bindString(int colIndex, std::string value) = 0;
 
     virtual void bindBool(int colIndex, bool value) = 0;
+
+   private:
+    template<typename Row, size_t... Is>
+    void bindRow(const Row &row, std::index_sequence<Is...>) {
+        // The parameters of the statement start from the index 1.
+        (bind(static_cast<int>(Is) + 1, std::get<Is>(row)), ...);
+    }
 };
 }  // namespace Db
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+/**
+ * Defines when the drafts changed in memory are written to the database by a background thread, instead of waiting
+ * for NotesInteractor::persistChanges(), which writes them immediately.
+ */
+struct DraftFlushPolicy {
+    // The drafts are written when they weren't changed for this interval.
+    std::chrono::milliseconds debounce{500};
+    // The drafts are written without waiting for the debounce when the text changed since the last write reaches this
+    // number of bytes, which bounds the text lost on a crash while the user keeps typing.
+    size_t dirtyBytesThreshold = 16 * 1024;
+};
@@ -2,15 +2,11 @@
 
 #include <string>
 #include "database.hpp"
+#include "database_options.hpp"
 
 namespace NoteDb {
 
-const int version = 2;
+const int version = 7;
 
-void initialize(std::string path);
-
-/* PRIVATE */ namespace {
-
-void createSchema(const std::shared_ptr<Db::Database> &db);
-}
+void initialize(std::string path, const Db::Options &options = Db::Options());
 }
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <ctime>
+#include <string>
+#include <vector>
+
+/**
+ * A note found by a text search.
+ * Instead of the whole description, it contains only a bounded snippet of it around the first occurrence of the text.
+ */
+class NoteMatch {
+   public:
+    /**
+     * A range of bytes of an UTF-8 string which contains an occurrence of the searched text.
+     * Both the start and the length are counted in bytes, not in characters, e.g. the start of "b" in "èb" is 2.
+     */
+    struct Range {
+        size_t start;
+        size_t length;
+
+        friend bool operator==(const Range &first, const Range &second);
+    };
+
+    NoteMatch(int id,
+              std::string title,
+              std::string snippet,
+              std::vector<Range> titleMatches,
+              std::vector<Range> snippetMatches,
+              std::time_t lastUpdateDate);
+
+    [[nodiscard]] int getId() const;
+
+    [[nodiscard]] std::string getTitle() const;
+
+    /**
+     * Gets the part of the description which contains the first occurrence of the searched text, or its beginning if
+     * the text is contained only in the title.
+     * It's cut at the boundaries of the UTF-8 characters, so its snippet matches are ranges of bytes of the snippet.
+     */
+    [[nodiscard]] std::string getSnippet() const;
+
+    [[nodiscard]] std::vector<Range> getTitleMatches() const;
+
+    [[nodiscard]] std::vector<Range> getSnippetMatches() const;
+
+    [[nodiscard]] std::time_t getLastUpdateTime() const;
+
+    friend bool operator==(const NoteMatch &first, const NoteMatch &second);
+
+   private:
+    int id;
+    std::string title;
+    std::string snippet;
+    std::vector<Range> titleMatches;
+    std::vector<Range> snippetMatches;
+    std::time_t lastUpdateDate;
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string>
+#include <ctime>
+
+/**
+ * The fields of a note shown in a list, with only the beginning of its description.
+ */
+class NoteSummary {
+   public:
+    NoteSummary(int id, std::string title, std::string snippet, std::time_t lastUpdateDate);
+
+    [[nodiscard]] int getId() const;
+
+    [[nodiscard]] std::string getTitle() const;
+
+    /**
+     * Gets the first line of the description, truncated if it's too long.
+     */
+    [[nodiscard]] std::string getSnippet() const;
+
+    [[nodiscard]] std::time_t getLastUpdateTime() const;
+
+    friend bool operator==(const NoteSummary &first, const NoteSummary &second);
+
+   private:
+    int id;
+    std::string title;
+    std::string snippet;
+    std::time_t lastUpdateDate;
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <vector>
+
+/**
+ * The notes changed by one or more committed transactions, coalesced by id, e.g. a note inserted and then updated is
+ * only inserted, while a note inserted and then deleted isn't reported at all.
+ * The ids are sorted in ascending order.
+ */
+class NotesChange {
+   public:
+    NotesChange(std::vector<int> insertedIds, std::vector<int> updatedIds, std::vector<int> deletedIds);
+
+    [[nodiscard]] std::vector<int> getInsertedIds() const;
+
+    [[nodiscard]] std::vector<int> getUpdatedIds() const;
+
+    [[nodiscard]] std::vector<int> getDeletedIds() const;
+
+    friend bool operator==(const NotesChange &first, const NotesChange &second);
+
+   private:
+    std::vector<int> insertedIds;
+    std::vector<int> updatedIds;
+    std::vector<int> deletedIds;
+};
@@ -1,15 +1,30 @@
 #pragma once
 
+#include <functional>
 #include <vector>
 #include "note.hpp"
+#include "note_match.hpp"
+#include "note_summary.hpp"
+#include "notes_change.hpp"
+#include "notes_page.hpp"
 #include "draft.hpp"
 #include "std_optional_compat.hpp"
 
 class NotesInteractor {
    public:
-    virtual void insertNote(Draft note) = 0;
+    /**
+     * Saves a new note and deletes the draft of the new note.
+     *
+     * @return the saved note, with its id and its last update date, so it can be shown without reading it again.
+     */
+    virtual Note insertNote(Draft note) = 0;
 
-    virtual void updateNote(int id, Draft note) = 0;
+    /**
+     * Saves the changes of a note and deletes its draft.
+     *
+     * @return the saved note or an empty optional if it doesn't exist.
+     */
+    virtual stdx::optional<Note> updateNote(int id, Draft note) = 0;
 
     virtual void updateNewDraftTitle(std::string title) = 0;
 
@@ -19,10 +34,70 @@ class NotesInteractor {
 
     virtual void updateExistingDraftDescription(int id, std::string description) = 0;
 
+    /**
+     * Inserts a text in the description of the draft of the new note, without copying the rest of the description.
+     * The draft is written only when the changes are persisted.
+     *
+     * @param offset the offset of the insertion in bytes, from 0 to the size of the description.
+     * @param text the inserted text.
+     */
+    virtual void insertInNewDraftDescription(size_t offset, std::string text) = 0;
+
+    /**
+     * Deletes a range of the description of the draft of the new note, without copying the rest of the description.
+     *
+     * @param offset the offset of the first deleted byte.
+     * @param count the number of deleted bytes.
+     */
+    virtual void eraseFromNewDraftDescription(size_t offset, size_t count) = 0;
+
+    /**
+     * Inserts a text in the description of the draft of an existing note, like insertInNewDraftDescription().
+     * The description of the draft must be set first with updateExistingDraftDescription().
+     */
+    virtual void insertInExistingDraftDescription(int id, size_t offset, std::string text) = 0;
+
+    /**
+     * Deletes a range of the description of the draft of an existing note, like eraseFromNewDraftDescription().
+     * The description of the draft must be set first with updateExistingDraftDescription().
+     */
+    virtual void eraseFromExistingDraftDescription(int id, size_t offset, size_t count) = 0;
+
     virtual std::vector<Note> getAllNotes() = 0;
 
+    /**
+     * Gets a page of the notes, from the most recently updated one.
+     *
+     * @param size the maximum number of notes in the page.
+     * @param after the key returned with the previous page, or an empty optional to get the first page.
+     * @return the page, with the key of the next one if there are other notes.
+     */
+    virtual NotesPage getNotesPage(size_t size, stdx::optional<NotesPage::Key> after) = 0;
+
+    /**
+     * Passes all the notes to the given consumer while they are read, without loading them together in memory.
+     */
+    virtual void forEachNote(const std::function<void(Note)> &consumer) = 0;
+
+    /**
+     * Gets the summaries of all the notes, from the most recently updated one, to show them in a list.
+     * The whole description of a note can be read with getNoteById().
+     */
+    virtual std::vector<NoteSummary> getNoteSummaries() = 0;
+
+    virtual stdx::optional<Note> getNoteById(int id) = 0;
+
     virtual std::vector<Note> getNotesByText(std::string text) = 0;
 
+    /**
+     * Gets the notes containing the given text, ranked by relevance and boosted by recency.
+     *
+     * @param text the text which should be contained in the title or in the description of the notes.
+     * @param limit the maximum number of returned notes.
+     * @return the best matches, from the most relevant one.
+     */
+    virtual std::vector<NoteMatch> getNotesByText(std::string text, size_t limit) = 0;
+
     virtual stdx::optional<Draft> getNewDraft() = 0;
 
     virtual stdx::optional<Draft> getExistingDraft(int id) = 0;
@@ -34,4 +109,16 @@ class NotesInteractor {
     virtual void deleteExistingDraft(int id) = 0;
 
     virtual void persistChanges() = 0;
+
+    /**
+     * Registers a listener notified after every commit which changed the notes, with the ids of the inserted, updated
+     * and deleted notes, so a list can be patched without reading all the notes again.
+     * It's invoked on the thread which committed the changes.
+     *
+     * @param listener the function receiving the changes.
+     * @return the id used to unsubscribe the listener.
+     */
+    virtual int subscribe(std::function<void(NotesChange)> listener) = 0;
+
+    virtual void unsubscribe(int subscriptionId) = 0;
 };
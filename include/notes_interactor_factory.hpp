@@ -1,9 +1,28 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include "draft_flush_policy.hpp"
 #include "notes_interactor.hpp"
+#include "std_optional_compat.hpp"
 
 class NotesInteractorFactory {
    public:
-    static std::shared_ptr<NotesInteractor> create();
+    /**
+     * Creates the interactor of the notes stored in the database of Db::Client.
+     *
+     * @param noteCacheBudget the maximum number of bytes of the notes cached in memory, to read them without querying
+     * the database until another connection changes it. When it's 0, the notes aren't cached.
+     * @param draftFlushPolicy defines when the changed drafts are written by a background thread. When it's empty,
+     * they are written only by NotesInteractor::persistChanges().
+     * @param preloadDrafts true to read all the drafts when the interactor is created, so they are accessed in memory
+     * instead of querying the database every time a draft is opened.
+     * @param draftLogPath the path of the log which records every change of the drafts until it's written, usually
+     * next to the database. The changes lost by a crash are written when the next interactor is created with the same
+     * log. When it's empty, the changes which aren't written are lost when the process ends.
+     */
+    static std::shared_ptr<NotesInteractor> create(size_t noteCacheBudget = 0,
+                                                   stdx::optional<DraftFlushPolicy> draftFlushPolicy = stdx::nullopt,
+                                                   bool preloadDrafts = false,
+                                                   const stdx::optional<std::string> &draftLogPath = stdx::nullopt);
 };
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <ctime>
+#include <vector>
+#include "note.hpp"
+#include "std_optional_compat.hpp"
+
+/**
+ * A page of the notes, sorted from the most recently updated one.
+ */
+class NotesPage {
+   public:
+    /**
+     * The position of the last note of a page, used to get the notes after it.
+     * It should be passed back unchanged to get the next page.
+     */
+    class Key {
+       public:
+        Key(std::time_t lastUpdateDate, int id);
+
+        [[nodiscard]] std::time_t getLastUpdateTime() const;
+
+        [[nodiscard]] int getId() const;
+
+        friend bool operator==(const Key &first, const Key &second);
+
+       private:
+        std::time_t lastUpdateDate;
+        int id;
+    };
+
+    NotesPage(std::vector<Note> notes, stdx::optional<Key> nextKey);
+
+    [[nodiscard]] std::vector<Note> getNotes() const;
+
+    /**
+     * Gets the key used to get the next page, or an empty optional if this is the last page.
+     */
+    [[nodiscard]] stdx::optional<Key> getNextKey() const;
+
+    friend bool operator==(const NotesPage &first, const NotesPage &second);
+
+   private:
+    std::vector<Note> notes;
+    stdx::optional<Key> nextKey;
+};
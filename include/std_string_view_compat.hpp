@@ -0,0 +1,12 @@
+#pragma once
+
+// The alias must point to the same namespace chosen in std_optional_compat.hpp, since it can't be redefined.
+#if __has_include(<string_view>)
+#include <string_view>
+namespace stdx = std;
+#elif __has_include(<experimental/string_view>)
+#include <experimental/string_view>
+namespace stdx = std::experimental;
+#else
+#error Must have a string_view type, either from <string_view> or from <experimental/string_view>.
+#endif
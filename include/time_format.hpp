@@ -1,13 +1,45 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <ctime>
+#include "std_optional_compat.hpp"
+#include "std_string_view_compat.hpp"
 
 namespace Time::Format {
 
 typedef std::string ISO_8601;
 
+// The number of characters of a time formatted as "YYYY-MM-DDThh:mm:ssZ".
+const size_t length = 20;
+
+/**
+ * Formats the given time in UTC, with the years from 0000 to 9999.
+ * It doesn't depend on the locale and it can be invoked concurrently.
+ */
 ISO_8601 format(std::time_t time);
 
-std::time_t parse(ISO_8601 formattedTime);
-}
\ No newline at end of file
+/**
+ * Writes the given time in UTC like format(), without allocating any memory.
+ *
+ * @param time the time in seconds since the epoch.
+ * @param buffer the buffer which will contain the formatted time, with space for at least Time::Format::length
+ * characters. The null terminator isn't written.
+ * @return the pointer after the last written character.
+ */
+char *format(std::time_t time, char *buffer);
+
+/**
+ * Parses a time in UTC formatted as "YYYY-MM-DDThh:mm:ssZ", throwing an exception if the text isn't a valid time.
+ */
+std::time_t parse(stdx::string_view formattedTime);
+
+/**
+ * Parses a time like parse(), without allocating any memory.
+ *
+ * @param formattedTime the time formatted as "YYYY-MM-DDThh:mm:ssZ".
+ * @return the time in seconds since the epoch, or an empty optional if the text doesn't have exactly that format or
+ * it contains an invalid date, e.g. "2019-02-29T00:00:00Z".
+ */
+stdx::optional<std::time_t> tryParse(stdx::string_view formattedTime);
+}
@@ -0,0 +1,39 @@
+#!/bin/bash
+
+scriptDir="$(cd "$(dirname "${BASH_SOURCE[0]}")" >/dev/null 2>&1 && pwd)"
+projectDir=${scriptDir}
+
+benchmarksBuildDir=${projectDir}/build/benchmarks
+# Check if the OS is supported.
+cmakeOS=$("${projectDir}"/.scripts/get-os.sh)
+# shellcheck disable=SC2181
+if [[ $? != 0 ]]; then
+    echo "This OS \"${cmakeOS}\" can't run the benchmarks."
+    exit 1
+fi
+
+while [ $# -gt 0 ]; do
+    case "$1" in
+    --filter=*)
+        filter="${1#*=}"
+        ;;
+    *)
+        cat <<EOT
+The argument "$1" can't be recognized.
+Supported args:
+--filter: runs only the benchmarks whose name contains the given text
+EOT
+        exit 1
+        ;;
+    esac
+    shift
+done
+
+cmake "${projectDir}" -B"${benchmarksBuildDir}" \
+    -DCMAKE_C_COMPILER="${CC}" \
+    -DCMAKE_CXX_COMPILER="${CXX}" \
+    -DCMAKE_BUILD_TYPE=Release \
+    -DENABLE_TESTS=OFF \
+    -DENABLE_BENCHMARKS=ON
+
+(cd "${benchmarksBuildDir}" && make lib_benchmarks && ./out/lib_benchmarks "${filter}")
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+/**
+ * Unbounded lock-free queue which supports multiple producers and a single consumer.
+ * The producers never wait for each other or for the consumer, since a push is a single atomic exchange.
+ * The consumer can see the queue as empty while a push is still in progress, so it must be notified by the producers
+ * after their push ends, if it waits for the values.
+ *
+ * @tparam T the type of the values, which must be default constructible.
+ */
+template<typename T>
+class MpscQueue {
+   public:
+    MpscQueue() : head(new Node()), tail(head.load()) {}
+
+    MpscQueue(const MpscQueue &) = delete;
+
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    ~MpscQueue() {
+        T value;
+        while (pop(value)) {}
+        delete tail;
+    }
+
+    /**
+     * Adds a value at the end of the queue. It can be invoked by any thread.
+     */
+    void push(T value) {
+        auto node = new Node();
+        node->value = std::move(value);
+        auto previous = head.exchange(node, std::memory_order_acq_rel);
+        // From now on, the node is visible to the consumer.
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    /**
+     * Removes the first value of the queue. It can be invoked only by the consumer thread.
+     *
+     * @param value the destination of the removed value.
+     * @return true if a value was removed, false if the queue was empty.
+     */
+    bool pop(T &value) {
+        auto next = tail->next.load(std::memory_order_acquire);
+        if (next == nullptr) {
+            return false;
+        }
+        value = std::move(next->value);
+        // The node of the removed value becomes the new placeholder at the beginning of the queue.
+        next->value = T();
+        delete tail;
+        tail = next;
+        return true;
+    }
+
+    /**
+     * Checks if the queue is empty. It can be invoked only by the consumer thread.
+     */
+    [[nodiscard]] bool empty() const {
+        return tail->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+   private:
+    struct Node {
+        T value{};
+        std::atomic<Node *> next{nullptr};
+    };
+
+    // The last pushed node, updated by the producers.
+    std::atomic<Node *> head;
+    // The placeholder node preceding the first value, owned by the consumer.
+    Node *tail;
+};
@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <random>
+#include <thread>
+#include "busy_handler.hpp"
+
+namespace Db::Sql {
+
+BusyHandler::Stats &BusyHandler::Stats::operator+=(const Stats &other) {
+    retries += other.retries;
+    timeouts += other.timeouts;
+    transactionRetries += other.transactionRetries;
+    waitTime += other.waitTime;
+    return *this;
+}
+
+BusyHandler::BusyHandler(const BusyPolicy &policy) : policy(policy) {}
+
+void BusyHandler::install(sqlite3 *db) {
+    if (policy.timeout.count() > 0) {
+        sqlite3_busy_handler(db, &BusyHandler::onBusy, this);
+    }
+}
+
+bool BusyHandler::awaitTransactionRetry(int attempt) {
+    if (attempt > policy.transactionRetries) {
+        return false;
+    }
+    sleep(backoff(attempt - 1));
+    transactionRetries++;
+    return true;
+}
+
+BusyHandler::Stats BusyHandler::stats() const {
+    return Stats{
+        retries,
+        timeouts,
+        transactionRetries,
+        std::chrono::microseconds(waitMicroseconds)
+    };
+}
+
+int BusyHandler::onBusy(void *handler, int count) {
+    auto busyHandler = static_cast<BusyHandler *>(handler);
+    auto now = std::chrono::steady_clock::now();
+    // SQLite starts counting again from 0 every time a new lock is awaited.
+    if (count == 0) {
+        busyHandler->waitStart = now;
+    }
+    auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(
+        busyHandler->policy.timeout - (now - busyHandler->waitStart));
+    if (remaining.count() <= 0) {
+        busyHandler->timeouts++;
+        // SQLite returns SQLITE_BUSY to the caller.
+        return 0;
+    }
+    busyHandler->sleep(std::min(busyHandler->backoff(count), remaining));
+    busyHandler->retries++;
+    return 1;
+}
+
+std::chrono::microseconds BusyHandler::backoff(int attempt) const {
+    // The shift is bounded to avoid the overflow, since the backoff reaches its maximum much earlier anyway.
+    auto exponential = std::chrono::microseconds(policy.initialBackoff) * (1 << std::min(attempt, 20));
+    auto ceiling = std::min(exponential, std::chrono::microseconds(policy.maxBackoff));
+    thread_local std::minstd_rand generator(std::random_device{}());
+    std::uniform_int_distribution<std::chrono::microseconds::rep> jitter(ceiling.count() / 2, ceiling.count());
+    return std::chrono::microseconds(jitter(generator));
+}
+
+void BusyHandler::sleep(std::chrono::microseconds duration) {
+    auto start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(duration);
+    auto slept = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    waitMicroseconds += slept.count();
+}
+}  // namespace Db::Sql
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include "sqlite3/sqlite3.h"
+#include "core/include_macros.hpp"
+#include AMALGAMATION(database_options.hpp)
+
+namespace Db::Sql {
+
+/**
+ * Applies a Db::BusyPolicy to a single sqlite3 connection.
+ * While a lock is held by another connection, SQLite invokes this handler which sleeps with a jittered exponential
+ * backoff until the lock is acquired or the policy's timeout expires.
+ * The same backoff is used between the attempts of a transaction executed again from the beginning.
+ */
+class BusyHandler {
+   public:
+    /**
+     * The counters collected by the handler since its creation.
+     */
+    struct Stats {
+        // Number of times a lock was requested again after waiting.
+        unsigned long retries;
+        // Number of times the timeout expired before acquiring a lock, so the statement failed.
+        unsigned long timeouts;
+        // Number of times an outermost transaction was executed again after failing because of a lock.
+        unsigned long transactionRetries;
+        // The total time spent sleeping before acquiring the locks or executing the transactions again.
+        std::chrono::microseconds waitTime;
+
+        // Sums the counters of another handler, e.g. to aggregate the ones of multiple connections.
+        Stats &operator+=(const Stats &other);
+    };
+
+    explicit BusyHandler(const BusyPolicy &policy);
+
+    /**
+     * Registers this handler on the given connection, if the policy's timeout is greater than 0.
+     * The handler must outlive the connection.
+     *
+     * @param db the pointer to the sqlite3 database which should wait for the locks.
+     */
+    void install(sqlite3 *db);
+
+    /**
+     * Waits before executing a transaction again if the policy allows another attempt.
+     *
+     * @param attempt the number of attempts already failed, starting from 1.
+     * @return true if the transaction should be executed again, false if the attempts are exhausted.
+     */
+    bool awaitTransactionRetry(int attempt);
+
+    [[nodiscard]] Stats stats() const;
+
+   private:
+    BusyPolicy policy;
+    // When the handler started to wait for the current lock.
+    std::chrono::steady_clock::time_point waitStart;
+    std::atomic<unsigned long> retries{0};
+    std::atomic<unsigned long> timeouts{0};
+    std::atomic<unsigned long> transactionRetries{0};
+    std::atomic<std::chrono::microseconds::rep> waitMicroseconds{0};
+
+    static int onBusy(void *handler, int count);
+
+    [[nodiscard]] std::chrono::microseconds backoff(int attempt) const;
+
+    void sleep(std::chrono::microseconds duration);
+};
+}  // namespace Db::Sql
@@ -0,0 +1,164 @@
+#include <cstring>
+#include "change_tracker.hpp"
+
+namespace Db::Sql {
+
+void ChangeTracker::install(sqlite3 *connection) {
+    db = connection;
+    sqlite3_update_hook(db, onUpdate, this);
+    sqlite3_commit_hook(db, onCommit, this);
+    sqlite3_rollback_hook(db, onRollback, this);
+}
+
+int ChangeTracker::addListener(Listener listener) {
+    std::lock_guard<std::mutex> lock(mutex);
+    int listenerId = nextListenerId++;
+    listeners.emplace(listenerId, std::move(listener));
+    return listenerId;
+}
+
+void ChangeTracker::removeListener(int listenerId) {
+    std::lock_guard<std::mutex> lock(mutex);
+    listeners.erase(listenerId);
+}
+
+size_t ChangeTracker::mark() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return pendingChanges.size();
+}
+
+void ChangeTracker::rollbackTo(size_t mark) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (mark < pendingChanges.size()) {
+        pendingChanges.erase(pendingChanges.begin() + mark, pendingChanges.end());
+    }
+}
+
+void ChangeTracker::dispatch() {
+    std::vector<Change> changes;
+    std::vector<Listener> notifiedListeners;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!sqlite3_get_autocommit(db)) {
+            return;
+        }
+        // The connection left the transaction and it wasn't rolled back, so the commit succeeded.
+        settleCommit();
+        if (committedChanges.empty()) {
+            return;
+        }
+        changes.swap(committedChanges);
+        for (const auto &listener : listeners) {
+            notifiedListeners.push_back(listener.second);
+        }
+    }
+    auto tableChanges = coalesce(changes);
+    if (tableChanges.empty()) {
+        return;
+    }
+    for (const auto &listener : notifiedListeners) {
+        listener(tableChanges);
+    }
+}
+
+std::vector<Db::TableChanges> ChangeTracker::coalesce(const std::vector<Change> &changes) {
+    // The last state of every changed row, by table and rowid.
+    std::map<std::string, std::map<long long, int>> rows;
+    for (const auto &change : changes) {
+        auto &tableRows = rows[std::get<1>(change)];
+        auto rowId = std::get<2>(change);
+        auto previous = tableRows.find(rowId);
+        switch (std::get<0>(change)) {
+            case SQLITE_INSERT:
+                // A rowid deleted and inserted again is a row which was replaced.
+                if (previous != tableRows.end() && previous->second == SQLITE_DELETE) {
+                    previous->second = SQLITE_UPDATE;
+                } else {
+                    tableRows[rowId] = SQLITE_INSERT;
+                }
+                break;
+            case SQLITE_UPDATE:
+                // The listeners don't know an inserted row yet, so it's reported as inserted with its last values.
+                if (previous == tableRows.end()) {
+                    tableRows.emplace(rowId, SQLITE_UPDATE);
+                }
+                break;
+            case SQLITE_DELETE:
+                // A row inserted and then deleted was never seen by the listeners.
+                if (previous != tableRows.end() && previous->second == SQLITE_INSERT) {
+                    tableRows.erase(previous);
+                } else {
+                    tableRows[rowId] = SQLITE_DELETE;
+                }
+                break;
+            default:
+                break; // LCOV_EXCL_LINE
+        }
+    }
+
+    std::vector<Db::TableChanges> tableChanges;
+    for (const auto &table : rows) {
+        if (table.second.empty()) {
+            continue;
+        }
+        Db::TableChanges changesOfTable;
+        changesOfTable.table = table.first;
+        for (const auto &row : table.second) {
+            if (row.second == SQLITE_INSERT) {
+                changesOfTable.insertedRowIds.push_back(row.first);
+            } else if (row.second == SQLITE_UPDATE) {
+                changesOfTable.updatedRowIds.push_back(row.first);
+            } else {
+                changesOfTable.deletedRowIds.push_back(row.first);
+            }
+        }
+        tableChanges.push_back(std::move(changesOfTable));
+    }
+    return tableChanges;
+} // LCOV_EXCL_BR_LINE
+
+void ChangeTracker::settleCommit() {
+    committedChanges.insert(committedChanges.end(),
+                            std::make_move_iterator(committingChanges.begin()),
+                            std::make_move_iterator(committingChanges.end()));
+    committingChanges.clear();
+}
+
+void ChangeTracker::onUpdate(void *tracker, int operation, const char *dbName, const char *table, sqlite3_int64 rowId) {
+    auto changeTracker = static_cast<ChangeTracker *>(tracker);
+    // The changes of the attached and temporary databases aren't tracked.
+    if (std::strcmp(dbName, "main") != 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(changeTracker->mutex);
+    // Nothing is recorded when no one would be notified.
+    if (changeTracker->listeners.empty()) {
+        return;
+    }
+    if (changeTracker->pendingChanges.empty()) {
+        // A new transaction started, so the previous commit succeeded.
+        changeTracker->settleCommit();
+    }
+    changeTracker->pendingChanges.emplace_back(operation, table, rowId);
+}
+
+int ChangeTracker::onCommit(void *tracker) {
+    auto changeTracker = static_cast<ChangeTracker *>(tracker);
+    std::lock_guard<std::mutex> lock(changeTracker->mutex);
+    auto &committing = changeTracker->committingChanges;
+    auto &pending = changeTracker->pendingChanges;
+    // A commit retried after failing (e.g. because it was busy) adds the changes recorded in the meantime.
+    committing.insert(committing.end(), std::make_move_iterator(pending.begin()), std::make_move_iterator(pending.end()));
+    pending.clear();
+    // The commit can proceed.
+    return 0;
+}
+
+void ChangeTracker::onRollback(void *tracker) {
+    auto changeTracker = static_cast<ChangeTracker *>(tracker);
+    std::lock_guard<std::mutex> lock(changeTracker->mutex);
+    changeTracker->pendingChanges.clear();
+    // The rollback can follow a failed commit.
+    changeTracker->committingChanges.clear();
+}
+}  // namespace Db::Sql
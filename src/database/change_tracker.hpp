@@ -0,0 +1,98 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "sqlite3/sqlite3.h"
+#include "core/include_macros.hpp"
+#include AMALGAMATION(database_changes.hpp)
+
+namespace Db::Sql {
+
+/**
+ * Collects the rows changed on a single sqlite3 connection and notifies them to its listeners after they are committed.
+ * The changes are recorded by sqlite3_update_hook() and discarded by sqlite3_rollback_hook().
+ * Since sqlite3_commit_hook() is invoked before the commit, which can still fail, its changes are considered committed
+ * only when the connection leaves the transaction without rolling back or when the next transaction starts.
+ * The changes of a rolled back savepoint must be discarded with rollbackTo(), since SQLite doesn't invoke any hook for
+ * them.
+ * The changes of the tables WITHOUT ROWID and the rows deleted by the truncate optimization (a DELETE without WHERE on
+ * a table without triggers) aren't reported by SQLite.
+ * It can be used by multiple threads sharing the same connection.
+ */
+class ChangeTracker {
+   public:
+    using Listener = std::function<void(const std::vector<Db::TableChanges> &)>;
+
+    /**
+     * Starts tracking the changes of the given connection. The tracker must outlive the connection.
+     *
+     * @param db the pointer to the sqlite3 database whose changes are tracked.
+     */
+    void install(sqlite3 *db);
+
+    /**
+     * Registers a listener notified with the committed changes.
+     *
+     * @return the id used to remove the listener.
+     */
+    int addListener(Listener listener);
+
+    void removeListener(int listenerId);
+
+    /**
+     * Gets the position of the changes of the current transaction, to discard the ones recorded after it.
+     */
+    [[nodiscard]] size_t mark() const;
+
+    /**
+     * Discards the changes recorded after the given position, e.g. when a savepoint is rolled back.
+     */
+    void rollbackTo(size_t mark);
+
+    /**
+     * Notifies the committed changes to the listeners, on the caller's thread, if there isn't a transaction in
+     * progress on the connection. The changes are coalesced by rowid since the last notification.
+     * The changes committed by concurrent threads can be notified in a different order than their commits.
+     */
+    void dispatch();
+
+    /**
+     * Coalesces the given changes by rowid, grouping them by table.
+     *
+     * @param changes the changes in the order they were executed, each one with its operation
+     * (SQLITE_INSERT, SQLITE_UPDATE or SQLITE_DELETE), its table and its rowid.
+     * @return the changes of the tables, sorted by table name.
+     */
+    static std::vector<Db::TableChanges> coalesce(const std::vector<std::tuple<int, std::string, long long>> &changes);
+
+   private:
+    using Change = std::tuple<int, std::string, long long>;
+
+    sqlite3 *db{};
+    // The changes of the current transaction, in the order they were executed.
+    std::vector<Change> pendingChanges;
+    // The changes of the transaction which is committing.
+    std::vector<Change> committingChanges;
+    // The changes already committed but not notified yet.
+    std::vector<Change> committedChanges;
+    std::map<int, Listener> listeners;
+    int nextListenerId = 0;
+    // The listeners are invoked without holding it, so they can use the connection.
+    mutable std::mutex mutex;
+
+    /**
+     * Moves the changes of the last commit to the committed changes. It must be invoked holding the mutex.
+     */
+    void settleCommit();
+
+    static void onUpdate(void *tracker, int operation, const char *dbName, const char *table, sqlite3_int64 rowId);
+
+    static int onCommit(void *tracker);
+
+    static void onRollback(void *tracker);
+};
+}  // namespace Db::Sql
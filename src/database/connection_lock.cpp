@@ -0,0 +1,16 @@
+#include "connection_lock.hpp"
+
+namespace Db::Sql {
+
+ConnectionLock::ConnectionLock(std::mutex &transactionMutex, const std::atomic<std::thread::id> &transactionThread) :
+    transactionMutex(transactionMutex),
+    transactionThread(transactionThread) {}
+
+std::unique_lock<std::mutex> ConnectionLock::acquire() const {
+    if (transactionThread == std::this_thread::get_id()) {
+        // The statement is executed inside the caller's transaction, which already holds the mutex.
+        return std::unique_lock<std::mutex>();
+    }
+    return std::unique_lock<std::mutex>(transactionMutex);
+}
+}  // namespace Db::Sql
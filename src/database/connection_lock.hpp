@@ -0,0 +1,35 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace Db::Sql {
+
+/**
+ * Serializes the statements executed outside a transaction on a connection shared by multiple threads with the
+ * transactions of the other threads, so they don't join a transaction which isn't theirs.
+ * The statements executed by the thread of the current transaction are part of it, so they don't lock the connection.
+ */
+class ConnectionLock {
+   public:
+    /**
+     * @param transactionMutex the mutex held during the outermost transactions on the connection.
+     * @param transactionThread the thread executing the current transaction on the connection, if any.
+     * Both must outlive this object.
+     */
+    ConnectionLock(std::mutex &transactionMutex, const std::atomic<std::thread::id> &transactionThread);
+
+    /**
+     * Waits until the connection isn't used by the transactions of other threads.
+     *
+     * @return the lock which must be held while the statement is executed, or a lock which doesn't own the mutex if
+     * the caller's thread is executing a transaction.
+     */
+    [[nodiscard]] std::unique_lock<std::mutex> acquire() const;
+
+   private:
+    std::mutex &transactionMutex;
+    const std::atomic<std::thread::id> &transactionThread;
+};
+}  // namespace Db::Sql
@@ -7,13 +7,13 @@
 
 namespace Db {
 
-void Client::create(std::string dbPath) {
+void Client::create(std::string dbPath, const Options &options) {
     if (databaseInstance != nullptr) {
         std::cout << "WARNING: the database is already created." << std::endl;
         return;
     }
     // We just ignore the lint error to avoid to cast both flags to unsigned.
-    databaseInstance = std::make_shared<Sql::Database>(dbPath, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+    databaseInstance = std::make_shared<Sql::Database>(dbPath, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, options);
 }
 
 std::shared_ptr<Database> Client::get() {
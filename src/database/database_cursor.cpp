@@ -1,8 +1,29 @@
 #include "core/include_macros.hpp"
+#include "core/exception_macros.hpp"
+#include "database_exception.hpp"
 #include AMALGAMATION(database_cursor.hpp)
 
 namespace Db {
 
+void Cursor::ensureColumnCount(int expectedCount) {
+    int columnCount = getColumnCount();
+    if (columnCount != expectedCount) {
+        THROW(Db::Exception("The rows should have " +
+            std::to_string(expectedCount) +
+            " columns instead of " +
+            std::to_string(columnCount)));
+    }
+}
+
+void Cursor::throwTypeMismatch(int colIndex, ColumnType expected, ColumnType actual) {
+    THROW(Db::Exception("The column at index " +
+        std::to_string(colIndex) +
+        " should be of type " +
+        std::to_string(static_cast<int>(expected)) +
+        " instead of " +
+        std::to_string(static_cast<int>(actual))));
+}
+
 /* TEMPLATES */
 
 template<>
@@ -13,6 +34,14 @@ int Cursor::get(int colIndex) {
     return getInt(colIndex);
 }
 
+template<>
+long long Cursor::get(int colIndex) {
+    ensureNextWasInvoked();
+    ensureIndexInBounds(colIndex);
+
+    return getInt64(colIndex);
+}
+
 template<>
 double Cursor::get(int colIndex) {
     ensureNextWasInvoked();
@@ -29,6 +58,14 @@ std::string Cursor::get(int colIndex) {
     return getString(colIndex);
 }
 
+template<>
+stdx::string_view Cursor::get(int colIndex) {
+    ensureNextWasInvoked();
+    ensureIndexInBounds(colIndex);
+
+    return getStringView(colIndex);
+}
+
 template<>
 bool Cursor::get(int colIndex) {
     ensureNextWasInvoked();
@@ -35,6 +35,11 @@ void Statement::bind(int colIndex, int value) {
     bindInt(colIndex, value);
 }
 
+template<>
+void Statement::bind(int colIndex, long long value) {
+    bindInt64(colIndex, value);
+}
+
 template<>
 void Statement::bind(int colIndex, double value) {
     bindDouble(colIndex, value);
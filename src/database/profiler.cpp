@@ -0,0 +1,218 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include "profiler.hpp"
+
+namespace Db::Sql {
+
+/* PRIVATE */ namespace {
+
+// The number of durations kept for each statement to compute the percentiles.
+const size_t maxRecentTimes = 1024;
+
+int64_t percentile(std::vector<int64_t> &values, int percent) {
+    if (values.empty()) {
+        return 0;
+    }
+    auto index = (values.size() - 1) * percent / 100;
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+bool isIdentifierChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+void appendJsonString(std::string &json, const std::string &value) {
+    json += '"';
+    for (char c : value) {
+        switch (c) {
+            case '"':
+                json += "\\\"";
+                break;
+            case '\\':
+                json += "\\\\";
+                break;
+            case '\n':
+                json += "\\n";
+                break;
+            case '\t':
+                json += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    json += escaped;
+                } else {
+                    json += c;
+                }
+        }
+    }
+    json += '"';
+}
+}
+
+void Profiler::install(sqlite3 *db) {
+    Connection *connection;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        connections.push_back(std::unique_ptr<Connection>(new Connection()));
+        connection = connections.back().get();
+        connection->profiler = this;
+    }
+    sqlite3_trace_v2(db, SQLITE_TRACE_PROFILE | SQLITE_TRACE_ROW, &Profiler::onTrace, connection);
+}
+
+std::vector<Profiler::Entry> Profiler::entries() const {
+    std::vector<Entry> result;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        result.reserve(samples.size());
+        for (const auto &sample : samples) {
+            auto &stats = sample.second;
+            auto times = stats.recentTimesNs;
+            result.push_back(Entry{
+                sample.first,
+                stats.calls,
+                stats.rows,
+                stats.totalTimeNs,
+                percentile(times, 50),
+                percentile(times, 90),
+                percentile(times, 99),
+                stats.fullScanSteps,
+                stats.sorts,
+                stats.autoIndexes
+            });
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const Entry &first, const Entry &second) {
+        return first.totalTimeNs > second.totalTimeNs;
+    });
+    return result;
+}
+
+std::string Profiler::toJson() const {
+    std::string json = "{\"statements\":[";
+    auto allEntries = entries();
+    for (size_t i = 0; i < allEntries.size(); i++) {
+        auto &entry = allEntries[i];
+        if (i > 0) {
+            json += ',';
+        }
+        json += "{\"sql\":";
+        appendJsonString(json, entry.sql);
+        json += ",\"calls\":" + std::to_string(entry.calls) +
+            ",\"rows\":" + std::to_string(entry.rows) +
+            ",\"totalTimeNs\":" + std::to_string(entry.totalTimeNs) +
+            ",\"p50TimeNs\":" + std::to_string(entry.p50TimeNs) +
+            ",\"p90TimeNs\":" + std::to_string(entry.p90TimeNs) +
+            ",\"p99TimeNs\":" + std::to_string(entry.p99TimeNs) +
+            ",\"fullScanSteps\":" + std::to_string(entry.fullScanSteps) +
+            ",\"sorts\":" + std::to_string(entry.sorts) +
+            ",\"autoIndexes\":" + std::to_string(entry.autoIndexes) + "}";
+    }
+    json += "]}";
+    return json;
+}
+
+void Profiler::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    samples.clear();
+    // The rows of the executions which are still running belong to the previous statistics.
+    for (auto &connection : connections) {
+        std::lock_guard<std::mutex> connectionLock(connection->mutex);
+        connection->pendingRows.clear();
+    }
+}
+
+std::string Profiler::normalize(const std::string &sql) {
+    std::string normalized;
+    normalized.reserve(sql.size());
+    size_t i = 0;
+    while (i < sql.size()) {
+        char c = sql[i];
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            while (i < sql.size() && std::isspace(static_cast<unsigned char>(sql[i]))) {
+                i++;
+            }
+            // The leading and trailing whitespaces are removed.
+            if (!normalized.empty() && i < sql.size()) {
+                normalized += ' ';
+            }
+            continue;
+        }
+        if (c == '\'') {
+            // A quote inside a string literal is escaped by doubling it.
+            i++;
+            while (i < sql.size() && !(sql[i] == '\'' && (i + 1 == sql.size() || sql[i + 1] != '\''))) {
+                i += sql[i] == '\'' ? 2 : 1;
+            }
+            i++;
+            normalized += '?';
+            continue;
+        }
+        // e.g. the digits of "note2" or of the numbered parameter "?2" aren't literals.
+        bool identifierBefore = !normalized.empty() && (isIdentifierChar(normalized.back()) || normalized.back() == '?');
+        if (std::isdigit(static_cast<unsigned char>(c)) && !identifierBefore) {
+            while (i < sql.size() && (isIdentifierChar(sql[i]) || sql[i] == '.')) {
+                i++;
+            }
+            normalized += '?';
+            continue;
+        }
+        normalized += c;
+        i++;
+    }
+    return normalized;
+}
+
+int Profiler::onTrace(unsigned int type, void *connection, void *stmt, void *extra) {
+    auto &tracedConnection = *static_cast<Connection *>(connection);
+    auto tracedStmt = static_cast<sqlite3_stmt *>(stmt);
+    if (type == SQLITE_TRACE_ROW) {
+        recordRow(tracedConnection, tracedStmt);
+    } else if (type == SQLITE_TRACE_PROFILE) {
+        tracedConnection.profiler->recordExecution(tracedConnection, tracedStmt, *static_cast<int64_t *>(extra));
+    }
+    // The return value is ignored by SQLite.
+    return 0;
+}
+
+void Profiler::recordRow(Connection &connection, sqlite3_stmt *stmt) {
+    std::lock_guard<std::mutex> lock(connection.mutex);
+    connection.pendingRows[stmt]++;
+}
+
+void Profiler::recordExecution(Connection &connection, sqlite3_stmt *stmt, int64_t timeNs) {
+    auto sql = normalize(sqlite3_sql(stmt));
+    // The counters are reset, so the next execution of the same (e.g. cached) statement starts from 0.
+    auto fullScanSteps = sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_FULLSCAN_STEP, 1);
+    auto sorts = sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_SORT, 1);
+    auto autoIndexes = sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_AUTOINDEX, 1);
+
+    unsigned long rows = 0;
+    {
+        std::lock_guard<std::mutex> connectionLock(connection.mutex);
+        auto pendingRows = connection.pendingRows.find(stmt);
+        if (pendingRows != connection.pendingRows.end()) {
+            rows = pendingRows->second;
+            connection.pendingRows.erase(pendingRows);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto &stats = samples[sql];
+    stats.calls++;
+    stats.totalTimeNs += timeNs;
+    stats.fullScanSteps += fullScanSteps;
+    stats.sorts += sorts;
+    stats.autoIndexes += autoIndexes;
+    stats.rows += rows;
+    if (stats.recentTimesNs.size() < maxRecentTimes) {
+        stats.recentTimesNs.push_back(timeNs);
+    } else {
+        stats.recentTimesNs[(stats.calls - 1) % maxRecentTimes] = timeNs;
+    }
+}
+}  // namespace Db::Sql
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "sqlite3/sqlite3.h"
+
+namespace Db::Sql {
+
+/**
+ * Collects the execution statistics of the statements run on one or more connections, grouped by their normalized SQL
+ * (the literals are replaced by "?" and the whitespaces are collapsed).
+ * The durations are reported by SQLite through sqlite3_trace_v2() when a statement finishes or is reset, and the
+ * counters of the query planner are read with sqlite3_stmt_status().
+ */
+class Profiler {
+   public:
+    /**
+     * The statistics of the statements with the same normalized SQL.
+     */
+    struct Entry {
+        std::string sql;
+        // Number of executions.
+        unsigned long calls;
+        // Number of rows returned by all the executions.
+        unsigned long rows;
+        // Wall time of all the executions, in nanoseconds.
+        int64_t totalTimeNs;
+        // Percentiles of the wall time of the most recent executions, in nanoseconds.
+        int64_t p50TimeNs;
+        int64_t p90TimeNs;
+        int64_t p99TimeNs;
+        // Number of steps of the full table scans (SQLITE_STMTSTATUS_FULLSCAN_STEP).
+        unsigned long fullScanSteps;
+        // Number of sorts which couldn't use an index (SQLITE_STMTSTATUS_SORT).
+        unsigned long sorts;
+        // Number of rows inserted in the automatic indexes (SQLITE_STMTSTATUS_AUTOINDEX).
+        unsigned long autoIndexes;
+    };
+
+    /**
+     * Starts profiling the statements of the given connection. The profiler must outlive the connection.
+     *
+     * @param db the pointer to the sqlite3 database which should be profiled.
+     */
+    void install(sqlite3 *db);
+
+    /**
+     * Gets the statistics collected so far, sorted by descending total time.
+     */
+    [[nodiscard]] std::vector<Entry> entries() const;
+
+    /**
+     * Gets the statistics collected so far as a JSON object, sorted by descending total time, e.g.
+     * {"statements":[{"sql":"SELECT * FROM notes WHERE id = ?","calls":2,"rows":2,"totalTimeNs":4100,...}]}
+     */
+    [[nodiscard]] std::string toJson() const;
+
+    void clear();
+
+    /**
+     * Replaces the literals of the given query with "?" and collapses its whitespaces, so the queries which differ only
+     * by their values are grouped together.
+     */
+    static std::string normalize(const std::string &sql);
+
+   private:
+    struct Samples {
+        unsigned long calls = 0;
+        unsigned long rows = 0;
+        int64_t totalTimeNs = 0;
+        unsigned long fullScanSteps = 0;
+        unsigned long sorts = 0;
+        unsigned long autoIndexes = 0;
+        // Circular buffer of the most recent durations, used to compute the percentiles.
+        std::vector<int64_t> recentTimesNs;
+    };
+
+    /**
+     * The rows counted on a profiled connection. Each row is counted by the thread using the connection, so its lock
+     * isn't contended by the other connections sharing the profiler.
+     */
+    struct Connection {
+        Profiler *profiler;
+        std::mutex mutex;
+        // The rows returned by the statements which are still executing.
+        std::unordered_map<sqlite3_stmt *, unsigned long> pendingRows;
+    };
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, Samples> samples;
+    std::vector<std::unique_ptr<Connection>> connections;
+
+    static int onTrace(unsigned int type, void *connection, void *stmt, void *extra);
+
+    static void recordRow(Connection &connection, sqlite3_stmt *stmt);
+
+    void recordExecution(Connection &connection, sqlite3_stmt *stmt, int64_t timeNs);
+};
+}  // namespace Db::Sql
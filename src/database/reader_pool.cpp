@@ -0,0 +1,127 @@
+#include "reader_pool.hpp"
+#include "sqlite_database.hpp"
+#include "sqlite_statement.hpp"
+
+namespace Db::Sql {
+
+/* PRIVATE */ namespace {
+
+// Upper bound of the remembered queries of each class, to avoid to grow indefinitely with the queries built at runtime.
+const size_t maxClassifiedQueries = 256;
+}
+
+ReaderPool::ReaderPool(const Database &writer,
+                       const std::string &dbPath,
+                       const Options &options,
+                       std::shared_ptr<Profiler> profiler) : writer(writer) {
+    auto readerOptions = options;
+    // The journal mode and the page size are persisted in the database file so only the writer can change them.
+    readerOptions.journalMode = stdx::nullopt;
+    readerOptions.pageSize = stdx::nullopt;
+    readerOptions.readerConnections = 0;
+    readerOptions.writerThread = false;
+    // The readers share the profiler of the writer, so the statistics of all the connections are merged.
+    readerOptions.profiling = false;
+    for (size_t i = 0; i < options.readerConnections; i++) {
+        // Every reader is used by a single thread at a time so SQLite doesn't need to serialize the accesses.
+        readers.push_back(std::make_unique<Database>(dbPath,
+                                                     SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX,
+                                                     readerOptions));
+        if (profiler) {
+            readers.back()->profiler = profiler;
+            profiler->install(readers.back()->db);
+        }
+        idleReaders.push_back(readers.back().get());
+    }
+}
+
+// The readers can be destroyed only when the pool is destroyed since they are owned by it.
+ReaderPool::~ReaderPool() = default;
+
+std::shared_ptr<Db::Statement> ReaderPool::createStatement(const std::string &sql) {
+    bool classified;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (writeQueries.find(sql) != writeQueries.end()) {
+            return nullptr;
+        }
+        classified = readQueries.find(sql) != readQueries.end();
+    }
+    if (!classified) {
+        // The statement is prepared on the writer before leasing a reader, so a write doesn't wait for the readers.
+        // It goes back to the cache of the writer, which executes it if it writes.
+        auto writerStmt = writer.prepare(sql);
+        // The transaction control statements (e.g. BEGIN) are read-only too, but they don't return any column.
+        auto readOnly = sqlite3_stmt_readonly(writerStmt) && sqlite3_column_count(writerStmt) > 0;
+        classify(sql, readOnly);
+        if (!readOnly) {
+            return nullptr;
+        }
+    }
+    auto reader = lease();
+    return std::make_shared<Statement>(reader->db, reader->prepare(sql), reader);
+}
+
+ReaderPool::Stats ReaderPool::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters;
+}
+
+BusyHandler::Stats ReaderPool::busyStats() const {
+    auto stats = BusyHandler::Stats{};
+    for (const auto &reader : readers) {
+        stats += reader->busyStats();
+    }
+    return stats;
+}
+
+size_t ReaderPool::size() const {
+    return readers.size();
+}
+
+void ReaderPool::classify(const std::string &sql, bool readOnly) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto &queries = readOnly ? readQueries : writeQueries;
+    if (queries.size() >= maxClassifiedQueries) {
+        queries.clear();
+    }
+    queries.insert(sql);
+}
+
+std::shared_ptr<Database> ReaderPool::lease() {
+    auto thread = std::this_thread::get_id();
+    std::unique_lock<std::mutex> lock(mutex);
+    auto leased = leasedReaders.find(thread);
+    if (leased != leasedReaders.end()) {
+        auto reader = leased->second.lock();
+        if (reader) {
+            // The thread still owns a statement or a cursor created on this reader.
+            return reader;
+        }
+    }
+    if (idleReaders.empty()) {
+        counters.waits++;
+        readerReleased.wait(lock, [this] { return !idleReaders.empty(); });
+    }
+    counters.leases++;
+    auto reader = std::shared_ptr<Database>(idleReaders.back(), [this, thread](Database *released) {
+        release(released, thread);
+    });
+    idleReaders.pop_back();
+    leasedReaders[thread] = reader;
+    return reader;
+}
+
+void ReaderPool::release(Database *reader, std::thread::id thread) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto leased = leasedReaders.find(thread);
+        // The thread could have already leased another reader if this one expired before reaching this point.
+        if (leased != leasedReaders.end() && leased->second.expired()) {
+            leasedReaders.erase(leased);
+        }
+        idleReaders.push_back(reader);
+    }
+    readerReleased.notify_one();
+}
+}  // namespace Db::Sql
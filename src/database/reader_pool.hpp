@@ -0,0 +1,96 @@
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "core/include_macros.hpp"
+#include AMALGAMATION(database_options.hpp)
+#include AMALGAMATION(database_statement.hpp)
+#include "busy_handler.hpp"
+#include "profiler.hpp"
+
+namespace Db::Sql {
+
+class Database;
+
+/**
+ * Pool of read-only connections to the same database file, used to run the queries which don't write concurrently
+ * with the writer connection and with each other.
+ * A connection is leased by a thread until all the statements and cursors created on it are released, and the same
+ * thread reuses its leased connection for the following queries, so it can't deadlock waiting for itself.
+ * The queries are classified preparing them on the writer connection, so a query which writes never waits for a
+ * reader.
+ */
+class ReaderPool {
+   public:
+    /**
+     * The counters collected by the pool since its creation.
+     */
+    struct Stats {
+        // Number of times a connection was taken from the idle ones.
+        unsigned long leases;
+        // Number of times a thread had to wait because all the connections were leased.
+        unsigned long waits;
+    };
+
+    /**
+     * The main constructor.
+     * Opens options.readerConnections read-only connections to the given database, which must already exist.
+     *
+     * @param writer the writer connection, which must outlive the pool, used to classify the queries.
+     * @param dbPath the path of the database file.
+     * @param options the tuning applied to every reader, excluding the options which can be changed only by a writer.
+     * @param profiler the profiler of the writer, shared by the readers, or nullptr if they shouldn't be profiled.
+     */
+    ReaderPool(const Database &writer,
+               const std::string &dbPath,
+               const Options &options,
+               std::shared_ptr<Profiler> profiler = nullptr);
+
+    ~ReaderPool();
+
+    /**
+     * Creates a statement on one of the readers if the given query returns rows without writing.
+     *
+     * @param sql the query used to create the statement.
+     * @return the statement, owning the leased reader, or nullptr if the query should run on the writer.
+     */
+    std::shared_ptr<Db::Statement> createStatement(const std::string &sql);
+
+    [[nodiscard]] Stats stats() const;
+
+    /**
+     * Gets the sum of the busy counters of all the readers.
+     */
+    [[nodiscard]] BusyHandler::Stats busyStats() const;
+
+    [[nodiscard]] size_t size() const;
+
+   private:
+    const Database &writer;
+    std::vector<std::unique_ptr<Database>> readers;
+    std::vector<Database *> idleReaders;
+    // The reader currently leased by each thread, if any.
+    std::unordered_map<std::thread::id, std::weak_ptr<Database>> leasedReaders;
+    // The queries already classified, so they aren't prepared on the writer again.
+    std::unordered_set<std::string> readQueries;
+    std::unordered_set<std::string> writeQueries;
+    mutable std::mutex mutex;
+    std::condition_variable readerReleased;
+    Stats counters{};
+
+    /**
+     * Remembers the class of a query, keeping a bounded number of queries for each class.
+     */
+    void classify(const std::string &sql, bool readOnly);
+
+    std::shared_ptr<Database> lease();
+
+    void release(Database *reader, std::thread::id thread);
+};
+}  // namespace Db::Sql
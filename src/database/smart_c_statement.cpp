@@ -17,19 +17,20 @@ SmartCStatement::SmartCStatement(sqlite3 *db, const std::string &query) :
         THROW(Db::Sql::Exception("Can't generate any statement from the query \"" + query + "\"."));
     }
     // The reference count is 1 since we have to count the object which created this statement.
-    refCount = new unsigned int(1);
+    refCount = new std::atomic<unsigned int>(1);
 }
 
 SmartCStatement::SmartCStatement(const SmartCStatement &other) :
     originalStmt(other.originalStmt),
     refCount(other.refCount) {
     // Increment the reference counter of the sqlite3_stmt since it has been copied somewhere else.
-    ++(*refCount);
+    refCount->fetch_add(1, std::memory_order_relaxed);
 }
 
 SmartCStatement::~SmartCStatement() {
     // Since "refCount" is initialized in the constructor, dereferencing it without checking is safe.
-    if (--(*refCount) == 0) {
+    // The release-acquire ordering makes the uses of the statement by the other owners happen before it's finalized.
+    if (refCount->fetch_sub(1, std::memory_order_acq_rel) == 1) {
         // If the count reaches zero, finalize the sqlite3_stmt, as it's not owned by someone anymore.
         // Since we are in the destructor, there's no need to check the result code of this API because it won't be used.
         sqlite3_finalize(originalStmt);
@@ -48,7 +49,7 @@ SmartCStatement::~SmartCStatement() {
 unsigned int SmartCStatement::useCount() {
     // We don't need to check the validity of the pointer since this method requires a valid instance of SmartCStatement
     // to be invoked and if SmartCStatement is initialized then refCount is initialized too.
-    return *refCount;
+    return refCount->load(std::memory_order_acquire);
 }
 
 SmartCStatement::operator sqlite3_stmt *() const {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 #include "sqlite3/sqlite3.h"
 
@@ -52,7 +53,8 @@ class SmartCStatement {
     // Points to the heap allocated reference counter of the sqlite3_stmt.
     // It's used to make the owning object to live longer than the object which originally created it.
     // e.g. The Db::Sql::Cursor should live longer than the Db::Sql::Statement which created it.
-    unsigned int *refCount;
+    // It's atomic since the copies of a cached statement are created and destroyed by different threads.
+    std::atomic<unsigned int> *refCount;
 
     // The forbidden assignment operator.
     // Making it private avoids any assignments.
@@ -1,15 +1,28 @@
+#include <vector>
 #include "sqlite_cursor.hpp"
 #include "sqlite_exception.hpp"
 #include "core/exception_macros.hpp"
 
 namespace Db::Sql {
 
-Cursor::Cursor(sqlite3 *db, const SmartCStatement &stmt) : db(db), stmt(stmt) {
+Cursor::Cursor(sqlite3 *db,
+               const SmartCStatement &stmt,
+               std::shared_ptr<void> connectionLease,
+               std::shared_ptr<ConnectionLock> connectionLock) :
+    db(db),
+    connectionLease(std::move(connectionLease)),
+    stmt(stmt),
+    connectionLock(std::move(connectionLock)) {
     columnCount = sqlite3_column_count(stmt);
     hadNext = false;
 }
 
 bool Cursor::next() {
+    // The lock is held only while stepping, so the transactions of other threads can run between the rows.
+    std::unique_lock<std::mutex> lock;
+    if (connectionLock) {
+        lock = connectionLock->acquire();
+    }
     int rc = sqlite3_step(stmt);
     if (rc == SQLITE_DONE) {
         if (clearBindings() != SQLITE_OK || reset() != SQLITE_OK) {
@@ -54,6 +67,19 @@ int Cursor::getInt(int colIndex) {
     return sqlite3_column_int(stmt, colIndex);
 }
 
+long long Cursor::getInt64(int colIndex) {
+    int columnType = sqlite3_column_type(stmt, colIndex);
+    if (columnType != SQLITE_INTEGER) {
+        THROW(Db::Sql::Exception("The column at index " +
+            std::to_string(colIndex) +
+            " should be of type " +
+            std::to_string(SQLITE_INTEGER) +
+            " instead of " +
+            std::to_string(columnType)));
+    }
+    return sqlite3_column_int64(stmt, colIndex);
+}
+
 double Cursor::getDouble(int colIndex) {
     int columnType = sqlite3_column_type(stmt, colIndex);
     if (columnType != SQLITE_FLOAT) {
@@ -68,6 +94,10 @@ double Cursor::getDouble(int colIndex) {
 }
 
 std::string Cursor::getString(int colIndex) {
+    return std::string(getStringView(colIndex));
+}
+
+stdx::string_view Cursor::getStringView(int colIndex) {
     int columnType = sqlite3_column_type(stmt, colIndex);
     if (columnType != SQLITE_TEXT) {
         THROW(Db::Sql::Exception("The column at index " +
@@ -77,13 +107,44 @@ std::string Cursor::getString(int colIndex) {
             " instead of " +
             std::to_string(columnType)));
     }
+    // The text must be read before its size, otherwise the size could refer to a different encoding.
     auto text = sqlite3_column_text(stmt, colIndex);
-    return std::string(reinterpret_cast<const char *>(text));
+    auto size = sqlite3_column_bytes(stmt, colIndex);
+    return stdx::string_view(reinterpret_cast<const char *>(text), static_cast<size_t>(size));
 }
 
 bool Cursor::getBool(int colIndex) {
     return getInt(colIndex) != 0;
 }
+
+void Cursor::readRows(const ColumnType *types, int count, RowReader reader, const void *consumer) {
+    std::vector<Value> values(static_cast<size_t>(count));
+    // The qualified call avoids the virtual dispatch for every row.
+    while (Cursor::next()) {
+        for (int i = 0; i < count; i++) {
+            // SQLite stores the type with every value, so only the comparison with the expected one is repeated.
+            auto type = static_cast<ColumnType>(sqlite3_column_type(stmt, i));
+            if (type != types[i]) {
+                throwTypeMismatch(i, types[i], type);
+            }
+            auto &value = values[i];
+            if (type == ColumnType::Integer) {
+                value.integer = sqlite3_column_int64(stmt, i);
+            } else if (type == ColumnType::Float) {
+                value.real = sqlite3_column_double(stmt, i);
+            } else {
+                // The text must be read before its size, otherwise the size could refer to a different encoding.
+                value.text = reinterpret_cast<const char *>(sqlite3_column_text(stmt, i));
+                value.size = static_cast<size_t>(sqlite3_column_bytes(stmt, i));
+            }
+        }
+        reader(consumer, values.data());
+    }
+}
+
+int Cursor::getColumnCount() {
+    return columnCount;
+}
 int Cursor::reset() {
     return sqlite3_reset(stmt);
 }
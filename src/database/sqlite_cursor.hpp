@@ -1,8 +1,10 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include "core/include_macros.hpp"
 #include "sqlite3/sqlite3.h"
+#include "connection_lock.hpp"
 #include "smart_c_statement.hpp"
 #include AMALGAMATION(database_cursor.hpp)
 
@@ -10,7 +12,15 @@ namespace Db::Sql {
 
 class Cursor : public Db::Cursor {
    public:
-    Cursor(sqlite3 *db, const SmartCStatement &stmt);
+    /**
+     * @param connectionLease the lease of the connection (e.g. a pooled reader) kept alive by the cursor.
+     * @param connectionLock the lock held while stepping the rows, if the connection is shared with the transactions
+     * of other threads.
+     */
+    Cursor(sqlite3 *db,
+           const SmartCStatement &stmt,
+           std::shared_ptr<void> connectionLease = nullptr,
+           std::shared_ptr<ConnectionLock> connectionLock = nullptr);
 
     bool next() override;
 
@@ -21,19 +31,30 @@ class Cursor : public Db::Cursor {
 
     int getInt(int colIndex) override;
 
+    long long getInt64(int colIndex) override;
+
     double getDouble(int colIndex) override;
 
     std::string getString(int colIndex) override;
 
+    stdx::string_view getStringView(int colIndex) override;
+
     bool getBool(int colIndex) override;
 
+    void readRows(const ColumnType *types, int count, RowReader reader, const void *consumer) override;
+
+    int getColumnCount() override;
+
     virtual int reset();
 
     virtual int clearBindings();
 
    private:
     sqlite3 *db{};
+    // It's declared before the statement so it's released after it.
+    std::shared_ptr<void> connectionLease;
     SmartCStatement stmt;
+    std::shared_ptr<ConnectionLock> connectionLock;
     int columnCount;
     bool hadNext;
 };
@@ -2,42 +2,382 @@
 #include "sqlite_database.hpp"
 #include "sqlite_exception.hpp"
 #include "sqlite_statement.hpp"
+#include "trigram_tokenizer.hpp"
 #include "core/exception_macros.hpp"
 
 namespace Db::Sql {
 
-Database::Database(std::string dbPath, int flags) {
-    auto movedPath = std::move(dbPath);
-    int rc = sqlite3_open_v2(movedPath.c_str(), &db, flags, nullptr);
-    if (rc != SQLITE_OK) {
-        THROW(Db::Sql::Exception(db));
+/* PRIVATE */ namespace {
+
+const char *journalModeName(JournalMode mode) {
+    switch (mode) {
+        case JournalMode::Delete:
+            return "DELETE";
+        case JournalMode::Truncate:
+            return "TRUNCATE";
+        case JournalMode::Persist:
+            return "PERSIST";
+        case JournalMode::Memory:
+            return "MEMORY";
+        case JournalMode::Wal:
+            return "WAL";
+        case JournalMode::Off:
+            return "OFF";
+    }
+    return "DELETE"; // LCOV_EXCL_LINE
+}
+
+const char *synchronousName(Synchronous synchronous) {
+    switch (synchronous) {
+        case Synchronous::Off:
+            return "OFF";
+        case Synchronous::Normal:
+            return "NORMAL";
+        case Synchronous::Full:
+            return "FULL";
+        case Synchronous::Extra:
+            return "EXTRA";
+    }
+    return "FULL"; // LCOV_EXCL_LINE
+}
+
+const char *tempStoreName(TempStore tempStore) {
+    switch (tempStore) {
+        case TempStore::Default:
+            return "DEFAULT";
+        case TempStore::File:
+            return "FILE";
+        case TempStore::Memory:
+            return "MEMORY";
+    }
+    return "DEFAULT"; // LCOV_EXCL_LINE
+}
+
+const char *beginStatement(TransactionMode mode) {
+    switch (mode) {
+        case TransactionMode::Deferred:
+            return "BEGIN DEFERRED TRANSACTION";
+        case TransactionMode::Immediate:
+            return "BEGIN IMMEDIATE TRANSACTION";
+        case TransactionMode::Exclusive:
+            return "BEGIN EXCLUSIVE TRANSACTION";
+    }
+    return "BEGIN TRANSACTION"; // LCOV_EXCL_LINE
+}
+
+/**
+ * Marks the current thread as the one executing the transaction and counts the nesting level, until this object is
+ * destroyed.
+ */
+class TransactionScope {
+   public:
+    TransactionScope(std::atomic<std::thread::id> &transactionThread, int &transactionDepth) :
+        transactionThread(transactionThread),
+        transactionDepth(transactionDepth) {
+        if (transactionDepth++ == 0) {
+            transactionThread = std::this_thread::get_id();
+        }
+    }
+
+    ~TransactionScope() {
+        if (--transactionDepth == 0) {
+            transactionThread = std::thread::id();
+        }
+    }
+
+   private:
+    std::atomic<std::thread::id> &transactionThread;
+    int &transactionDepth;
+};
+}
+
+Database::Database(std::string dbPath, int flags, const Options &options) :
+    busyHandler(options.busyPolicy),
+    changeTracker(std::make_shared<ChangeTracker>()),
+    db(open(dbPath, flags, options)),
+    statementCache(db, options.statementCacheCapacity),
+    connectionLock(std::make_shared<ConnectionLock>(transactionMutex, transactionThread)) {
+    // The handler is installed first since e.g. switching to the WAL journal mode needs an exclusive lock.
+    busyHandler.install(db);
+    // The tokenizer must be registered on every connection reading or writing the tables which use it.
+    TrigramTokenizer::install(db);
+    changeTracker->install(db);
+    if (options.profiling) {
+        profiler = std::make_shared<Profiler>();
+        profiler->install(db);
+    }
+    applyOptions(options);
+    if (options.readerConnections > 0) {
+        ensureWalJournalMode();
+        // The readers are opened after the writer, which creates the database file if needed.
+        readerPool = std::make_unique<ReaderPool>(*this, dbPath, options, profiler);
+    }
+    if (options.writerThread) {
+        writeExecutor = std::make_unique<WriteExecutor>(*this, options.maxGroupedTransactions);
     }
-    std::cout << "Opened database successfully" << std::endl;
 }
 
 Database::~Database() {
+    // The queued transactions are executed before closing the connections.
+    writeExecutor = nullptr;
+    // The readers must be closed before the writer, since the last connection checkpoints the WAL file.
+    readerPool = nullptr;
+    // The cached statements must be finalized before closing the database, otherwise it can't be closed.
+    statementCache.clear();
     sqlite3_close(db);
     std::cout << "Database closed" << std::endl;
 }
 
-void Database::executeTransaction(std::function<void()> transact) const {
+void Database::executeTransaction(std::function<void()> transact, TransactionMode mode) const {
     auto transaction = std::move(transact);
-    int rc = sqlite3_exec(db, "BEGIN TRANSACTION", nullptr, nullptr, nullptr);
+    bool nested = isInTransaction();
+#ifdef EXCEPTIONS_ENABLED
+    // A nested transaction can't be retried alone since its locks are held by the outermost one.
+    if (!nested) {
+        for (int attempt = 1;; attempt++) {
+            try {
+                runTransaction(transaction, mode, nested);
+                return;
+            } catch (const Db::Sql::Exception &e) {
+                // The transaction was already rolled back so it can be executed again from the beginning.
+                if (!e.isBusy() || !busyHandler.awaitTransactionRetry(attempt)) {
+                    throw;
+                }
+            }
+        }
+    }
+#endif
+    runTransaction(transaction, mode, nested);
+}
+
+std::future<void> Database::submitTransaction(std::function<void()> transact) const {
+    if (writeExecutor) {
+        return writeExecutor->submit(std::move(transact));
+    }
+    std::promise<void> promise;
+#ifdef EXCEPTIONS_ENABLED
+    try {
+#endif
+        executeTransaction(std::move(transact));
+        promise.set_value();
+#ifdef EXCEPTIONS_ENABLED
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+    }
+#endif
+    return promise.get_future();
+}
+
+void Database::executeGroupedTransaction(std::function<void()> transact, TransactionMode mode) const {
+    if (!writeExecutor || isInTransaction()) {
+        executeTransaction(std::move(transact), mode);
+        return;
+    }
+    writeExecutor->submit(std::move(transact)).get();
+}
+
+std::shared_ptr<Db::Statement> Database::createStatement(std::string sql) const {
+    auto movedSql = std::move(sql);
+    if (readerPool && transactionThread != std::this_thread::get_id()) {
+        auto readStmt = readerPool->createStatement(movedSql);
+        if (readStmt) {
+            return readStmt;
+        }
+    }
+    return std::make_shared<Statement>(db, prepare(movedSql), changeTracker, connectionLock);
+}
+
+void Database::executeAfterCommit(std::function<void()> action) const {
+    if (isInTransaction()) {
+        commitActions.push_back(std::move(action));
+        return;
+    }
+    action();
+}
+
+bool Database::isInTransaction() const {
+    // The depth must be read only by the thread executing the transaction.
+    return transactionThread == std::this_thread::get_id() && transactionDepth > 0;
+}
+
+int Database::addChangeListener(ChangeTracker::Listener listener) const {
+    return changeTracker->addListener(std::move(listener));
+}
+
+void Database::removeChangeListener(int listenerId) const {
+    changeTracker->removeListener(listenerId);
+}
+
+long long Database::dataVersion() const {
+    // The pragma only reads a counter of the connection, so it can run while another thread is in a transaction.
+    auto stmt = prepare("PRAGMA data_version");
+    if (sqlite3_step(stmt) != SQLITE_ROW) {
+        auto exception = Db::Sql::Exception(db);
+        sqlite3_reset(stmt);
+        THROW(exception);
+    }
+    auto version = sqlite3_column_int64(stmt, 0);
+    sqlite3_reset(stmt);
+    return version;
+}
+
+StatementCache::Stats Database::statementCacheStats() const {
+    return statementCache.stats();
+}
+
+ReaderPool::Stats Database::readerPoolStats() const {
+    if (!readerPool) {
+        return ReaderPool::Stats{};
+    }
+    return readerPool->stats();
+}
+
+BusyHandler::Stats Database::busyStats() const {
+    auto stats = busyHandler.stats();
+    if (readerPool) {
+        stats += readerPool->busyStats();
+    }
+    return stats;
+}
+
+WriteExecutor::Stats Database::writeExecutorStats() const {
+    if (!writeExecutor) {
+        return WriteExecutor::Stats{};
+    }
+    return writeExecutor->stats();
+}
+
+std::shared_ptr<Profiler> Database::getProfiler() const {
+    return profiler;
+}
+
+sqlite3 *Database::open(const std::string &dbPath, int flags, const Options &options) {
+    sqlite3 *db;
+    if (options.uri) {
+        flags |= SQLITE_OPEN_URI;
+    }
+    int rc = sqlite3_open_v2(dbPath.c_str(), &db, flags, nullptr);
+    if (rc != SQLITE_OK) {
+        THROW(Db::Sql::Exception(db));
+    }
+    std::cout << "Opened database successfully" << std::endl;
+    return db;
+}
+
+void Database::applyOptions(const Options &options) {
+    std::string pragmas;
+    // The page size must be changed before the journal mode since it can't be changed anymore in WAL mode.
+    if (options.pageSize) {
+        pragmas += "PRAGMA page_size = " + std::to_string(*options.pageSize) + ";";
+    }
+    if (options.journalMode) {
+        pragmas += "PRAGMA journal_mode = " + std::string(journalModeName(*options.journalMode)) + ";";
+    }
+    if (options.synchronous) {
+        pragmas += "PRAGMA synchronous = " + std::string(synchronousName(*options.synchronous)) + ";";
+    }
+    if (options.cacheSize) {
+        pragmas += "PRAGMA cache_size = " + std::to_string(*options.cacheSize) + ";";
+    }
+    if (options.mmapSize) {
+        pragmas += "PRAGMA mmap_size = " + std::to_string(*options.mmapSize) + ";";
+    }
+    if (options.tempStore) {
+        pragmas += "PRAGMA temp_store = " + std::string(tempStoreName(*options.tempStore)) + ";";
+    }
+    if (pragmas.empty()) {
+        return;
+    }
+    int rc = sqlite3_exec(db, pragmas.c_str(), nullptr, nullptr, nullptr);
     if (rc != SQLITE_OK) {
         THROW(Db::Sql::Exception(db));
     }
+}
+
+void Database::ensureWalJournalMode() const {
+    // e.g. an in-memory database can't be shared with other connections so it can't be switched to WAL.
+    auto journalMode = Statement(db, prepare("PRAGMA journal_mode")).execute<stdx::optional<std::string>>();
+    if (journalMode != std::string("wal")) {
+        THROW(Db::Sql::Exception("The reader connections require the WAL journal mode instead of \"" +
+            journalMode.value_or("") + "\"."));
+    }
+}
 
-    // Execute the transaction.
-    transaction();
+void Database::runTransaction(const std::function<void()> &transaction, TransactionMode mode, bool nested) const {
+    // The savepoints are named after their depth, so the name of the innermost one is always known.
+    auto savepoint = "transaction_" + std::to_string(transactionDepth);
+    auto begin = nested ? "SAVEPOINT " + savepoint : std::string(beginStatement(mode));
+    auto commit = nested ? "RELEASE " + savepoint : std::string("COMMIT TRANSACTION");
+    // Rolling back to a savepoint doesn't remove it so it must be released too.
+    auto rollbackSql = nested ? "ROLLBACK TO " + savepoint + "; RELEASE " + savepoint : std::string("ROLLBACK");
 
-    rc = sqlite3_exec(db, "END TRANSACTION", nullptr, nullptr, nullptr);
+    std::unique_lock<std::mutex> outermostLock(transactionMutex, std::defer_lock);
+    if (!nested) {
+        outermostLock.lock();
+    }
+    execute(begin);
+    // SQLite doesn't notify the rollback of a savepoint, so its changes are discarded starting from here.
+    auto changesMark = changeTracker->mark();
+    auto actionsMark = commitActions.size();
+    {
+        auto transactionScope = TransactionScope(transactionThread, transactionDepth);
+#ifdef EXCEPTIONS_ENABLED
+        try {
+#endif
+            // Execute the transaction.
+            transaction();
+#ifdef EXCEPTIONS_ENABLED
+        } catch (...) {
+            rollback(rollbackSql);
+            if (nested) {
+                changeTracker->rollbackTo(changesMark);
+            }
+            commitActions.resize(actionsMark);
+            throw;
+        }
+#endif
+
+        int rc = sqlite3_exec(db, commit.c_str(), nullptr, nullptr, nullptr);
+        if (rc != SQLITE_OK) {
+            auto exception = Db::Sql::Exception(db);
+            // e.g. when the commit is busy, the transaction is still open and it must be closed anyway.
+            rollback(rollbackSql);
+            if (nested) {
+                changeTracker->rollbackTo(changesMark);
+            }
+            commitActions.resize(actionsMark);
+            THROW(exception);
+        }
+    }
+    if (!nested) {
+        std::vector<std::function<void()>> actions;
+        actions.swap(commitActions);
+        // The listeners are notified outside the transaction scope, so their queries can use the readers.
+        outermostLock.unlock();
+        for (const auto &action : actions) {
+            action();
+        }
+        changeTracker->dispatch();
+    }
+}
+
+void Database::execute(const std::string &sql) const {
+    int rc = sqlite3_exec(db, sql.c_str(), nullptr, nullptr, nullptr);
     if (rc != SQLITE_OK) {
         THROW(Db::Sql::Exception(db));
     }
 }
 
-std::shared_ptr<Db::Statement> Database::createStatement(std::string sql) const {
-    auto movedSql = std::move(sql);
-    return std::make_shared<Statement>(db, movedSql);
+void Database::rollback(const std::string &sql) const {
+    // SQLite could have already rolled back the whole transaction after some errors (e.g. SQLITE_FULL).
+    if (sqlite3_get_autocommit(db)) {
+        return;
+    }
+    // The result is ignored since the original error is more relevant for the caller.
+    sqlite3_exec(db, sql.c_str(), nullptr, nullptr, nullptr);
+}
+
+SmartCStatement Database::prepare(const std::string &sql) const {
+    return statementCache.acquire(sql);
 }
 }
\ No newline at end of file
@@ -1,24 +1,121 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include "core/include_macros.hpp"
 #include "sqlite3/sqlite3.h"
+#include "busy_handler.hpp"
+#include "change_tracker.hpp"
+#include "connection_lock.hpp"
+#include "profiler.hpp"
+#include "reader_pool.hpp"
+#include "statement_cache.hpp"
+#include "write_executor.hpp"
 #include AMALGAMATION(database.hpp)
+#include AMALGAMATION(database_options.hpp)
 #include AMALGAMATION(database_statement.hpp)
 
 namespace Db::Sql {
 
 class Database : public Db::Database {
    public:
-    Database(std::string dbPath, int flags);
+    Database(std::string dbPath, int flags, const Options &options = Options());
 
     ~Database();
 
-    void executeTransaction(std::function<void()> transact) const override;
+    void executeTransaction(std::function<void()> transact,
+                            TransactionMode mode = TransactionMode::Deferred) const override;
+
+    std::future<void> submitTransaction(std::function<void()> transact) const override;
+
+    void executeGroupedTransaction(std::function<void()> transact,
+                                   TransactionMode mode = TransactionMode::Deferred) const override;
 
     [[nodiscard]] std::shared_ptr<Db::Statement> createStatement(std::string sql) const override;
 
+    void executeAfterCommit(std::function<void()> action) const override;
+
+    [[nodiscard]] bool isInTransaction() const override;
+
+    int addChangeListener(ChangeTracker::Listener listener) const override;
+
+    void removeChangeListener(int listenerId) const override;
+
+    [[nodiscard]] long long dataVersion() const override;
+
+    [[nodiscard]] StatementCache::Stats statementCacheStats() const;
+
+    /**
+     * Gets the counters of the pool of the read-only connections.
+     * When Options::readerConnections is 0, there isn't any pool and the counters are always 0.
+     */
+    [[nodiscard]] ReaderPool::Stats readerPoolStats() const;
+
+    /**
+     * Gets the counters of the waits caused by the locks held by other connections, including the ones of the
+     * read-only connections.
+     */
+    [[nodiscard]] BusyHandler::Stats busyStats() const;
+
+    /**
+     * Gets the counters of the writer thread.
+     * When Options::writerThread is false, there isn't any writer thread and the counters are always 0.
+     */
+    [[nodiscard]] WriteExecutor::Stats writeExecutorStats() const;
+
+    /**
+     * Gets the profiler shared by this connection and its read-only connections.
+     *
+     * @return the profiler or nullptr if Options::profiling is false.
+     */
+    [[nodiscard]] std::shared_ptr<Profiler> getProfiler() const;
+
    private:
+    // It's declared before the connection since it must outlive it.
+    mutable BusyHandler busyHandler;
+    // It's declared before the connection since it must outlive it.
+    std::shared_ptr<Profiler> profiler;
+    // It's declared before the connection since it must outlive it. It's shared with the statements of the writer,
+    // which notify the changes after executing outside a transaction.
+    std::shared_ptr<ChangeTracker> changeTracker;
     sqlite3 *db{};
+    // The cache is filled also by the const method createStatement().
+    mutable StatementCache statementCache;
+    // The read-only connections used for the queries outside the transactions, if Options::readerConnections > 0.
+    std::unique_ptr<ReaderPool> readerPool;
+    // The thread which is executing a transaction on this connection, if any.
+    // Its queries must run on this connection to read the changes which aren't committed yet.
+    mutable std::atomic<std::thread::id> transactionThread{std::thread::id()};
+    // The number of nested transactions currently executed, including the outermost one.
+    mutable int transactionDepth = 0;
+    // The actions executed after the current outermost transaction is committed, in the order they were registered.
+    // They are changed only by the thread executing the transaction.
+    mutable std::vector<std::function<void()>> commitActions;
+    // Held during the outermost transactions, since the threads share the same connection.
+    mutable std::mutex transactionMutex;
+    // Held by the statements executed on this connection outside a transaction, shared with them.
+    std::shared_ptr<ConnectionLock> connectionLock;
+    // The thread executing the submitted transactions, if Options::writerThread is true.
+    std::unique_ptr<WriteExecutor> writeExecutor;
+
+    static sqlite3 *open(const std::string &dbPath, int flags, const Options &options);
+
+    void applyOptions(const Options &options);
+
+    void ensureWalJournalMode() const;
+
+    void runTransaction(const std::function<void()> &transaction, TransactionMode mode, bool nested) const;
+
+    void execute(const std::string &sql) const;
+
+    void rollback(const std::string &sql) const;
+
+    [[nodiscard]] SmartCStatement prepare(const std::string &sql) const;
+
+    // The pool prepares the statements directly on its readers.
+    friend class ReaderPool;
 
     // This is a workaround to access the private member sqlite3 *db inside the following tests.
     // GTest creates classes named {test suite}_{test name}_Test.
@@ -3,7 +3,17 @@
 
 namespace Db::Sql {
 
-Exception::Exception(std::string msg) : Db::Exception(std::move(msg)) {}
+Exception::Exception(std::string msg, int resultCode) : Db::Exception(std::move(msg)), resultCode(resultCode) {}
 
-Exception::Exception(sqlite3 *db) : Db::Sql::Exception(sqlite3_errmsg(db)) {}
+Exception::Exception(sqlite3 *db) : Db::Sql::Exception(sqlite3_errmsg(db), sqlite3_extended_errcode(db)) {}
+
+int Exception::getResultCode() const {
+    return resultCode;
+}
+
+bool Exception::isBusy() const {
+    // The primary result code is stored in the least significant byte of the extended one.
+    auto primaryCode = resultCode & 0xff;
+    return primaryCode == SQLITE_BUSY || primaryCode == SQLITE_LOCKED;
+}
 }
\ No newline at end of file
@@ -7,7 +7,21 @@ namespace Db::Sql {
 
 class Exception : public Db::Exception {
    public:
-    explicit Exception(std::string msg);
+    explicit Exception(std::string msg, int resultCode = SQLITE_ERROR);
     explicit Exception(sqlite3 *db);
+
+    /**
+     * Gets the extended SQLite result code which caused this exception.
+     */
+    [[nodiscard]] int getResultCode() const;
+
+    /**
+     * Checks if the operation failed because another connection holds a lock on the database, so it can succeed
+     * when it's executed again later.
+     */
+    [[nodiscard]] bool isBusy() const;
+
+   private:
+    int resultCode;
 };
 }
\ No newline at end of file
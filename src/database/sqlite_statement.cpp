@@ -8,19 +8,51 @@ namespace Db::Sql {
 
 Statement::Statement(sqlite3 *db, std::string sql) : db(db), stmt(db, sql) {}
 
+Statement::Statement(sqlite3 *db, const SmartCStatement &stmt) : db(db), stmt(stmt) {}
+
+Statement::Statement(sqlite3 *db, const SmartCStatement &stmt, std::shared_ptr<void> connectionLease) :
+    db(db),
+    connectionLease(std::move(connectionLease)),
+    stmt(stmt) {}
+
+Statement::Statement(sqlite3 *db,
+                     const SmartCStatement &stmt,
+                     std::shared_ptr<ChangeTracker> changeTracker,
+                     std::shared_ptr<ConnectionLock> connectionLock) :
+    db(db),
+    stmt(stmt),
+    changeTracker(std::move(changeTracker)),
+    connectionLock(std::move(connectionLock)) {}
+
+long long Statement::lastInsertRowId() const {
+    return insertedRowId;
+}
+
+int Statement::changes() const {
+    return changedRows;
+}
+
 void Statement::executeVoid() {
-    if (sqlite3_step(stmt) != SQLITE_DONE) {
-        THROW(Db::Sql::Exception(db));
-    }
-    if (clearBindings() != SQLITE_OK || reset() != SQLITE_OK) {
-        THROW(Db::Sql::Exception(db));
+    {
+        auto lock = lockConnection();
+        if (sqlite3_step(stmt) != SQLITE_DONE) {
+            THROW(Db::Sql::Exception(db));
+        }
+        readChanges();
+        if (clearBindings() != SQLITE_OK || reset() != SQLITE_OK) {
+            THROW(Db::Sql::Exception(db));
+        }
     }
+    // The listeners are notified without holding the lock, so they can use the connection.
+    dispatchChanges();
 }
 
 stdx::optional<int> Statement::executeOptionalInt() {
+    auto lock = lockConnection();
     int status = sqlite3_step(stmt);
     auto result = stdx::optional<int>();
     if (status == SQLITE_DONE) {
+        readChanges();
         // If there are no rows to read, the value is absent.
         return result;
     }
@@ -39,9 +71,12 @@ stdx::optional<int> Statement::executeOptionalInt() {
     if (sqlite3_step(stmt) != SQLITE_DONE) {
         THROW(Db::Sql::Exception(db));
     }
+    readChanges();
     if (clearBindings() != SQLITE_OK || reset() != SQLITE_OK) {
         THROW(Db::Sql::Exception(db));
     }
+    lock = std::unique_lock<std::mutex>();
+    dispatchChanges();
     return result;
 }
 
@@ -54,9 +89,11 @@ int Statement::executeInt() {
 }
 
 stdx::optional<std::string> Statement::executeOptionalString() {
+    auto lock = lockConnection();
     int status = sqlite3_step(stmt);
     auto result = stdx::optional<std::string>();
     if (status == SQLITE_DONE) {
+        readChanges();
         // If there are no rows to read, the value is absent.
         return result;
     }
@@ -76,14 +113,85 @@ stdx::optional<std::string> Statement::executeOptionalString() {
     if (sqlite3_step(stmt) != SQLITE_DONE) {
         THROW(Db::Sql::Exception(db));
     }
+    readChanges();
     if (clearBindings() != SQLITE_OK || reset() != SQLITE_OK) {
         THROW(Db::Sql::Exception(db));
     }
+    lock = std::unique_lock<std::mutex>();
+    dispatchChanges();
     return result;
 } // LCOV_EXCL_BR_LINE
 
+Statement::BatchResult Statement::executeBatchRows(const std::function<bool()> &bindNextRow, BatchMode mode) {
+    // The lock is held until the savepoint is released, so it's never nested in the transaction of another thread.
+    auto lock = lockConnection();
+    // A savepoint begins a transaction when there isn't any, otherwise it's nested in the current one.
+    if (sqlite3_exec(db, "SAVEPOINT batch", nullptr, nullptr, nullptr) != SQLITE_OK) {
+        THROW(Db::Sql::Exception(db));
+    }
+    // SQLite doesn't notify the rollback of a savepoint, so the changes of the batch are discarded starting from here.
+    size_t changesMark = changeTracker ? changeTracker->mark() : 0;
+    auto result = BatchResult{};
+    bool aborted = false;
+    bool transactionLost = false;
+#ifdef EXCEPTIONS_ENABLED
+    try {
+#endif
+        size_t row = 0;
+        while (bindNextRow()) {
+            if (sqlite3_step(stmt) == SQLITE_DONE) {
+                result.executedRows++;
+            } else {
+                // The failed row is rolled back by SQLite while the previous ones are kept, unless the error rolled
+                // back the whole transaction, e.g. SQLITE_FULL or SQLITE_IOERR.
+                result.failures.push_back(BatchFailure{row, sqlite3_errmsg(db)});
+                transactionLost = sqlite3_get_autocommit(db) != 0;
+            }
+            // The result codes are ignored since sqlite3_reset() returns the error of the last step, if any.
+            reset();
+            clearBindings();
+            if (transactionLost || (!result.failures.empty() && mode == BatchMode::AbortOnFailure)) {
+                aborted = true;
+                break;
+            }
+            row++;
+        }
+#ifdef EXCEPTIONS_ENABLED
+    } catch (...) {
+        // e.g. a value which can't be bound.
+        rollbackBatch(changesMark);
+        throw;
+    }
+#endif
+    if (transactionLost) {
+        // The savepoint was rolled back with the transaction, so the following rows would be committed one by one.
+        if (changeTracker) {
+            changeTracker->rollbackTo(changesMark);
+        }
+        auto &failure = result.failures.back();
+        THROW(Db::Sql::Exception("The batch was rolled back since the row " +
+            std::to_string(failure.row) +
+            " failed: " +
+            failure.message));
+    }
+    if (aborted) {
+        rollbackBatch(changesMark);
+        auto &failure = result.failures.back();
+        THROW(Db::Sql::Exception("The row " +
+            std::to_string(failure.row) +
+            " of the batch failed: " +
+            failure.message));
+    }
+    if (sqlite3_exec(db, "RELEASE batch", nullptr, nullptr, nullptr) != SQLITE_OK) {
+        THROW(Db::Sql::Exception(db));
+    }
+    lock = std::unique_lock<std::mutex>();
+    dispatchChanges();
+    return result;
+}
+
 std::shared_ptr<Db::Cursor> Statement::executeCursor() {
-    return std::make_shared<Cursor>(db, stmt);
+    return std::make_shared<Cursor>(db, stmt, connectionLease, connectionLock);
 }
 
 void Statement::bindInt(int colIndex, int value) {
@@ -93,6 +201,13 @@ void Statement::bindInt(int colIndex, int value) {
     }
 }
 
+void Statement::bindInt64(int colIndex, long long value) {
+    int rc = sqlite3_bind_int64(stmt, colIndex, value);
+    if (rc != SQLITE_OK) {
+        THROW(Db::Sql::Exception(db));
+    }
+}
+
 void Statement::bindDouble(int colIndex, double value) {
     int rc = sqlite3_bind_double(stmt, colIndex, value);
     if (rc != SQLITE_OK) {
@@ -113,6 +228,37 @@ void Statement::bindBool(int colIndex, bool value) {
     bindInt(colIndex, intValue);
 }
 
+void Statement::rollbackBatch(size_t changesMark) {
+    // The changes are discarded first since releasing the outermost savepoint commits the remaining ones.
+    if (changeTracker) {
+        changeTracker->rollbackTo(changesMark);
+    }
+    // Rolling back to a savepoint doesn't remove it so it must be released too.
+    sqlite3_exec(db, "ROLLBACK TO batch; RELEASE batch", nullptr, nullptr, nullptr);
+}
+
+std::unique_lock<std::mutex> Statement::lockConnection() const {
+    if (!connectionLock) {
+        return std::unique_lock<std::mutex>();
+    }
+    return connectionLock->acquire();
+}
+
+void Statement::readChanges() {
+    if (sqlite3_stmt_readonly(stmt)) {
+        // The values of the connection belong to the last statement which changed the DB.
+        return;
+    }
+    insertedRowId = sqlite3_last_insert_rowid(db);
+    changedRows = sqlite3_changes(db);
+}
+
+void Statement::dispatchChanges() {
+    if (changeTracker) {
+        changeTracker->dispatch();
+    }
+}
+
 int Statement::reset() {
     return sqlite3_reset(stmt);
 }
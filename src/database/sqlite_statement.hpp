@@ -1,7 +1,10 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include "core/include_macros.hpp"
+#include "change_tracker.hpp"
+#include "connection_lock.hpp"
 #include "smart_c_statement.hpp"
 #include "sqlite3/sqlite3.h"
 #include AMALGAMATION(database_statement.hpp)
@@ -12,6 +15,28 @@ class Statement : public Db::Statement {
    public:
     Statement(sqlite3 *db, std::string sql);
 
+    Statement(sqlite3 *db, const SmartCStatement &stmt);
+
+    /**
+     * Creates a statement which keeps alive the given connection lease (e.g. a pooled reader) until it's destroyed.
+     * The lease is shared with the cursors created by this statement.
+     */
+    Statement(sqlite3 *db, const SmartCStatement &stmt, std::shared_ptr<void> connectionLease);
+
+    /**
+     * Creates a statement which notifies the changes it commits, when it's executed outside a transaction, to the
+     * listeners of the given tracker.
+     * When a lock is given, the statement is executed holding it, unless it's part of the transaction of its thread.
+     */
+    Statement(sqlite3 *db,
+              const SmartCStatement &stmt,
+              std::shared_ptr<ChangeTracker> changeTracker,
+              std::shared_ptr<ConnectionLock> connectionLock = nullptr);
+
+    [[nodiscard]] long long lastInsertRowId() const override;
+
+    [[nodiscard]] int changes() const override;
+
    protected:
     void executeVoid() override;
 
@@ -23,8 +48,12 @@ class Statement : public Db::Statement {
 
     std::shared_ptr<Db::Cursor> executeCursor() override;
 
+    BatchResult executeBatchRows(const std::function<bool()> &bindNextRow, BatchMode mode) override;
+
     void bindInt(int colIndex, int value) override;
 
+    void bindInt64(int colIndex, long long value) override;
+
     void bindDouble(int colIndex, double value) override;
 
     void bindString(int colIndex, std::string value) override;
@@ -37,6 +66,32 @@ class Statement : public Db::Statement {
 
    private:
     sqlite3 *db{};
+    // It's declared before the statement so it's released after it.
+    std::shared_ptr<void> connectionLease;
     SmartCStatement stmt;
+    std::shared_ptr<ChangeTracker> changeTracker;
+    std::shared_ptr<ConnectionLock> connectionLock;
+    long long insertedRowId = 0;
+    int changedRows = 0;
+
+    /**
+     * Reads the changes of the last execution, which must be done before the lock of the connection is released.
+     */
+    void readChanges();
+
+    /**
+     * Locks the connection shared with the other threads, if needed.
+     */
+    [[nodiscard]] std::unique_lock<std::mutex> lockConnection() const;
+
+    /**
+     * Rolls back the rows of the batch, discarding their changes recorded after the given position of the tracker.
+     */
+    void rollbackBatch(size_t changesMark);
+
+    /**
+     * Notifies the committed changes, if the statement has a tracker.
+     */
+    void dispatchChanges();
 };
 }  // namespace Db::Sql
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include "statement_cache.hpp"
+
+namespace Db::Sql {
+
+StatementCache::StatementCache(sqlite3 *db, size_t capacity) : db(db), capacity(capacity) {}
+
+SmartCStatement StatementCache::acquire(const std::string &sql) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto cached = index.find(sql);
+    if (cached != index.end()) {
+        auto entry = cached->second;
+        // The cache is the only owner so no one can step the statement anymore.
+        if (entry->stmt.useCount() == 1) {
+            counters.hits++;
+            // The previous owner could have stopped using the statement before the end of its execution.
+            sqlite3_reset(entry->stmt);
+            sqlite3_clear_bindings(entry->stmt);
+            // Mark it as the most recently used statement.
+            entries.splice(entries.begin(), entries, entry);
+            return entry->stmt;
+        }
+        // The cached statement is still in use (e.g. by a cursor) so a new one is prepared without caching it.
+        counters.misses++;
+        return SmartCStatement(db, sql);
+    }
+
+    counters.misses++;
+    if (capacity == 0) {
+        return SmartCStatement(db, sql);
+    }
+    // Prepare the statement before touching the cache, so an invalid query leaves it unchanged.
+    auto stmt = SmartCStatement(db, sql);
+    auto indexed = index.emplace(sql, entries.end()).first;
+    entries.push_front(Entry{&indexed->first, stmt});
+    indexed->second = entries.begin();
+    if (entries.size() > capacity) {
+        // Evict the least recently used statement.
+        index.erase(*entries.back().sql);
+        entries.pop_back();
+        counters.evictions++;
+    }
+    return stmt;
+}
+
+void StatementCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    index.clear();
+    entries.clear();
+}
+
+StatementCache::Stats StatementCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters;
+}
+
+size_t StatementCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+}  // namespace Db::Sql
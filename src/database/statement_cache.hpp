@@ -0,0 +1,73 @@
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "sqlite3/sqlite3.h"
+#include "smart_c_statement.hpp"
+
+namespace Db::Sql {
+
+/**
+ * Bounded LRU cache of the prepared statements of a single sqlite3 connection, keyed by their SQL text.
+ * A cached statement is handed back only when no one else owns it (e.g. a Db::Sql::Cursor still iterating over it),
+ * otherwise a new uncached statement is prepared for the caller.
+ * It can be used by multiple threads sharing the same connection.
+ */
+class StatementCache {
+   public:
+    /**
+     * The counters collected by the cache since its creation.
+     */
+    struct Stats {
+        // Number of statements returned from the cache without preparing them again.
+        unsigned long hits;
+        // Number of statements prepared because they weren't cached or the cached one was in use.
+        unsigned long misses;
+        // Number of statements removed from the cache to respect its capacity.
+        unsigned long evictions;
+    };
+
+    /**
+     * The main constructor.
+     *
+     * @param db the pointer to the sqlite3 database which prepares the statements.
+     * @param capacity the maximum number of cached statements. When it's 0, the statements aren't cached at all.
+     */
+    StatementCache(sqlite3 *db, size_t capacity);
+
+    /**
+     * Gets a reset statement, without any bound value, prepared from the given query.
+     *
+     * @param sql the query used to create the statement.
+     * @return the cached statement, if available, or a newly prepared statement.
+     */
+    SmartCStatement acquire(const std::string &sql);
+
+    /**
+     * Removes all the cached statements.
+     * The statements which are still owned by someone else are finalized when their last owner releases them.
+     */
+    void clear();
+
+    [[nodiscard]] Stats stats() const;
+
+    [[nodiscard]] size_t size() const;
+
+   private:
+    struct Entry {
+        // Points to the key of the index, which is stable since the index is node-based.
+        const std::string *sql;
+        SmartCStatement stmt;
+    };
+
+    sqlite3 *db;
+    size_t capacity;
+    // The most recently used statements are at the front of the list.
+    std::list<Entry> entries;
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    Stats counters{};
+    mutable std::mutex mutex;
+};
+}  // namespace Db::Sql
@@ -0,0 +1,78 @@
+#include "trigram_tokenizer.hpp"
+
+namespace Db::Sql {
+
+/* PRIVATE */ namespace {
+
+// The tokenizer doesn't have any state, so all the FTS5 tables share the same instance.
+int sharedInstance;
+
+bool isContinuationByte(char c) {
+    return (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+}
+
+fts5_api *fts5Api(sqlite3 *db) {
+    fts5_api *api = nullptr;
+    sqlite3_stmt *stmt = nullptr;
+    // The API is exposed by FTS5 through the pointer passing interface.
+    if (sqlite3_prepare_v2(db, "SELECT fts5(?1)", -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_pointer(stmt, 1, &api, "fts5_api_ptr", nullptr);
+        sqlite3_step(stmt);
+    }
+    sqlite3_finalize(stmt);
+    return api;
+}
+}
+
+const char *const TrigramTokenizer::name = "substring_trigram";
+
+bool TrigramTokenizer::install(sqlite3 *db) {
+    auto api = fts5Api(db);
+    if (api == nullptr) {
+        return false;
+    }
+    fts5_tokenizer tokenizer{&TrigramTokenizer::create, &TrigramTokenizer::destroy, &TrigramTokenizer::tokenize};
+    return api->xCreateTokenizer(api, name, nullptr, &tokenizer, nullptr) == SQLITE_OK;
+}
+
+int TrigramTokenizer::create(void *, const char **, int, Fts5Tokenizer **tokenizer) {
+    *tokenizer = reinterpret_cast<Fts5Tokenizer *>(&sharedInstance);
+    return SQLITE_OK;
+}
+
+void TrigramTokenizer::destroy(Fts5Tokenizer *) {}
+
+int TrigramTokenizer::tokenize(Fts5Tokenizer *,
+                               void *context,
+                               int,
+                               const char *text,
+                               int size,
+                               int (*onToken)(void *, int, const char *, int, int, int)) {
+    // The offsets of the last 4 characters: the trigram goes from the first one to the last one (excluded).
+    int starts[4];
+    int characters = 0;
+    // A trigram contains at most 3 characters of 4 bytes each.
+    char token[12];
+    for (int i = 0; i <= size; i++) {
+        if (i < size && isContinuationByte(text[i])) {
+            continue;
+        }
+        starts[characters % 4] = i;
+        characters++;
+        if (characters < 4) {
+            continue;
+        }
+        auto start = starts[(characters - 4) % 4];
+        int tokenSize = 0;
+        for (int j = start; j < i && tokenSize < static_cast<int>(sizeof(token)); j++) {
+            char c = text[j];
+            token[tokenSize++] = c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+        }
+        int rc = onToken(context, 0, token, tokenSize, start, i);
+        if (rc != SQLITE_OK) {
+            return rc;
+        }
+    }
+    return SQLITE_OK;
+}
+}  // namespace Db::Sql
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "sqlite3/sqlite3.h"
+
+namespace Db::Sql {
+
+/**
+ * FTS5 tokenizer which splits a text in all its overlapping sequences of 3 characters (trigrams), including the
+ * whitespaces and the punctuation, so a phrase query matches any substring of at least 3 characters.
+ * The ASCII letters are folded to lowercase, so the matches have the same case sensitivity of the operator LIKE.
+ * The characters are UTF-8 code points and the offsets of the tokens refer to the original text, so the FTS5
+ * auxiliary functions (e.g. highlight()) can be used too.
+ *
+ * It's used by the FTS5 tables created with the option: tokenize = 'substring_trigram'.
+ */
+class TrigramTokenizer {
+   public:
+    static const char *const name;
+
+    /**
+     * Registers the tokenizer on the given connection, so its FTS5 tables can use it.
+     *
+     * @param db the pointer to the sqlite3 database which should use the tokenizer.
+     * @return true if the tokenizer was registered, false if the connection doesn't support FTS5.
+     */
+    static bool install(sqlite3 *db);
+
+   private:
+    static int create(void *context, const char **args, int argsCount, Fts5Tokenizer **tokenizer);
+
+    static void destroy(Fts5Tokenizer *tokenizer);
+
+    static int tokenize(Fts5Tokenizer *tokenizer,
+                        void *context,
+                        int flags,
+                        const char *text,
+                        int size,
+                        int (*onToken)(void *context, int flags, const char *token, int size, int start, int end));
+};
+}  // namespace Db::Sql
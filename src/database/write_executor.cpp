@@ -0,0 +1,122 @@
+#include "write_executor.hpp"
+#include "sqlite_database.hpp"
+#include "sqlite_exception.hpp"
+#include "core/exception_macros.hpp"
+
+namespace Db::Sql {
+
+WriteExecutor::WriteExecutor(const Database &database, size_t maxGroupSize) :
+    database(database),
+    maxGroupSize(maxGroupSize > 0 ? maxGroupSize : 1),
+    writer(&WriteExecutor::run, this) {}
+
+WriteExecutor::~WriteExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    taskSubmitted.notify_one();
+    writer.join();
+}
+
+std::future<void> WriteExecutor::submit(std::function<void()> transaction) {
+    auto task = Task{std::move(transaction), std::promise<void>()};
+    auto future = task.promise.get_future();
+    queue.push(std::move(task));
+    // Pairs with the fence of the writer: either the writer sees the task or this thread sees the writer idle.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (idle.load(std::memory_order_relaxed)) {
+        // Locking the mutex ensures the writer is already waiting, so the notification isn't lost.
+        { std::lock_guard<std::mutex> lock(mutex); }
+        taskSubmitted.notify_one();
+    }
+    return future;
+}
+
+WriteExecutor::Stats WriteExecutor::stats() const {
+    return Stats{transactions, commits};
+}
+
+void WriteExecutor::run() {
+    std::vector<Task> group;
+    while (true) {
+        // The tasks submitted while the previous group was executed are committed together.
+        Task task;
+        while (group.size() < maxGroupSize && queue.pop(task)) {
+            group.push_back(std::move(task));
+        }
+        if (!group.empty()) {
+            commit(group);
+            group.clear();
+            continue;
+        }
+        // The queued tasks are executed before stopping.
+        if (stopping) {
+            return;
+        }
+        awaitTasks();
+    }
+}
+
+void WriteExecutor::awaitTasks() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    taskSubmitted.wait(lock, [this] { return !queue.empty() || stopping; });
+    idle.store(false, std::memory_order_relaxed);
+}
+
+void WriteExecutor::commit(std::vector<Task> &group) {
+    // They're counted before the futures are ready, so the callers waiting for them see the updated counters.
+    transactions += group.size();
+    commits++;
+    std::vector<std::exception_ptr> failures(group.size());
+#ifdef EXCEPTIONS_ENABLED
+    try {
+#endif
+        database.executeTransaction([this, &group, &failures] {
+            for (size_t i = 0; i < group.size(); i++) {
+                // The failure of a previous attempt is forgotten when the whole group is executed again.
+                failures[i] = nullptr;
+                executeIsolated(group[i], failures[i]);
+            }
+        }, TransactionMode::Immediate);
+#ifdef EXCEPTIONS_ENABLED
+    } catch (...) {
+        // None of the transactions of the group was committed.
+        auto failure = std::current_exception();
+        for (auto &task : group) {
+            task.promise.set_exception(failure);
+        }
+        return;
+    }
+#endif
+    for (size_t i = 0; i < group.size(); i++) {
+        if (failures[i]) {
+            group[i].promise.set_exception(failures[i]);
+        } else {
+            group[i].promise.set_value();
+        }
+    }
+}
+
+void WriteExecutor::executeIsolated(Task &task, std::exception_ptr &failure) {
+#ifdef EXCEPTIONS_ENABLED
+    try {
+#endif
+        database.executeTransaction(task.transaction);
+#ifdef EXCEPTIONS_ENABLED
+    } catch (const Db::Sql::Exception &e) {
+        // The lock is held by the whole group, so the group must be executed again.
+        if (e.isBusy()) {
+            throw;
+        }
+        failure = std::current_exception();
+    } catch (...) {
+        failure = std::current_exception();
+    }
+#else
+    (void) failure;
+#endif
+}
+}  // namespace Db::Sql
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "core/mpsc_queue.hpp"
+
+namespace Db::Sql {
+
+class Database;
+
+/**
+ * Executes the submitted transactions on a dedicated writer thread, so the callers don't wait for the commits.
+ * The transactions submitted while the writer is busy are executed together in a single outermost transaction,
+ * so they share the cost of the commit (group commit). Each of them runs in its own nested transaction, so a failing
+ * one is rolled back without affecting the others of its group.
+ */
+class WriteExecutor {
+   public:
+    /**
+     * The counters collected by the executor since its creation.
+     */
+    struct Stats {
+        // Number of transactions executed, including the failed ones.
+        unsigned long transactions;
+        // Number of outermost transactions used to execute them.
+        unsigned long commits;
+    };
+
+    /**
+     * The main constructor, which starts the writer thread.
+     *
+     * @param database the database in which the transactions are executed.
+     * @param maxGroupSize the maximum number of transactions committed together.
+     */
+    WriteExecutor(const Database &database, size_t maxGroupSize);
+
+    /**
+     * Executes the transactions which are still queued and stops the writer thread.
+     */
+    ~WriteExecutor();
+
+    /**
+     * Queues the given transaction. It can be invoked by any thread, without blocking it.
+     *
+     * @param transaction the function executed in the transaction.
+     * @return the future which is ready when the transaction is committed or holds the exception which caused its
+     * failure.
+     */
+    std::future<void> submit(std::function<void()> transaction);
+
+    [[nodiscard]] Stats stats() const;
+
+   private:
+    struct Task {
+        std::function<void()> transaction;
+        std::promise<void> promise;
+    };
+
+    const Database &database;
+    size_t maxGroupSize;
+    MpscQueue<Task> queue;
+    // Set by the writer before waiting, so the producers know when it must be notified.
+    std::atomic<bool> idle{false};
+    std::atomic<bool> stopping{false};
+    std::mutex mutex;
+    std::condition_variable taskSubmitted;
+    std::atomic<unsigned long> transactions{0};
+    std::atomic<unsigned long> commits{0};
+    // It's declared last so it starts when all the other members are initialized.
+    std::thread writer;
+
+    void run();
+
+    void awaitTasks();
+
+    void commit(std::vector<Task> &group);
+
+    void executeIsolated(Task &task, std::exception_ptr &failure);
+};
+}  // namespace Db::Sql
@@ -0,0 +1,142 @@
+#include <algorithm>
+#include "draft_flusher.hpp"
+#include "core/exception_macros.hpp"
+
+double DraftFlusher::Stats::coalescingRatio() const {
+    if (writtenDrafts == 0) {
+        return 0;
+    }
+    return static_cast<double>(updates) / static_cast<double>(writtenDrafts);
+}
+
+DraftFlusher::DraftFlusher(const DraftFlushPolicy &policy, std::function<size_t()> flush) :
+    policy(policy),
+    flushFunction(std::move(flush)),
+    worker(&DraftFlusher::run, this) {}
+
+DraftFlusher::~DraftFlusher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    changed.notify_one();
+    worker.join();
+}
+
+void DraftFlusher::markDirty(size_t bytes) {
+    bool wakeUp;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // The idle worker waits without a deadline, so it's woken up to start the debounce.
+        wakeUp = !dirty;
+        dirty = true;
+        dirtyBytes += bytes;
+        lastUpdate = std::chrono::steady_clock::now();
+        counters.updates++;
+        wakeUp = wakeUp || dirtyBytes >= policy.dirtyBytesThreshold;
+    }
+    // The worker waiting for the debounce doesn't need to be woken up, since it waits again from the last update.
+    if (wakeUp) {
+        changed.notify_one();
+    }
+}
+
+void DraftFlusher::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    auto flushId = ++requestedFlushes;
+    changed.notify_one();
+    flushed.wait(lock, [this, flushId] { return completedFlushes >= flushId; });
+#ifdef EXCEPTIONS_ENABLED
+    if (flushError && flushId >= firstFailedFlush && flushId <= lastFailedFlush) {
+        // The caller is told that its changes weren't written, like when they are written without a flusher.
+        std::rethrow_exception(flushError);
+    }
+#endif
+}
+
+DraftFlusher::Stats DraftFlusher::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters;
+}
+
+void DraftFlusher::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        if (requestedFlushes > completedFlushes || dirtyBytes >= policy.dirtyBytesThreshold) {
+            flushLocked(lock);
+            continue;
+        }
+        if (stopping) {
+            // The last changes are written before stopping, including the ones of a failed flush.
+            if (dirty || retryPending) {
+                flushLocked(lock);
+            }
+            return;
+        }
+        if (!dirty) {
+            changed.wait(lock);
+            continue;
+        }
+        auto deadline = lastUpdate + policy.debounce;
+        if (std::chrono::steady_clock::now() >= deadline) {
+            flushLocked(lock);
+            continue;
+        }
+        // The deadline is computed again after waking up, since the drafts could have been changed in the meantime.
+        changed.wait_until(lock, deadline);
+    }
+}
+
+void DraftFlusher::flushLocked(std::unique_lock<std::mutex> &lock) {
+    // The changes notified from now on will be written by the next flush.
+    dirty = false;
+    dirtyBytes = 0;
+    auto failedBefore = retryPending;
+    retryPending = false;
+    auto firstFlushId = completedFlushes + 1;
+    auto flushId = requestedFlushes;
+    lock.unlock();
+
+    auto start = std::chrono::steady_clock::now();
+    size_t writtenDrafts = 0;
+    std::exception_ptr error;
+    std::string failure;
+#ifdef EXCEPTIONS_ENABLED
+    try {
+#endif
+        writtenDrafts = flushFunction();
+#ifdef EXCEPTIONS_ENABLED
+    } catch (const std::exception &exception) {
+        // The flush function keeps the drafts which weren't written, so they are written by the next flush.
+        error = std::current_exception();
+        failure = exception.what();
+    } catch (...) {
+        error = std::current_exception();
+        failure = "unknown error";
+    }
+#endif
+    auto flushTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    lock.lock();
+    counters.flushes++;
+    counters.writtenDrafts += writtenDrafts;
+    counters.totalFlushTime += flushTime;
+    counters.maxFlushTime = std::max(counters.maxFlushTime, flushTime);
+    if (error) {
+        if (!failedBefore || failure != lastFailure) {
+            // The same error thrown again, like the one of an incomplete draft, is counted once.
+            counters.failures++;
+        }
+        // The drafts which weren't written are retried with the next changes, so the same error isn't repeated in
+        // a loop.
+        retryPending = true;
+        if (flushId >= firstFlushId) {
+            flushError = error;
+            firstFailedFlush = firstFlushId;
+            lastFailedFlush = flushId;
+        }
+        lastFailure = failure;
+    }
+    completedFlushes = flushId;
+    flushed.notify_all();
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "core/include_macros.hpp"
+#include AMALGAMATION(draft_flush_policy.hpp)
+
+/**
+ * Invokes a flush function on a background thread after the drafts are changed, following a DraftFlushPolicy.
+ * The changes notified while the thread waits for the debounce are written together by the same flush.
+ */
+class DraftFlusher {
+   public:
+    /**
+     * The counters collected by the flusher since its creation.
+     */
+    struct Stats {
+        // Number of changes of the drafts notified with markDirty().
+        unsigned long updates;
+        // Number of invocations of the flush function, including the failed ones.
+        unsigned long flushes;
+        // Number of invocations of the flush function which threw an exception, counting once the same error thrown by
+        // consecutive invocations.
+        unsigned long failures;
+        // Number of drafts written by the flush function.
+        unsigned long writtenDrafts;
+        // The total and the maximum time spent in the flush function.
+        std::chrono::microseconds totalFlushTime;
+        std::chrono::microseconds maxFlushTime;
+
+        /**
+         * @return the average number of changes written by a single write of a draft, or 0 if nothing was written.
+         */
+        [[nodiscard]] double coalescingRatio() const;
+    };
+
+    /**
+     * The main constructor, which starts the background thread.
+     *
+     * @param policy defines when the flush function is invoked.
+     * @param flush the function which writes the changed drafts and returns how many drafts it wrote.
+     */
+    DraftFlusher(const DraftFlushPolicy &policy, std::function<size_t()> flush);
+
+    /**
+     * Flushes the pending changes, if any, and stops the background thread.
+     */
+    ~DraftFlusher();
+
+    /**
+     * Notifies that a draft changed. It doesn't block the caller.
+     *
+     * @param bytes the size of the changed text.
+     */
+    void markDirty(size_t bytes);
+
+    /**
+     * Flushes the changes notified so far on the background thread and waits until they are written.
+     * It mustn't be invoked by the flush function.
+     *
+     * @throws the exception thrown by the flush function while writing the changes.
+     */
+    void flush();
+
+    [[nodiscard]] Stats stats() const;
+
+   private:
+    DraftFlushPolicy policy;
+    std::function<size_t()> flushFunction;
+    bool dirty = false;
+    size_t dirtyBytes = 0;
+    std::chrono::steady_clock::time_point lastUpdate;
+    // The explicit flushes requested and completed, used to know when a requested flush is done.
+    unsigned long requestedFlushes = 0;
+    unsigned long completedFlushes = 0;
+    // The error of the last failed flush and the explicit flushes it completed, which rethrow it.
+    std::exception_ptr flushError;
+    unsigned long firstFailedFlush = 0;
+    unsigned long lastFailedFlush = 0;
+    // The message of the error thrown by the last failed flush.
+    std::string lastFailure;
+    // True if the last flush failed, so its changes are retried by the next flush, but not in background on their own.
+    bool retryPending = false;
+    bool stopping = false;
+    Stats counters{};
+    mutable std::mutex mutex;
+    std::condition_variable changed;
+    std::condition_variable flushed;
+    // It's declared last so it starts when all the other members are initialized.
+    std::thread worker;
+
+    void run();
+
+    /**
+     * Invokes the flush function without holding the lock and updates the counters.
+     */
+    void flushLocked(std::unique_lock<std::mutex> &lock);
+};
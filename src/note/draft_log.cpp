@@ -0,0 +1,305 @@
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "draft_log.hpp"
+#include "core/exception_macros.hpp"
+
+/* PRIVATE */ namespace {
+
+const char magic[4] = {'N', 'D', 'L', 'G'};
+
+const uint32_t formatVersion = 2;
+
+// The magic, the version, the generation, the position of the first record, the checksum of the previous fields and a
+// padding.
+const size_t headerSlotSize = 32;
+
+// The header is written alternately in two slots, so a header torn by a crash leaves the previous one valid.
+const size_t headerSize = 2 * headerSlotSize;
+
+// The size of the payload and its checksum.
+const size_t recordHeaderSize = 8;
+
+// The generation, the operation, the id, the offset and the count, followed by the text.
+const size_t payloadFieldsSize = 8 + 1 + 4 + 8 + 8;
+
+const size_t initialCapacity = 64 * 1024;
+
+std::array<uint32_t, 256> createCrcTable() {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; i++) {
+        auto crc = i;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? 0xEDB88320 ^ (crc >> 1) : crc >> 1;
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+// The CRC-32 of zlib, which detects the records torn by a crash.
+uint32_t crc32(const char *bytes, size_t size) {
+    static const auto table = createCrcTable();
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < size; i++) {
+        crc = table[(crc ^ static_cast<uint8_t>(bytes[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFF;
+}
+
+template<typename T>
+T load(const char *bytes) {
+    T value;
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+template<typename T>
+char *store(char *bytes, T value) {
+    std::memcpy(bytes, &value, sizeof(T));
+    return bytes + sizeof(T);
+}
+
+std::system_error systemError(const std::string &message) {
+    return std::system_error(errno, std::generic_category(), message);
+}
+
+// Allocates the blocks of the file up to the given size, extending it with zeros.
+// Returns 0 if it succeeds, otherwise the error number.
+int allocate(int fd, size_t size) {
+#ifdef __APPLE__
+    // Darwin doesn't have posix_fallocate(), so the blocks are reserved with F_PREALLOCATE before the file is extended.
+    struct stat fileStat{};
+    if (fstat(fd, &fileStat) != 0) {
+        return errno;
+    }
+    auto fileSize = static_cast<size_t>(fileStat.st_size);
+    if (size > fileSize) {
+        fstore_t store{F_ALLOCATECONTIG | F_ALLOCATEALL, F_PEOFPOSMODE, 0, static_cast<off_t>(size - fileSize), 0};
+        if (fcntl(fd, F_PREALLOCATE, &store) == -1) {
+            // A contiguous space isn't required, only the blocks.
+            store.fst_flags = F_ALLOCATEALL;
+            if (fcntl(fd, F_PREALLOCATE, &store) == -1) {
+                return errno;
+            }
+        }
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            return errno;
+        }
+    }
+    return 0;
+#else
+    return posix_fallocate(fd, 0, static_cast<off_t>(size));
+#endif
+}
+}
+
+bool operator==(const DraftLog::Record &first, const DraftLog::Record &second) {
+    return first.operation == second.operation &&
+           first.id == second.id &&
+           first.offset == second.offset &&
+           first.count == second.count &&
+           first.text == second.text;
+}
+
+DraftLog::DraftLog(const std::string &path, uint64_t firstGeneration) {
+    fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        THROW(systemError("Can't open the log of the drafts " + path));
+    }
+    struct stat fileStat{};
+    if (fstat(fd, &fileStat) != 0) {
+        auto error = systemError("Can't read the size of the log of the drafts " + path);
+        close(fd);
+        THROW(error);
+    }
+    auto fileSize = static_cast<size_t>(fileStat.st_size);
+#ifdef EXCEPTIONS_ENABLED
+    try {
+#endif
+        map(fileSize < initialCapacity ? initialCapacity : fileSize);
+#ifdef EXCEPTIONS_ENABLED
+    } catch (...) {
+        // The destructor isn't invoked if the constructor throws.
+        close(fd);
+        throw;
+    }
+#endif
+
+    bool validHeader = false;
+    if (fileSize >= headerSize) {
+        for (size_t slot = 0; slot < 2; slot++) {
+            const char *header = data + slot * headerSlotSize;
+            auto slotGeneration = load<uint64_t>(header + 8);
+            auto slotStart = load<uint64_t>(header + 16);
+            auto validSlot = std::memcmp(header, magic, sizeof(magic)) == 0 &&
+                             load<uint32_t>(header + 4) == formatVersion &&
+                             load<uint32_t>(header + 24) == crc32(header, 24) &&
+                             slotStart >= headerSize && slotStart <= capacity;
+            // The slot written last has the highest generation.
+            if (validSlot && (!validHeader || slotGeneration > generation)) {
+                validHeader = true;
+                headerSlot = slot;
+                generation = slotGeneration;
+                start = static_cast<size_t>(slotStart);
+            }
+        }
+    }
+    if (!validHeader) {
+        // The file was just created or it isn't a log, so it's reset.
+        std::memset(data, 0, capacity);
+        headerSlot = 1;
+        writeHeader(firstGeneration, headerSize);
+    }
+    end = scan(start, nullptr);
+}
+
+DraftLog::~DraftLog() {
+    if (data) {
+        munmap(data, capacity);
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+std::vector<DraftLog::Record> DraftLog::read() const {
+    return readAfter(start);
+} // LCOV_EXCL_BR_LINE
+
+std::vector<DraftLog::Record> DraftLog::readAfter(size_t position) const {
+    std::vector<Record> records;
+    scan(position < start ? start : position, &records);
+    return records;
+} // LCOV_EXCL_BR_LINE
+
+size_t DraftLog::position() const {
+    return end;
+}
+
+uint64_t DraftLog::currentGeneration() const {
+    return generation;
+}
+
+void DraftLog::truncate(size_t position) {
+    std::vector<Record> keptRecords;
+    scan(position, &keptRecords);
+    // The kept records are written again with the next generation where they don't overwrite the current records:
+    // before them, if they fit, otherwise after them. Until the header is switched, a crash keeps the current records.
+    auto nextGeneration = generation + 1;
+    auto keptSize = end - position;
+    auto nextStart = headerSize + keptSize <= start ? headerSize : end;
+    // The file is grown first, so a failure can't leave the records of the next generation partially written.
+    reserve(nextStart + keptSize);
+    auto nextEnd = nextStart;
+    for (const auto &record : keptRecords) {
+        nextEnd = write(nextEnd, nextGeneration, record.operation, record.id, record.offset, record.count, record.text);
+    }
+    // The records of the previous generations are ignored once the header is switched.
+    writeHeader(nextGeneration, nextStart);
+    end = nextEnd;
+}
+
+size_t DraftLog::scan(size_t from, std::vector<Record> *records) const {
+    auto position = from;
+    while (position + recordHeaderSize <= capacity) {
+        auto payloadSize = load<uint32_t>(data + position);
+        if (payloadSize < payloadFieldsSize || payloadSize > capacity - position - recordHeaderSize) {
+            // The end of the log, or a record torn by a crash.
+            break;
+        }
+        const char *payload = data + position + recordHeaderSize;
+        if (load<uint32_t>(data + position + 4) != crc32(payload, payloadSize) ||
+            load<uint64_t>(payload) != generation) {
+            break;
+        }
+        if (records) {
+            Record record;
+            record.operation = static_cast<Operation>(load<uint8_t>(payload + 8));
+            record.id = load<int32_t>(payload + 9);
+            record.offset = load<uint64_t>(payload + 13);
+            record.count = load<uint64_t>(payload + 21);
+            record.text.assign(payload + payloadFieldsSize, payloadSize - payloadFieldsSize);
+            records->push_back(std::move(record));
+        }
+        position += recordHeaderSize + payloadSize;
+    }
+    return position;
+}
+
+void DraftLog::map(size_t size) {
+    // The blocks are allocated up front, so a full disk fails here instead of raising SIGBUS when they are written.
+    // The file is extended with zeros, which end the log.
+    auto result = allocate(fd, size);
+    if (result != 0) {
+        errno = result;
+        THROW(systemError("Can't resize the log of the drafts"));
+    }
+    // The new mapping is created before the old one is removed, so the log stays valid if it fails.
+    auto mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED) {
+        THROW(systemError("Can't map the log of the drafts"));
+    }
+    if (data) {
+        munmap(data, capacity);
+    }
+    data = static_cast<char *>(mapped);
+    capacity = size;
+}
+
+void DraftLog::reserve(size_t size) {
+    if (size <= capacity) {
+        return;
+    }
+    auto newCapacity = capacity * 2;
+    while (size > newCapacity) {
+        newCapacity *= 2;
+    }
+    map(newCapacity);
+}
+
+void DraftLog::writeHeader(uint64_t nextGeneration, size_t nextStart) {
+    // The other slot is written, so the current header stays valid if the process crashes while it's written.
+    auto nextSlot = 1 - headerSlot;
+    char *header = data + nextSlot * headerSlotSize;
+    std::memcpy(header, magic, sizeof(magic));
+    store<uint32_t>(header + 4, formatVersion);
+    store<uint64_t>(header + 8, nextGeneration);
+    store<uint64_t>(header + 16, nextStart);
+    store<uint32_t>(header + 24, crc32(header, 24));
+    headerSlot = nextSlot;
+    generation = nextGeneration;
+    start = nextStart;
+}
+
+void DraftLog::append(Operation operation, int id, uint64_t offset, uint64_t count, stdx::string_view text) {
+    end = write(end, generation, operation, id, offset, count, text);
+}
+
+size_t DraftLog::write(size_t position,
+                       uint64_t recordGeneration,
+                       Operation operation,
+                       int id,
+                       uint64_t offset,
+                       uint64_t count,
+                       stdx::string_view text) {
+    auto payloadSize = payloadFieldsSize + text.size();
+    auto recordSize = recordHeaderSize + payloadSize;
+    reserve(position + recordSize);
+    char *payload = data + position + recordHeaderSize;
+    auto cursor = store<uint64_t>(payload, recordGeneration);
+    cursor = store<uint8_t>(cursor, static_cast<uint8_t>(operation));
+    cursor = store<int32_t>(cursor, id);
+    cursor = store<uint64_t>(cursor, offset);
+    cursor = store<uint64_t>(cursor, count);
+    std::memcpy(cursor, text.data(), text.size());
+    store<uint32_t>(data + position + 4, crc32(payload, payloadSize));
+    // The size is written last, so a record is visible only when it's complete.
+    store<uint32_t>(data + position, static_cast<uint32_t>(payloadSize));
+    return position + recordSize;
+}
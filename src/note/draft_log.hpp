@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "core/include_macros.hpp"
+#include AMALGAMATION(std_string_view_compat.hpp)
+
+/**
+ * Append-only log of the changes of the drafts, stored in a memory-mapped file.
+ * Appending a change copies it in the mapped memory without any system call, so it survives the crash of the process
+ * after a few microseconds, while a power loss can lose the changes not yet written back by the OS.
+ * Every record has a checksum, so a record torn by a crash ends the log.
+ * The records belong to a generation stored in the header of the file, together with the position of the first
+ * record, which change when the log is truncated, so the records of the previous generations are ignored even if
+ * their bytes are still in the file.
+ * It can't be used by multiple threads.
+ */
+class DraftLog {
+   public:
+    enum class Operation : uint8_t {
+        UpdateNewTitle = 1,
+        UpdateNewDescription = 2,
+        UpdateExistingTitle = 3,
+        UpdateExistingDescription = 4,
+        InsertInNewDescription = 5,
+        EraseFromNewDescription = 6,
+        InsertInExistingDescription = 7,
+        EraseFromExistingDescription = 8,
+        DeleteNew = 9,
+        DeleteExisting = 10,
+        DeleteAll = 11
+    };
+
+    /**
+     * A change of the drafts. The fields which aren't used by its operation are 0 or empty.
+     */
+    struct Record {
+        Operation operation;
+        int id;
+        uint64_t offset;
+        uint64_t count;
+        std::string text;
+
+        friend bool operator==(const Record &first, const Record &second);
+    };
+
+    /**
+     * Opens the log at the given path, creating it if it doesn't exist or if it isn't a valid log.
+     *
+     * @param firstGeneration the generation of the log when it's created.
+     * @throw std::system_error if the file can't be opened or mapped.
+     */
+    explicit DraftLog(const std::string &path, uint64_t firstGeneration = 1);
+
+    ~DraftLog();
+
+    DraftLog(const DraftLog &) = delete;
+
+    DraftLog &operator=(const DraftLog &) = delete;
+
+    /**
+     * @return the records of the current generation, in the order they were appended.
+     */
+    [[nodiscard]] std::vector<Record> read() const;
+
+    /**
+     * @param position a position returned by position() in the current generation.
+     * @return the records of the current generation appended after the given position.
+     */
+    [[nodiscard]] std::vector<Record> readAfter(size_t position) const;
+
+    /**
+     * Writes a record at the end of the log, growing the file if needed.
+     *
+     * @throw std::system_error if the file can't be grown, leaving the log as it was.
+     */
+    void append(Operation operation, int id, uint64_t offset, uint64_t count, stdx::string_view text);
+
+    /**
+     * @return the position after the last record, which can be passed to truncate().
+     */
+    [[nodiscard]] size_t position() const;
+
+    /**
+     * @return the generation of the records, which is increased by every truncation.
+     */
+    [[nodiscard]] uint64_t currentGeneration() const;
+
+    /**
+     * Drops the records before the given position, keeping the ones appended after it.
+     * The kept records are written with the next generation before the header is changed, so a crash during the
+     * truncation keeps either the current records or the kept ones.
+     *
+     * @param position a position returned by position() in the current generation.
+     * @throw std::system_error if the file can't be grown, leaving the log as it was.
+     */
+    void truncate(size_t position);
+
+   private:
+    int fd = -1;
+    char *data = nullptr;
+    size_t capacity = 0;
+    // The position of the first record and the one after the last record.
+    size_t start = 0;
+    size_t end = 0;
+    uint64_t generation = 0;
+    // The slot of the current header.
+    size_t headerSlot = 0;
+
+    /**
+     * Reads the records of the current generation.
+     *
+     * @param from the position of the first record.
+     * @param records the vector filled with the records, or nullptr to skip them.
+     * @return the position after the last valid record.
+     */
+    size_t scan(size_t from, std::vector<Record> *records) const;
+
+    /**
+     * Allocates the file up to the given size and maps it again, keeping the previous mapping if it fails.
+     */
+    void map(size_t size);
+
+    /**
+     * Grows the file, doubling its size, until it contains the given size.
+     */
+    void reserve(size_t size);
+
+    /**
+     * Writes the header in the slot which isn't the current one, switching the log to the given generation.
+     */
+    void writeHeader(uint64_t nextGeneration, size_t nextStart);
+
+    /**
+     * Writes a record at the given position, growing the file if needed.
+     *
+     * @return the position after the record.
+     */
+    size_t write(size_t position,
+                 uint64_t recordGeneration,
+                 Operation operation,
+                 int id,
+                 uint64_t offset,
+                 uint64_t count,
+                 stdx::string_view text);
+};
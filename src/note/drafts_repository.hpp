@@ -16,6 +16,30 @@ class DraftsRepository {
 
     virtual void updateExistingDescription(int id, std::string description) = 0;
 
+    /**
+     * Inserts a text in the description of the new draft, which is created empty if it doesn't exist.
+     *
+     * @param offset the offset of the insertion in bytes, from 0 to the size of the description.
+     */
+    virtual void insertInNewDescription(size_t offset, std::string text) = 0;
+
+    /**
+     * Deletes a range of bytes from the description of the new draft, which is created empty if it doesn't exist.
+     */
+    virtual void eraseFromNewDescription(size_t offset, size_t count) = 0;
+
+    /**
+     * Inserts a text in the description of the draft of an existing note, which must have a description.
+     *
+     * @param offset the offset of the insertion in bytes, from 0 to the size of the description.
+     */
+    virtual void insertInExistingDescription(int id, size_t offset, std::string text) = 0;
+
+    /**
+     * Deletes a range of bytes from the description of the draft of an existing note, which must have a description.
+     */
+    virtual void eraseFromExistingDescription(int id, size_t offset, size_t count) = 0;
+
     virtual void persist() = 0;
 
     virtual void deleteAll() = 0;
@@ -3,7 +3,9 @@
 #include "core/include_macros.hpp"
 #include AMALGAMATION(database_client.hpp)
 
-std::shared_ptr<DraftsRepository> DraftsRepositoryFactory::create() {
+std::shared_ptr<DraftsRepository> DraftsRepositoryFactory::create(stdx::optional<DraftFlushPolicy> flushPolicy,
+                                                                  bool preload,
+                                                                  const stdx::optional<std::string> &logPath) {
     auto db = Db::Client::get();
-    return std::make_shared<DraftsRepositoryImpl>(db);
+    return std::make_shared<DraftsRepositoryImpl>(db, flushPolicy, preload, logPath);
 }
@@ -1,10 +1,24 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include "core/include_macros.hpp"
 #include "drafts_repository.hpp"
+#include AMALGAMATION(draft_flush_policy.hpp)
+#include AMALGAMATION(std_optional_compat.hpp)
 
 class DraftsRepositoryFactory {
    public:
-    static std::shared_ptr<DraftsRepository> create();
+    /**
+     * Creates the repository of the drafts stored in the database of Db::Client.
+     *
+     * @param flushPolicy defines when the changed drafts are written by a background thread. When it's empty, they
+     * are written only by DraftsRepository::persist().
+     * @param preload true to read all the drafts when the repository is created, so they are accessed in memory.
+     * @param logPath the path of the log which records the changes of the drafts until they are written, so they
+     * survive a crash. When it's empty, the changes which aren't written are lost when the process ends.
+     */
+    static std::shared_ptr<DraftsRepository> create(stdx::optional<DraftFlushPolicy> flushPolicy = stdx::nullopt,
+                                                    bool preload = false,
+                                                    const stdx::optional<std::string> &logPath = stdx::nullopt);
 };
\ No newline at end of file
@@ -1,156 +1,525 @@
+#include <algorithm>
 #include "drafts_repository_impl.hpp"
 #include "incomplete_draft_exception.hpp"
 #include "core/exception_macros.hpp"
 
-DraftsRepositoryImpl::DraftsRepositoryImpl(std::shared_ptr<Db::Database> db) :
-    db(std::move(db)) {}
+DraftsRepositoryImpl::DraftsRepositoryImpl(std::shared_ptr<Db::Database> db,
+                                           stdx::optional<DraftFlushPolicy> flushPolicy,
+                                           bool preload,
+                                           const stdx::optional<std::string> &logPath) :
+    db(std::move(db)) {
+    if (preload) {
+        preloadDrafts();
+    }
+    if (logPath) {
+        auto checkpoint = getLogCheckpointFromDb();
+        // A log created from scratch starts after the checkpoint, so none of its records is skipped.
+        log = std::unique_ptr<DraftLog>(new DraftLog(*logPath, checkpoint ? checkpoint->generation + 1 : 1));
+        replayLog(checkpoint);
+    }
+    if (flushPolicy) {
+        this->flusher = std::unique_ptr<DraftFlusher>(new DraftFlusher(*flushPolicy, [this] {
+            return writePending();
+        }));
+    }
+}
 
 void DraftsRepositoryImpl::updateNewTitle(std::string title) {
-    if (!pendingNew) {
-        pendingNew = MutableDraft();
-        std::string description;
-        // Read the title from the DB, if any, or put it empty.
-        auto descriptionResult = getNewDescriptionFromDb();
-        if (descriptionResult) {
-            description = *descriptionResult;
-        }
-        pendingNew->updateDescription(description);
+    auto bytes = title.size();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto &state = openNew();
+        logChange(DraftLog::Operation::UpdateNewTitle, 0, 0, 0, title);
+        state.draft.updateTitle(std::move(title));
+        state.dirty = true;
     }
-    pendingNew->updateTitle(title);
+    markDirty(bytes);
 }
 
 void DraftsRepositoryImpl::updateNewDescription(std::string description) {
-    if (!pendingNew) {
-        pendingNew = MutableDraft();
-        std::string title;
-        // Read the title from the DB, if any, or put it empty.
-        auto titleResult = getNewTitleFromDb();
-        if (titleResult) {
-            title = *titleResult;
-        }
-        pendingNew->updateTitle(title);
+    auto bytes = description.size();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto &state = openNew();
+        logChange(DraftLog::Operation::UpdateNewDescription, 0, 0, 0, description);
+        state.draft.updateDescription(std::move(description));
+        state.dirty = true;
     }
-    pendingNew->updateDescription(description);
+    markDirty(bytes);
 }
 
 void DraftsRepositoryImpl::updateExistingTitle(int id, std::string title) {
-    auto existingEntry = pendingExisting.find(id);
-    if (existingEntry != pendingExisting.end()) {
-        // The draft exists in memory.
-        auto &draft = existingEntry->second;
-        draft.updateTitle(title);
-    } else {
-        auto draft = MutableDraft();
-        // Read the description from the DB, if any.
-        auto descriptionResult = getExistingDescriptionFromDb(id);
-        if (descriptionResult) {
-            draft.updateDescription(*descriptionResult);
+    auto bytes = title.size();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto state = findExisting(id);
+        if (!state) {
+            // The draft isn't stored, so its description is missing until it's updated.
+            state = &existingDrafts[id];
         }
-        draft.updateTitle(title);
-        pendingExisting[id] = draft;
+        logChange(DraftLog::Operation::UpdateExistingTitle, id, 0, 0, title);
+        state->draft.updateTitle(std::move(title));
+        markExistingDirty(id, *state);
     }
+    markDirty(bytes);
 }
 
 void DraftsRepositoryImpl::updateExistingDescription(int id, std::string description) {
-    auto existingEntry = pendingExisting.find(id);
-    if (existingEntry != pendingExisting.end()) {
-        // The draft exists in memory.
-        auto &draft = existingEntry->second;
-        draft.updateDescription(description);
-    } else {
-        auto draft = MutableDraft();
-        // Read the title from the DB, if any.
-        auto titleResult = getExistingTitleFromDb(id);
-        if (titleResult) {
-            draft.updateTitle(*titleResult);
+    auto bytes = description.size();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto state = findExisting(id);
+        if (!state) {
+            // The draft isn't stored, so its title is missing until it's updated.
+            state = &existingDrafts[id];
         }
-        draft.updateDescription(description);
-        pendingExisting[id] = draft;
+        logChange(DraftLog::Operation::UpdateExistingDescription, id, 0, 0, description);
+        state->draft.updateDescription(std::move(description));
+        markExistingDirty(id, *state);
+    }
+    markDirty(bytes);
+}
+
+void DraftsRepositoryImpl::insertInNewDescription(size_t offset, std::string text) {
+    auto bytes = text.size();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto &state = openNew();
+        // The edit is checked before it's logged, so an edit which can't be applied isn't replayed.
+        state.draft.checkDescriptionRange(offset, 0);
+        logChange(DraftLog::Operation::InsertInNewDescription, 0, offset, 0, text);
+        state.draft.insertInDescription(offset, text);
+        state.dirty = true;
+    }
+    markDirty(bytes);
+}
+
+void DraftsRepositoryImpl::eraseFromNewDescription(size_t offset, size_t count) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto &state = openNew();
+        state.draft.checkDescriptionRange(offset, count);
+        logChange(DraftLog::Operation::EraseFromNewDescription, 0, offset, count, stdx::string_view());
+        state.draft.eraseFromDescription(offset, count);
+        state.dirty = true;
+    }
+    markDirty(count);
+}
+
+void DraftsRepositoryImpl::insertInExistingDescription(int id, size_t offset, std::string text) {
+    auto bytes = text.size();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto &state = openExistingWithDescription(id);
+        state.draft.checkDescriptionRange(offset, 0);
+        logChange(DraftLog::Operation::InsertInExistingDescription, id, offset, 0, text);
+        state.draft.insertInDescription(offset, text);
+        markExistingDirty(id, state);
+    }
+    markDirty(bytes);
+}
+
+void DraftsRepositoryImpl::eraseFromExistingDescription(int id, size_t offset, size_t count) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto &state = openExistingWithDescription(id);
+        state.draft.checkDescriptionRange(offset, count);
+        logChange(DraftLog::Operation::EraseFromExistingDescription, id, offset, count, stdx::string_view());
+        state.draft.eraseFromDescription(offset, count);
+        markExistingDirty(id, state);
     }
+    markDirty(count);
 }
 
 void DraftsRepositoryImpl::deleteAll() {
+    // The drafts are deleted from the DB without holding the mutex, so the drafts can still be edited in the meantime.
+    std::lock_guard<std::mutex> persistLock(persistMutex);
+    auto logPosition = logDeletion(DraftLog::Operation::DeleteAll, 0);
     db->executeTransaction([this]() {
-        deleteNew();
-        // Reset the existing drafts in memory.
-        pendingExisting.clear();
-        // Delete all the existing drafts from the DB.
+        db->createStatement("DELETE FROM pending_draft_creation")->execute<void>();
         db->createStatement("DELETE FROM pending_drafts_update")->execute<void>();
-    });
+    }, Db::TransactionMode::Immediate);
+    // The drafts in memory are reset only once they are deleted from the DB, so a failed deletion keeps them in sync.
+    std::lock_guard<std::mutex> lock(mutex);
+    relogDeletion(DraftLog::Operation::DeleteAll, 0, logPosition);
+    newDraft = stdx::nullopt;
+    existingDrafts.clear();
+    dirtyExistingIds.clear();
 }
 
 void DraftsRepositoryImpl::deleteNew() {
-    // Remove it from in-memory storage.
-    pendingNew = stdx::nullopt;
-    // Remove it from database.
+    std::lock_guard<std::mutex> persistLock(persistMutex);
+    auto logPosition = logDeletion(DraftLog::Operation::DeleteNew, 0);
     db->createStatement("DELETE FROM pending_draft_creation")->execute<void>();
+    std::lock_guard<std::mutex> lock(mutex);
+    relogDeletion(DraftLog::Operation::DeleteNew, 0, logPosition);
+    newDraft = stdx::nullopt;
 }
 
 void DraftsRepositoryImpl::deleteExisting(int id) {
-    auto existingEntry = pendingExisting.find(id);
-    if (existingEntry != pendingExisting.end()) {
-        // Remote it from in-memory storage.
-        pendingExisting.erase(existingEntry);
-    }
-    // Remove it from database.
+    std::lock_guard<std::mutex> persistLock(persistMutex);
+    auto logPosition = logDeletion(DraftLog::Operation::DeleteExisting, id);
     auto stmt = db->createStatement("DELETE FROM pending_drafts_update WHERE rowid = ?");
     stmt->bind(1, id);
     stmt->execute<void>();
+    std::lock_guard<std::mutex> lock(mutex);
+    relogDeletion(DraftLog::Operation::DeleteExisting, id, logPosition);
+    // Its id is skipped by the next write if it's still in the dirty set.
+    existingDrafts.erase(id);
 }
 
 stdx::optional<Draft> DraftsRepositoryImpl::getNew() {
-    if (pendingNew) {
-        return pendingNew->toDraft();
+    std::lock_guard<std::mutex> lock(mutex);
+    auto state = findNew();
+    if (!state) {
+        return stdx::nullopt;
     }
-    return getNewFromDb();
+    return state->draft.toDraft();
 }
 
 stdx::optional<Draft> DraftsRepositoryImpl::getExisting(int id) {
-    auto existingEntry = pendingExisting.find(id);
-    if (existingEntry != pendingExisting.end()) {
-        return existingEntry->second.toDraft();
+    std::lock_guard<std::mutex> lock(mutex);
+    auto state = findExisting(id);
+    if (!state) {
+        return stdx::nullopt;
     }
-    return getExistingFromDb(id);
+    return state->draft.toDraft();
 }
 
 void DraftsRepositoryImpl::persist() {
-    auto tempPendingNew = pendingNew;
-    auto tempPendingExisting = pendingExisting;
-    bool shouldPersistNew = (bool) tempPendingNew;
-    if (shouldPersistNew) {
-        // Reset the in-memory storage for the new draft since it will be persisted.
-        pendingNew = stdx::nullopt;
+    if (flusher) {
+        flusher->flush();
+        return;
     }
-    bool shouldPersistExisting = !tempPendingExisting.empty();
-    if (shouldPersistExisting) {
-        // Reset the in-memory storage for the existing drafts since they will be persisted.
-        pendingExisting.clear();
+    writePending();
+}
+
+stdx::optional<DraftFlusher::Stats> DraftsRepositoryImpl::getFlushStats() const {
+    if (!flusher) {
+        return stdx::nullopt;
     }
+    return flusher->stats();
+}
 
-    if (!shouldPersistNew && !shouldPersistExisting) {
-        // Nothing to persist.
-        return;
+size_t DraftsRepositoryImpl::writePending() {
+    std::lock_guard<std::mutex> persistLock(persistMutex);
+    stdx::optional<DraftWrite> newWrite;
+    std::vector<DraftWrite> existingWrites;
+    // The existing drafts which can't be written since their title or their description is missing.
+    std::vector<int> incompleteIds;
+    size_t logPosition = 0;
+    uint64_t logGeneration = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // The changes logged until now are written by this write.
+        logPosition = log ? log->position() : 0;
+        logGeneration = log ? log->currentGeneration() : 0;
+        // The incomplete drafts aren't written, so their fields are logged again after the position of this write,
+        // before anything is changed in memory, since the changes before it are skipped by the replay and truncated.
+        for (int id : dirtyExistingIds) {
+            auto existingEntry = existingDrafts.find(id);
+            if (existingEntry == existingDrafts.end() || !existingEntry->second.dirty ||
+                !existingEntry->second.draft.isIncomplete() ||
+                std::find(incompleteIds.begin(), incompleteIds.end(), id) != incompleteIds.end()) {
+                continue;
+            }
+            const auto &draft = existingEntry->second.draft;
+            if (draft.hasTitle()) {
+                logChange(DraftLog::Operation::UpdateExistingTitle, id, 0, 0, draft.requireTitle());
+            }
+            if (draft.hasDescription()) {
+                logChange(DraftLog::Operation::UpdateExistingDescription, id, 0, 0, draft.requireDescription());
+            }
+            incompleteIds.push_back(id);
+        }
+        if (newDraft && newDraft->dirty) {
+            newDraft->dirty = false;
+            auto hash = newDraft->draft.hash();
+            if (newDraft->persistedHash != hash) {
+                newWrite = DraftWrite{0, newDraft->draft, hash};
+            }
+        }
+        // The dirty set is swapped out, so the drafts changed from now on are written by the next write.
+        std::vector<int> dirtyIds;
+        dirtyIds.swap(dirtyExistingIds);
+        for (int id : dirtyIds) {
+            auto existingEntry = existingDrafts.find(id);
+            if (existingEntry == existingDrafts.end() || !existingEntry->second.dirty) {
+                // The draft was deleted or it was already added by a previous id.
+                continue;
+            }
+            auto &state = existingEntry->second;
+            if (state.draft.isIncomplete()) {
+                // The draft stays dirty in memory, so it's written once it's completed, without failing the others.
+                dirtyExistingIds.push_back(id);
+                continue;
+            }
+            state.dirty = false;
+            auto hash = state.draft.hash();
+            if (state.persistedHash != hash) {
+                // Only the changed drafts are copied, so they can be written without holding the mutex.
+                existingWrites.push_back(DraftWrite{id, state.draft, hash});
+            }
+        }
     }
+    size_t writtenDrafts = (newWrite ? 1 : 0) + existingWrites.size();
     auto dbTransaction = [&]() {
-        if (shouldPersistNew) {
+        if (newWrite) {
             // Persist in DB the new draft note.
-            persistNew(*tempPendingNew);
+            persistNew(newWrite->draft);
         }
-        if (shouldPersistExisting) {
+        if (!existingWrites.empty()) {
             // Persist in DB the draft notes which should be updated.
-            persistExisting(tempPendingExisting);
+            persistExisting(existingWrites);
+        }
+        if (log) {
+            // The position is committed with the drafts, so a crash before the log is truncated doesn't replay them.
+            persistLogCheckpoint(LogCheckpoint{logGeneration, logPosition});
         }
     };
-    db->executeTransaction(dbTransaction);
+#ifdef EXCEPTIONS_ENABLED
+    try {
+#endif
+        if (writtenDrafts > 0) {
+            // The transaction only writes so it takes the write lock up front instead of upgrading it later.
+            // It shares a commit with the notes written in the meantime, when the writer thread is enabled.
+            db->executeGroupedTransaction(dbTransaction, Db::TransactionMode::Immediate);
+        }
+#ifdef EXCEPTIONS_ENABLED
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        // The drafts which weren't written are marked as dirty again, so they are written by the next write.
+        if (newWrite && newDraft) {
+            newDraft->dirty = true;
+        }
+        for (const auto &write : existingWrites) {
+            auto existingEntry = existingDrafts.find(write.id);
+            if (existingEntry != existingDrafts.end()) {
+                markExistingDirty(write.id, existingEntry->second);
+            }
+        }
+        throw;
+    }
+#endif
+    std::lock_guard<std::mutex> lock(mutex);
+    // The drafts changed in the meantime are still dirty, but their hash is compared with the written one.
+    if (newWrite && newDraft) {
+        newDraft->persistedHash = newWrite->hash;
+        const auto &written = newWrite->draft;
+        if (!newDraft->dirty && written.requireTitle().empty() && written.requireDescription().empty()) {
+            // The empty draft was deleted from the DB, so it's closed like a not initialized one.
+            newDraft = stdx::nullopt;
+        }
+    }
+    for (const auto &write : existingWrites) {
+        auto existingEntry = existingDrafts.find(write.id);
+        if (existingEntry != existingDrafts.end()) {
+            existingEntry->second.persistedHash = write.hash;
+        }
+    }
+    if (log) {
+        // The written changes are dropped from the log, since they are stored in the tables of the drafts.
+        log->truncate(logPosition);
+    }
+    for (int id : incompleteIds) {
+        auto existingEntry = existingDrafts.find(id);
+        if (existingEntry != existingDrafts.end() && existingEntry->second.draft.isIncomplete()) {
+            // The other drafts are written, but the caller is told that this one can't be until it's completed.
+            THROW(IncompleteDraftException(id, existingEntry->second.draft));
+        }
+    }
+    return writtenDrafts;
 } // LCOV_EXCL_BR_LINE
 
+void DraftsRepositoryImpl::replayLog(const stdx::optional<LogCheckpoint> &checkpoint) {
+    replaying = true;
+    // The records until the checkpoint were written by a write which committed before the log was truncated.
+    auto records = checkpoint && checkpoint->generation == log->currentGeneration()
+                   ? log->readAfter(checkpoint->position)
+                   : log->read();
+    for (const auto &record : records) {
+#ifdef EXCEPTIONS_ENABLED
+        try {
+#endif
+            replay(record);
+#ifdef EXCEPTIONS_ENABLED
+        } catch (...) {
+            // The change failed when it was logged too, or its draft was deleted by a following change.
+        }
+#endif
+    }
+    replaying = false;
+#ifdef EXCEPTIONS_ENABLED
+    try {
+#endif
+        // The replayed changes are written in the tables of the drafts, so the log restarts empty.
+        writePending();
+#ifdef EXCEPTIONS_ENABLED
+    } catch (...) {
+        // The drafts which can't be written, like the incomplete ones, stay in memory and in the log like before.
+    }
+#endif
+}
+
+void DraftsRepositoryImpl::replay(const DraftLog::Record &record) {
+    auto offset = static_cast<size_t>(record.offset);
+    auto count = static_cast<size_t>(record.count);
+    switch (record.operation) {
+        case DraftLog::Operation::UpdateNewTitle:
+            updateNewTitle(record.text);
+            break;
+        case DraftLog::Operation::UpdateNewDescription:
+            updateNewDescription(record.text);
+            break;
+        case DraftLog::Operation::UpdateExistingTitle:
+            updateExistingTitle(record.id, record.text);
+            break;
+        case DraftLog::Operation::UpdateExistingDescription:
+            updateExistingDescription(record.id, record.text);
+            break;
+        case DraftLog::Operation::InsertInNewDescription:
+            insertInNewDescription(offset, record.text);
+            break;
+        case DraftLog::Operation::EraseFromNewDescription:
+            eraseFromNewDescription(offset, count);
+            break;
+        case DraftLog::Operation::InsertInExistingDescription:
+            insertInExistingDescription(record.id, offset, record.text);
+            break;
+        case DraftLog::Operation::EraseFromExistingDescription:
+            eraseFromExistingDescription(record.id, offset, count);
+            break;
+        case DraftLog::Operation::DeleteNew:
+            deleteNew();
+            break;
+        case DraftLog::Operation::DeleteExisting:
+            deleteExisting(record.id);
+            break;
+        case DraftLog::Operation::DeleteAll:
+            deleteAll();
+            break;
+    }
+}
+
+void DraftsRepositoryImpl::preloadDrafts() {
+    auto draft = getNewFromDb();
+    if (draft) {
+        newDraft = persistedState(draft->getTitle(), draft->getDescription());
+    }
+    db->createStatement("SELECT rowid, title, description FROM pending_drafts_update")->
+        execute<std::shared_ptr<Db::Cursor>>()->forEachRow<int, std::string, std::string>(
+        [this](int id, std::string title, std::string description) {
+            existingDrafts.emplace(id, persistedState(std::move(title), std::move(description)));
+        }
+    );
+    preloaded = true;
+}
+
+DraftsRepositoryImpl::DraftState *DraftsRepositoryImpl::findNew() {
+    if (newDraft) {
+        return &*newDraft;
+    }
+    if (preloaded) {
+        // All the stored drafts are already in memory.
+        return nullptr;
+    }
+    auto draft = getNewFromDb();
+    if (!draft) {
+        return nullptr;
+    }
+    // The draft is opened so it isn't read from the DB again.
+    newDraft = persistedState(draft->getTitle(), draft->getDescription());
+    return &*newDraft;
+}
+
+DraftsRepositoryImpl::DraftState &DraftsRepositoryImpl::openNew() {
+    auto state = findNew();
+    if (!state) {
+        // A new draft which isn't stored is equal to an empty one.
+        newDraft = persistedState(std::string(), std::string());
+        state = &*newDraft;
+    }
+    return *state;
+}
+
+DraftsRepositoryImpl::DraftState *DraftsRepositoryImpl::findExisting(int id) {
+    auto existingEntry = existingDrafts.find(id);
+    if (existingEntry != existingDrafts.end()) {
+        return &existingEntry->second;
+    }
+    if (preloaded) {
+        // All the stored drafts are already in memory.
+        return nullptr;
+    }
+    auto draft = getExistingFromDb(id);
+    if (!draft) {
+        return nullptr;
+    }
+    // The draft is opened so it isn't read from the DB again.
+    return &existingDrafts.emplace(id, persistedState(draft->getTitle(), draft->getDescription())).first->second;
+}
+
+DraftsRepositoryImpl::DraftState &DraftsRepositoryImpl::openExistingWithDescription(int id) {
+    auto state = findExisting(id);
+    if (!state || !state->draft.hasDescription()) {
+        // The description of the note isn't known, so the offset of the edit can't be applied.
+        THROW(IncompleteDraftException(id, state ? state->draft : MutableDraft()));
+    }
+    return *state;
+}
+
+DraftsRepositoryImpl::DraftState DraftsRepositoryImpl::persistedState(std::string title, std::string description) {
+    DraftState state;
+    state.draft.updateTitle(std::move(title));
+    state.draft.updateDescription(std::move(description));
+    state.persistedHash = state.draft.hash();
+    return state;
+}
+
+void DraftsRepositoryImpl::markExistingDirty(int id, DraftState &state) {
+    if (!state.dirty) {
+        state.dirty = true;
+        dirtyExistingIds.push_back(id);
+    }
+}
+
+void DraftsRepositoryImpl::logChange(DraftLog::Operation operation, int id, size_t offset, size_t count,
+                                     stdx::string_view text) {
+    if (log && !replaying) {
+        log->append(operation, id, offset, count, text);
+    }
+}
+
+size_t DraftsRepositoryImpl::logDeletion(DraftLog::Operation operation, int id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    // The deletion is logged before the drafts are deleted from the DB, so a crash after the deletion can't replay the
+    // previous changes of the drafts without deleting them again. Replaying a deletion has no effect if it's committed.
+    logChange(operation, id, 0, 0, stdx::string_view());
+    return log && !replaying ? log->position() : 0;
+}
+
+void DraftsRepositoryImpl::relogDeletion(DraftLog::Operation operation, int id, size_t logPosition) {
+    if (log && !replaying && log->position() != logPosition) {
+        // The drafts changed while they were deleted from the DB are deleted from memory too, so they are deleted by
+        // the replay as well.
+        logChange(operation, id, 0, 0, stdx::string_view());
+    }
+}
+
+void DraftsRepositoryImpl::markDirty(size_t bytes) {
+    if (flusher) {
+        flusher->markDirty(bytes);
+    }
+}
+
 void DraftsRepositoryImpl::persistNew(const MutableDraft &draft) {
     auto title = draft.requireTitle();
     auto description = draft.requireDescription();
     if (title.empty() && description.empty()) {
         // To reach this state, the user updated the title and/or the description and then he emptied them.
         // Therefore the draft should be deleted since an empty new draft is equally to a not initialized one.
-        deleteNew();
+        // The draft in memory isn't reset since it could have been changed again while this one is written.
+        db->createStatement("DELETE FROM pending_draft_creation")->execute<void>();
         return;
     }
 
@@ -168,7 +537,7 @@ void DraftsRepositoryImpl::persistNew(const MutableDraft &draft) {
     stmt->execute<void>();
 } // LCOV_EXCL_BR_LINE
 
-void DraftsRepositoryImpl::persistExisting(const std::map<int, MutableDraft> &drafts) {
+void DraftsRepositoryImpl::persistExisting(const std::vector<DraftWrite> &writes) {
     auto stmt = db->createStatement(
         "INSERT INTO pending_drafts_update (rowid, title, description) "
         "VALUES (?, ?, ?) "
@@ -176,21 +545,12 @@ void DraftsRepositoryImpl::persistExisting(const std::map<int, MutableDraft> &dr
         "DO UPDATE SET title = ?, description = ?"
     );
 
-#if __cpp_structured_bindings
-    for (auto const&[id, draft] : drafts) {
-#else
-        for (auto const& draftPair : drafts) {
-            auto id = draftPair.first;
-            auto draft = draftPair.second;
-#endif
-        if (draft.isIncomplete()) {
-            THROW(IncompleteDraftException(id, draft));
-        }
-
+    for (const auto &write : writes) {
+        const auto &draft = write.draft;
         auto title = draft.requireTitle();
         auto description = draft.requireDescription();
 
-        stmt->bind(1, id);
+        stmt->bind(1, write.id);
         stmt->bind(2, title);
         stmt->bind(3, description);
         stmt->bind(4, title);
@@ -200,6 +560,39 @@ void DraftsRepositoryImpl::persistExisting(const std::map<int, MutableDraft> &dr
     }
 }
 
+void DraftsRepositoryImpl::persistLogCheckpoint(const LogCheckpoint &checkpoint) {
+    auto stmt = db->createStatement(
+        "INSERT INTO draft_log_checkpoint (id, generation, position) "
+        "VALUES (0, ?, ?) "
+        "ON CONFLICT(id) "
+        "DO UPDATE SET generation = ?, position = ?"
+    );
+
+    auto generation = static_cast<long long>(checkpoint.generation);
+    auto position = static_cast<long long>(checkpoint.position);
+    stmt->bind(1, generation);
+    stmt->bind(2, position);
+    stmt->bind(3, generation);
+    stmt->bind(4, position);
+    stmt->execute<void>();
+} // LCOV_EXCL_BR_LINE
+
+stdx::optional<DraftsRepositoryImpl::LogCheckpoint> DraftsRepositoryImpl::getLogCheckpointFromDb() {
+    auto stmt = db->createStatement(
+        "SELECT generation, position "
+        "FROM draft_log_checkpoint "
+        "LIMIT 1"
+    );
+    auto checkpoint = stdx::optional<LogCheckpoint>();
+    auto cursor = stmt->execute<std::shared_ptr<Db::Cursor>>();
+    while (cursor->next()) {
+        auto generation = static_cast<uint64_t>(cursor->get<long long>(0));
+        auto position = static_cast<size_t>(cursor->get<long long>(1));
+        checkpoint = LogCheckpoint{generation, position};
+    }
+    return checkpoint;
+}
+
 stdx::optional<Draft> DraftsRepositoryImpl::getNewFromDb() {
     auto stmt = db->createStatement(
         "SELECT title, description "
@@ -234,41 +627,3 @@ stdx::optional<Draft> DraftsRepositoryImpl::getExistingFromDb(int id) {
     }
     return draft;
 } // LCOV_EXCL_BR_LINE
-
-stdx::optional<std::string> DraftsRepositoryImpl::getNewTitleFromDb() {
-    return db->createStatement(
-        "SELECT title "
-        "FROM pending_draft_creation "
-        "LIMIT 1"
-    )->execute<stdx::optional<std::string>>();
-}
-
-stdx::optional<std::string> DraftsRepositoryImpl::getNewDescriptionFromDb() {
-    return db->createStatement(
-        "SELECT description "
-        "FROM pending_draft_creation "
-        "LIMIT 1"
-    )->execute<stdx::optional<std::string>>();
-}
-
-stdx::optional<std::string> DraftsRepositoryImpl::getExistingTitleFromDb(int id) {
-    auto stmt = db->createStatement(
-        "SELECT title "
-        "FROM pending_drafts_update "
-        "WHERE rowid = ? "
-        "LIMIT 1"
-    );
-    stmt->bind(1, id);
-    return stmt->execute<stdx::optional<std::string>>();
-}
-
-stdx::optional<std::string> DraftsRepositoryImpl::getExistingDescriptionFromDb(int id) {
-    auto stmt = db->createStatement(
-        "SELECT description "
-        "FROM pending_drafts_update "
-        "WHERE rowid = ? "
-        "LIMIT 1"
-    );
-    stmt->bind(1, id);
-    return stmt->execute<stdx::optional<std::string>>();
-}
@@ -1,14 +1,43 @@
 #pragma once
 
-#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 #include "drafts_repository.hpp"
 #include "core/include_macros.hpp"
+#include "draft_flusher.hpp"
+#include "draft_log.hpp"
 #include "mutable_draft.hpp"
 #include AMALGAMATION(database.hpp)
-
+#include AMALGAMATION(draft_flush_policy.hpp)
+
+/**
+ * Keeps the opened drafts in memory, writing only the ones which changed since they were persisted.
+ * With a DraftFlushPolicy, they are persisted by a background thread (write-behind), so the drafts can be changed
+ * and read by another thread while they are written.
+ * When the drafts are preloaded, they are read from the DB in a single scan by the constructor, so the drafts are
+ * accessed only in memory after, assuming that the tables of the drafts are changed only by this repository.
+ * With a DraftLog, every change is appended to the log before it's persisted, so the changes lost by a crash are
+ * replayed by the next repository, which writes them in the tables of the drafts. The position of the log is written
+ * together with the drafts, so the changes already written aren't replayed again if the log wasn't truncated.
+ */
 class DraftsRepositoryImpl : public DraftsRepository {
    public:
-    explicit DraftsRepositoryImpl(std::shared_ptr<Db::Database> db);
+    /**
+     * The main constructor.
+     *
+     * @param db the database containing the drafts.
+     * @param flushPolicy defines when the drafts are persisted in background, or an empty optional to persist them
+     * only when persist() is invoked.
+     * @param preload true to read all the drafts from the DB immediately, false to read every draft when it's opened.
+     * @param logPath the path of the DraftLog which records the changes until they are persisted, or an empty optional
+     * to keep the changes only in memory.
+     */
+    explicit DraftsRepositoryImpl(std::shared_ptr<Db::Database> db,
+                                  stdx::optional<DraftFlushPolicy> flushPolicy = stdx::nullopt,
+                                  bool preload = false,
+                                  const stdx::optional<std::string> &logPath = stdx::nullopt);
 
     stdx::optional<Draft> getNew() override;
 
@@ -22,32 +51,179 @@ class DraftsRepositoryImpl : public DraftsRepository {
 
     void updateExistingDescription(int id, std::string description) override;
 
+    void insertInNewDescription(size_t offset, std::string text) override;
+
+    void eraseFromNewDescription(size_t offset, size_t count) override;
+
+    void insertInExistingDescription(int id, size_t offset, std::string text) override;
+
+    void eraseFromExistingDescription(int id, size_t offset, size_t count) override;
+
     void deleteNew() override;
 
     void deleteExisting(int id) override;
 
     void deleteAll() override;
 
+    /**
+     * Writes the changed drafts. With a DraftFlushPolicy, they are written by the background thread and this method
+     * waits until they are written.
+     */
     void persist() override;
 
+    /**
+     * @return the counters of the background writes, or an empty optional if there isn't a DraftFlushPolicy.
+     */
+    [[nodiscard]] stdx::optional<DraftFlusher::Stats> getFlushStats() const;
+
    private:
+    /**
+     * A draft opened in memory.
+     */
+    struct DraftState {
+        MutableDraft draft;
+        // True if the draft changed since it was persisted.
+        bool dirty = false;
+        // The hash of the draft stored in the DB, or an empty optional if it isn't known.
+        stdx::optional<size_t> persistedHash;
+    };
+
+    /**
+     * A copy of a changed draft which is written without holding the mutex.
+     */
+    struct DraftWrite {
+        int id;
+        MutableDraft draft;
+        size_t hash;
+    };
+
+    /**
+     * The position of the log until which the changes are stored in the tables of the drafts.
+     */
+    struct LogCheckpoint {
+        uint64_t generation;
+        size_t position;
+    };
+
     std::shared_ptr<Db::Database> db;
-    stdx::optional<MutableDraft> pendingNew;
-    std::map<int, MutableDraft> pendingExisting;
+    stdx::optional<DraftState> newDraft;
+    std::unordered_map<int, DraftState> existingDrafts;
+    // True if all the drafts stored in the DB are in memory, so a draft missing from memory doesn't exist.
+    bool preloaded = false;
+    // The ids of the existing drafts which changed since they were persisted, in the order of their first change.
+    std::vector<int> dirtyExistingIds;
+    // Guards the drafts in memory.
+    std::mutex mutex;
+    // Held while the drafts are written or deleted, so a deleted draft can't be written again by a running flush.
+    std::mutex persistMutex;
+    // The log of the changes which aren't persisted yet, guarded by the mutex.
+    std::unique_ptr<DraftLog> log;
+    // True while the changes of the log are replayed, so they aren't logged again.
+    bool replaying = false;
+    // It's declared last so it's destroyed first, flushing the last changes while the other members are still alive.
+    std::unique_ptr<DraftFlusher> flusher;
+
+    /**
+     * Writes the drafts which changed since they were persisted in a single transaction, skipping the ones which have
+     * the same text stored in the DB. The incomplete drafts are kept dirty in memory and in the log, without
+     * preventing the other drafts from being written, and an IncompleteDraftException is thrown after.
+     *
+     * @return the number of written drafts.
+     */
+    size_t writePending();
+
+    /**
+     * Applies the changes of the log, which weren't persisted before the previous repository was closed, and writes
+     * them in the tables of the drafts.
+     *
+     * @param checkpoint the checkpoint stored in the DB, whose changes are skipped if it's in the current generation.
+     */
+    void replayLog(const stdx::optional<LogCheckpoint> &checkpoint);
+
+    void replay(const DraftLog::Record &record);
+
+    /**
+     * Appends a change to the log, if any, before it's applied, so a change which can't be logged isn't applied.
+     * It must be invoked holding the mutex.
+     */
+    void logChange(DraftLog::Operation operation, int id, size_t offset, size_t count, stdx::string_view text);
+
+    /**
+     * Appends a deletion to the log before the drafts are deleted from the DB, holding the mutex only to append it.
+     *
+     * @return the position of the log after the deletion, passed to relogDeletion().
+     */
+    size_t logDeletion(DraftLog::Operation operation, int id);
+
+    /**
+     * Appends the deletion to the log again if other changes were logged after it, since they are dropped from memory.
+     * It must be invoked holding the mutex.
+     */
+    void relogDeletion(DraftLog::Operation operation, int id, size_t logPosition);
+
+    /**
+     * Reads all the drafts from the DB, the existing ones in a single scan of their table.
+     */
+    void preloadDrafts();
+
+    /**
+     * Gets the opened draft of the new note, reading it from the DB if it isn't opened yet.
+     * It must be invoked holding the mutex.
+     *
+     * @return the draft or nullptr if it doesn't exist.
+     */
+    DraftState *findNew();
+
+    /**
+     * Gets the opened draft of the new note, creating it empty if it doesn't exist.
+     * It must be invoked holding the mutex.
+     */
+    DraftState &openNew();
+
+    /**
+     * Gets the opened draft of an existing note, reading it from the DB if it isn't opened yet.
+     * It must be invoked holding the mutex.
+     *
+     * @return the draft or nullptr if it doesn't exist.
+     */
+    DraftState *findExisting(int id);
+
+    /**
+     * Gets the opened draft of an existing note which has a description, to edit it.
+     * It must be invoked holding the mutex.
+     */
+    DraftState &openExistingWithDescription(int id);
+
+    /**
+     * Creates a draft with the title and the description stored in the DB.
+     */
+    static DraftState persistedState(std::string title, std::string description);
+
+    /**
+     * Adds the draft of an existing note to the dirty set. It must be invoked holding the mutex.
+     */
+    void markExistingDirty(int id, DraftState &state);
+
+    /**
+     * Notifies the flusher, if any, that a draft changed.
+     */
+    void markDirty(size_t bytes);
 
     void persistNew(const MutableDraft &draft);
 
-    void persistExisting(const std::map<int, MutableDraft> &drafts);
+    void persistExisting(const std::vector<DraftWrite> &writes);
 
-    stdx::optional<Draft> getNewFromDb();
-
-    stdx::optional<Draft> getExistingFromDb(int id);
+    /**
+     * Stores the checkpoint of the log. It must be invoked in the transaction which writes the drafts.
+     */
+    void persistLogCheckpoint(const LogCheckpoint &checkpoint);
 
-    stdx::optional<std::string> getNewTitleFromDb();
+    stdx::optional<LogCheckpoint> getLogCheckpointFromDb();
 
-    stdx::optional<std::string> getNewDescriptionFromDb();
-
-    stdx::optional<std::string> getExistingTitleFromDb(int id);
+    stdx::optional<Draft> getNewFromDb();
 
-    stdx::optional<std::string> getExistingDescriptionFromDb(int id);
+    /**
+     * Reads the title and the description of the draft of an existing note with a single query.
+     */
+    stdx::optional<Draft> getExistingFromDb(int id);
 };
\ No newline at end of file
@@ -1,3 +1,4 @@
+#include <functional>
 #include "mutable_draft.hpp"
 #include "core/compat_bad_optional_access_exception.hpp"
 #include "incomplete_draft_exception.hpp"
@@ -14,15 +15,36 @@ std::string MutableDraft::requireDescription() const {
     if (!description) {
         THROW(CompatBadOptionalAccessException());
     }
-    return *description;
+    return description->toString();
 }
 
 void MutableDraft::updateTitle(std::string title) {
-    this->title = title;
+    this->title = std::move(title);
 }
 
 void MutableDraft::updateDescription(std::string description) {
-    this->description = description;
+    this->description = PieceTable(std::move(description));
+}
+
+void MutableDraft::insertInDescription(size_t offset, stdx::string_view text) {
+    if (!description) {
+        THROW(CompatBadOptionalAccessException());
+    }
+    description->insert(offset, text);
+}
+
+void MutableDraft::eraseFromDescription(size_t offset, size_t count) {
+    if (!description) {
+        THROW(CompatBadOptionalAccessException());
+    }
+    description->erase(offset, count);
+}
+
+void MutableDraft::checkDescriptionRange(size_t offset, size_t count) const {
+    if (!description) {
+        THROW(CompatBadOptionalAccessException());
+    }
+    description->checkRange(offset, count);
 }
 
 bool MutableDraft::hasTitle() const {
@@ -37,11 +59,19 @@ bool MutableDraft::isIncomplete() const {
     return !title || !description;
 }
 
-Draft MutableDraft::toDraft() {
+Draft MutableDraft::toDraft() const {
     if (isIncomplete()) {
         THROW(IncompleteDraftException(*this));
     }
-    return Draft(*title, *description);
+    return Draft(*title, description->toString());
+}
+
+std::size_t MutableDraft::hash() const {
+    // A missing field has a different hash than an empty one.
+    std::size_t titleHash = title ? std::hash<std::string>()(*title) : 0x9e3779b9;
+    std::size_t descriptionHash = description ? std::hash<std::string>()(description->toString()) : 0x9e3779b9;
+    // Combines the hashes so the drafts with the title and the description swapped have different hashes.
+    return titleHash ^ (descriptionHash + 0x9e3779b9 + (titleHash << 6) + (titleHash >> 2));
 }
 
 bool operator==(const MutableDraft &first, const MutableDraft &second) {
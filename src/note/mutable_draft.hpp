@@ -1,9 +1,12 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include "core/include_macros.hpp"
+#include "piece_table.hpp"
 #include AMALGAMATION(draft.hpp)
 #include AMALGAMATION(std_optional_compat.hpp)
+#include AMALGAMATION(std_string_view_compat.hpp)
 
 class MutableDraft {
    public:
@@ -15,17 +18,47 @@ class MutableDraft {
 
     void updateDescription(std::string description);
 
+    /**
+     * Inserts a text in the description without copying the rest of it.
+     *
+     * @param offset the offset of the insertion in bytes, from 0 to the size of the description.
+     * @param text the inserted text.
+     */
+    void insertInDescription(size_t offset, stdx::string_view text);
+
+    /**
+     * Deletes a range of the description without copying the rest of it.
+     *
+     * @param offset the offset of the first deleted byte.
+     * @param count the number of deleted bytes.
+     */
+    void eraseFromDescription(size_t offset, size_t count);
+
+    /**
+     * Checks that a range of the description can be edited, so an edit can be validated before it's logged.
+     *
+     * @param offset the offset of the first byte of the range.
+     * @param count the number of bytes of the range, 0 for an insertion.
+     */
+    void checkDescriptionRange(size_t offset, size_t count) const;
+
     bool hasTitle() const;
 
     bool hasDescription() const;
 
     bool isIncomplete() const;
 
-    Draft toDraft();
+    Draft toDraft() const;
+
+    /**
+     * @return a hash of the fields of the draft, used to know if it changed since it was written.
+     */
+    std::size_t hash() const;
 
     friend bool operator==(const MutableDraft &first, const MutableDraft &second);
 
    private:
     stdx::optional<std::string> title;
-    stdx::optional<std::string> description;
+    // The description is edited in place, since it can be much longer than the title.
+    stdx::optional<PieceTable> description;
 };
\ No newline at end of file
@@ -0,0 +1,168 @@
+#include "note_cache.hpp"
+
+/* PRIVATE */ namespace {
+
+// The estimated bytes of a node of std::map besides its value: three pointers, the color and the allocator header.
+const size_t mapNodeOverhead = 48;
+}
+
+double NoteCache::Stats::hitRatio() const {
+    auto reads = hits + misses;
+    if (reads == 0) {
+        return 0;
+    }
+    return static_cast<double>(hits) / static_cast<double>(reads);
+}
+
+NoteCache::NoteCache(size_t budget) : budget(budget) {
+    counters.budget = budget;
+}
+
+void NoteCache::validate(long long dataVersion) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (loaded && dataVersion != loadedDataVersion) {
+        counters.invalidations++;
+        unload();
+    }
+}
+
+unsigned long NoteCache::generation() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return changes;
+}
+
+void NoteCache::load(const std::vector<Note> &allNotes, long long dataVersion, unsigned long generation) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (generation != changes) {
+        // A note was changed while the notes were queried, so they are read from SQLite again by the next read.
+        return;
+    }
+    size_t bytes = 0;
+    for (const auto &note : allNotes) {
+        bytes += sizeOf(note);
+    }
+    if (bytes > budget) {
+        // The notes are read from SQLite until some of them are deleted.
+        unload();
+        return;
+    }
+    notes.clear();
+    for (const auto &note : allNotes) {
+        notes.emplace_hint(notes.end(), note.getId(), note);
+    }
+    loaded = true;
+    loadedDataVersion = dataVersion;
+    counters.bytes = bytes;
+}
+
+stdx::optional<std::vector<Note>> NoteCache::getAll() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!loaded) {
+        counters.misses++;
+        return stdx::nullopt;
+    }
+    counters.hits++;
+    std::vector<Note> cachedNotes;
+    cachedNotes.reserve(notes.size());
+    for (const auto &entry : notes) {
+        cachedNotes.push_back(entry.second);
+    }
+    return cachedNotes;
+} // LCOV_EXCL_BR_LINE
+
+stdx::optional<std::vector<Note>> NoteCache::getAll(const std::vector<int> &ids) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!loaded) {
+        counters.misses++;
+        return stdx::nullopt;
+    }
+    counters.hits++;
+    std::vector<Note> cachedNotes;
+    cachedNotes.reserve(ids.size());
+    for (int id : ids) {
+        auto cached = notes.find(id);
+        if (cached != notes.end()) {
+            cachedNotes.push_back(cached->second);
+        }
+    }
+    return cachedNotes;
+} // LCOV_EXCL_BR_LINE
+
+void NoteCache::countMiss() {
+    std::lock_guard<std::mutex> lock(mutex);
+    counters.misses++;
+}
+
+void NoteCache::put(const Note &note) {
+    std::lock_guard<std::mutex> lock(mutex);
+    changes++;
+    if (!loaded) {
+        return;
+    }
+    auto cached = notes.find(note.getId());
+    if (cached != notes.end()) {
+        counters.bytes -= sizeOf(cached->second);
+        cached->second = note;
+    } else {
+        notes.emplace(note.getId(), note);
+    }
+    counters.bytes += sizeOf(note);
+    if (counters.bytes > budget) {
+        unload();
+    }
+}
+
+void NoteCache::replace(const Note &note) {
+    std::lock_guard<std::mutex> lock(mutex);
+    changes++;
+    auto cached = notes.find(note.getId());
+    if (cached == notes.end()) {
+        return;
+    }
+    counters.bytes = counters.bytes - sizeOf(cached->second) + sizeOf(note);
+    cached->second = note;
+    if (counters.bytes > budget) {
+        unload();
+    }
+}
+
+void NoteCache::remove(int id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    changes++;
+    auto cached = notes.find(id);
+    if (cached == notes.end()) {
+        return;
+    }
+    counters.bytes -= sizeOf(cached->second);
+    notes.erase(cached);
+}
+
+void NoteCache::removeAll() {
+    std::lock_guard<std::mutex> lock(mutex);
+    changes++;
+    if (!loaded) {
+        return;
+    }
+    notes.clear();
+    counters.bytes = 0;
+}
+
+bool NoteCache::isLoaded() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return loaded;
+}
+
+NoteCache::Stats NoteCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters;
+}
+
+size_t NoteCache::sizeOf(const Note &note) {
+    return mapNodeOverhead + sizeof(int) + sizeof(Note) + note.getTitle().size() + note.getDescription().size();
+}
+
+void NoteCache::unload() {
+    notes.clear();
+    loaded = false;
+    counters.bytes = 0;
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <vector>
+#include "core/include_macros.hpp"
+#include AMALGAMATION(note.hpp)
+#include AMALGAMATION(std_optional_compat.hpp)
+
+/**
+ * In-memory copy of the whole table of the notes, keyed by their rowid, used to read them without querying SQLite.
+ * The copy holds all the notes or none of them, so a note missing from a loaded cache doesn't exist.
+ * It's dropped when the notes don't fit in its budget anymore or when another connection changes the database, which
+ * is detected comparing the PRAGMA data_version of the writer connection with the one read when the cache was loaded.
+ * It can be used by multiple threads.
+ */
+class NoteCache {
+   public:
+    /**
+     * The counters collected by the cache since its creation.
+     */
+    struct Stats {
+        // Number of reads served by the cache.
+        unsigned long hits;
+        // Number of reads which queried SQLite because the cache wasn't loaded.
+        unsigned long misses;
+        // Number of times the cache was dropped because another connection changed the database.
+        unsigned long invalidations;
+        // Estimated number of bytes used by the cached notes.
+        size_t bytes;
+        // The maximum number of bytes which can be used by the cached notes.
+        size_t budget;
+
+        /**
+         * @return the fraction of the reads served by the cache, or 0 if there weren't any reads.
+         */
+        [[nodiscard]] double hitRatio() const;
+    };
+
+    /**
+     * The main constructor.
+     *
+     * @param budget the maximum number of bytes used by the cached notes.
+     */
+    explicit NoteCache(size_t budget);
+
+    /**
+     * Drops the cached notes if the database was changed by another connection after they were loaded.
+     *
+     * @param dataVersion the current PRAGMA data_version of the writer connection.
+     */
+    void validate(long long dataVersion);
+
+    /**
+     * Gets the number of changes applied to the cache, loaded or not, by put(), replace(), remove() and removeAll().
+     * It must be read before querying the notes passed to load().
+     */
+    [[nodiscard]] unsigned long generation() const;
+
+    /**
+     * Caches all the notes of the table, if they fit in the budget and the cache wasn't changed while they were
+     * queried, since the change could be missing from them.
+     *
+     * @param notes all the notes of the table, sorted by rowid.
+     * @param dataVersion the PRAGMA data_version of the writer connection read before querying the notes.
+     * @param generation the generation() read before querying the notes.
+     */
+    void load(const std::vector<Note> &notes, long long dataVersion, unsigned long generation);
+
+    /**
+     * Gets all the cached notes, sorted by rowid.
+     *
+     * @return the cached notes or an empty optional if the cache isn't loaded.
+     */
+    stdx::optional<std::vector<Note>> getAll();
+
+    /**
+     * Gets the cached notes with the given rowids, skipping the rowids which don't exist.
+     *
+     * @param ids the rowids of the notes, in the order of the returned notes.
+     * @return the cached notes or an empty optional if the cache isn't loaded.
+     */
+    stdx::optional<std::vector<Note>> getAll(const std::vector<int> &ids);
+
+    /**
+     * Counts a read which queried SQLite without asking the cache, because it wasn't loaded.
+     */
+    void countMiss();
+
+    /**
+     * Adds a note or replaces the cached note with the same id, if the cache is loaded.
+     */
+    void put(const Note &note);
+
+    /**
+     * Replaces the cached note with the same id, if it exists.
+     */
+    void replace(const Note &note);
+
+    /**
+     * Removes the note with the given id, if it exists.
+     */
+    void remove(int id);
+
+    /**
+     * Removes all the notes, keeping the cache loaded since the table is empty.
+     */
+    void removeAll();
+
+    [[nodiscard]] bool isLoaded() const;
+
+    [[nodiscard]] Stats stats() const;
+
+   private:
+    size_t budget;
+    bool loaded = false;
+    long long loadedDataVersion = 0;
+    unsigned long changes = 0;
+    std::map<int, Note> notes;
+    Stats counters{};
+    mutable std::mutex mutex;
+
+    /**
+     * Estimates the bytes used by a cached note, including its strings and its node of the map.
+     */
+    static size_t sizeOf(const Note &note);
+
+    /**
+     * Drops the cached notes. It must be invoked holding the mutex.
+     */
+    void unload();
+};
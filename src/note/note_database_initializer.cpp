@@ -7,9 +7,33 @@
 
 namespace NoteDb {
 
-void initialize(std::string path) {
+/* PRIVATE */ namespace {
+
+// The maximum number of notes copied by each transaction of the migration to the dates in seconds.
+const int epochMigrationChunkSize = 1000;
+
+void createSchema(const std::shared_ptr<Db::Database> &db);
+
+void createNotesTable(const std::shared_ptr<Db::Database> &db, const std::string &name);
+
+void createSubstringIndex(const std::shared_ptr<Db::Database> &db);
+
+void createSubstringIndexTriggers(const std::shared_ptr<Db::Database> &db);
+
+void dropWordIndex(const std::shared_ptr<Db::Database> &db);
+
+void createRecencyIndex(const std::shared_ptr<Db::Database> &db);
+
+void createDraftLogCheckpointTable(const std::shared_ptr<Db::Database> &db);
+
+void copyNotesWithEpochDates(const std::shared_ptr<Db::Database> &db);
+
+void replaceNotesTable(const std::shared_ptr<Db::Database> &db);
+}
+
+void initialize(std::string path, const Db::Options &options) {
     // Create the database.
-    Db::Client::create(std::move(path));
+    Db::Client::create(std::move(path), options);
     // Obtain the database instance.
     auto db = Db::Client::get();
 
@@ -27,16 +51,41 @@ void initialize(std::string path) {
             std::to_string(version)));
     }
 
+    if (currentVersion > 0 && currentVersion < 6) {
+        std::cout << "Copying the notes with the last update dates in seconds" << std::endl;
+        // The notes are copied in short transactions, so a large database doesn't hold the write lock for long.
+        copyNotesWithEpochDates(db);
+    }
+
     db->executeTransaction([&] {
         if (currentVersion == 0) {
             std::cout << "Creating the database schema" << std::endl;
             // Create the database schema.
             createSchema(db);
         }
+        if (currentVersion == 3) {
+            // The word index of the version 3 is replaced by the substring index.
+            dropWordIndex(db);
+        }
+        if (currentVersion < 4) {
+            std::cout << "Creating the substring index of the notes" << std::endl;
+            createSubstringIndex(db);
+        }
+        if (currentVersion > 0 && currentVersion < 6) {
+            replaceNotesTable(db);
+        }
+        if (currentVersion < 6) {
+            // The index of the version 5 was dropped together with the table containing the dates as text.
+            std::cout << "Creating the index of the notes by last update date" << std::endl;
+            createRecencyIndex(db);
+        }
+        if (currentVersion > 0 && currentVersion < 7) {
+            createDraftLogCheckpointTable(db);
+        }
 
         auto writeVersionStmt = db->createStatement("PRAGMA user_version = " + std::to_string(version));
         writeVersionStmt->execute<void>();
-    });
+    }, Db::TransactionMode::Immediate);
 } // LCOV_EXCL_BR_LINE
 
 /* PRIVATE */ namespace {
@@ -48,13 +97,7 @@ void initialize(std::string path) {
  * @param db the database instance used to create the statements.
  */
 void createSchema(const std::shared_ptr<Db::Database> &db) {
-    db->createStatement(
-        "CREATE TABLE notes ("
-        "title TEXT NOT NULL, "
-        "description TEXT NOT NULL, "
-        "last_update_date TEXT NOT NULL"
-        ")"
-    )->execute<void>();
+    createNotesTable(db, "notes");
 
     db->createStatement(
         "CREATE TABLE pending_drafts_update ("
@@ -70,6 +113,177 @@ void createSchema(const std::shared_ptr<Db::Database> &db) {
         "description TEXT NOT NULL"
         ")"
     )->execute<void>();
+
+    createDraftLogCheckpointTable(db);
+}
+
+/**
+ * Creates a table of the notes, whose last update dates are stored as seconds since the epoch.
+ * The id is an alias of the rowid, so the ids of the notes and the rowids of the substring index aren't changed by a
+ * VACUUM.
+ *
+ * @param db the database instance used to create the statements.
+ * @param name the name of the table.
+ */
+void createNotesTable(const std::shared_ptr<Db::Database> &db, const std::string &name) {
+    db->createStatement(
+        "CREATE TABLE IF NOT EXISTS " + name + " ("
+        "id INTEGER PRIMARY KEY, "
+        "title TEXT NOT NULL, "
+        "description TEXT NOT NULL, "
+        "last_update_date INTEGER NOT NULL"
+        ")"
+    )->execute<void>();
+}
+
+/**
+ * Creates the FTS5 index of all the substrings of at least 3 characters contained in the titles and the descriptions of
+ * the notes, filling it with the existing notes.
+ * The index doesn't store a copy of the notes, which are read from the table "notes" (external content), and it's kept
+ * in sync with the table by the triggers.
+ * This method runs in a database transaction.
+ *
+ * @param db the database instance used to create the statements.
+ */
+void createSubstringIndex(const std::shared_ptr<Db::Database> &db) {
+    db->createStatement(
+        "CREATE VIRTUAL TABLE notes_trigram USING fts5("
+        "title, "
+        "description, "
+        "content = 'notes', "
+        "content_rowid = 'rowid', "
+        "tokenize = 'substring_trigram'"
+        ")"
+    )->execute<void>();
+
+    createSubstringIndexTriggers(db);
+
+    // Index the notes created before the migration.
+    db->createStatement("INSERT INTO notes_trigram (notes_trigram) VALUES ('rebuild')")->execute<void>();
+}
+
+/**
+ * Creates the triggers which keep the substring index in sync with the table "notes".
+ * This method runs in a database transaction.
+ *
+ * @param db the database instance used to create the statements.
+ */
+void createSubstringIndexTriggers(const std::shared_ptr<Db::Database> &db) {
+    db->createStatement(
+        "CREATE TRIGGER notes_trigram_after_insert AFTER INSERT ON notes BEGIN "
+        "INSERT INTO notes_trigram (rowid, title, description) VALUES (new.rowid, new.title, new.description); "
+        "END"
+    )->execute<void>();
+
+    // An external content index can remove a row only if it receives the values which were indexed.
+    db->createStatement(
+        "CREATE TRIGGER notes_trigram_after_delete AFTER DELETE ON notes BEGIN "
+        "INSERT INTO notes_trigram (notes_trigram, rowid, title, description) "
+        "VALUES ('delete', old.rowid, old.title, old.description); "
+        "END"
+    )->execute<void>();
+
+    db->createStatement(
+        "CREATE TRIGGER notes_trigram_after_update AFTER UPDATE OF title, description ON notes BEGIN "
+        "INSERT INTO notes_trigram (notes_trigram, rowid, title, description) "
+        "VALUES ('delete', old.rowid, old.title, old.description); "
+        "INSERT INTO notes_trigram (rowid, title, description) VALUES (new.rowid, new.title, new.description); "
+        "END"
+    )->execute<void>();
+}
+
+/**
+ * Drops the FTS5 word index created by the version 3 of the schema, together with the triggers updating it.
+ * This method runs in a database transaction.
+ *
+ * @param db the database instance used to create the statements.
+ */
+void dropWordIndex(const std::shared_ptr<Db::Database> &db) {
+    db->createStatement("DROP TRIGGER IF EXISTS notes_fts_after_insert")->execute<void>();
+    db->createStatement("DROP TRIGGER IF EXISTS notes_fts_after_delete")->execute<void>();
+    db->createStatement("DROP TRIGGER IF EXISTS notes_fts_after_update")->execute<void>();
+    db->createStatement("DROP TABLE IF EXISTS notes_fts")->execute<void>();
+}
+
+/**
+ * Creates the index of the notes by last update date, used to read them from the most recent one.
+ * The index is sorted by rowid too, since each of its entries ends with the rowid.
+ * This method runs in a database transaction.
+ *
+ * @param db the database instance used to create the statements.
+ */
+void createRecencyIndex(const std::shared_ptr<Db::Database> &db) {
+    db->createStatement("CREATE INDEX notes_last_update_date ON notes (last_update_date)")->execute<void>();
+}
+
+/**
+ * Creates the table containing the position of the DraftLog written together with the drafts, so the changes which
+ * are already stored in the tables of the drafts aren't replayed again.
+ * This method runs in a database transaction.
+ *
+ * @param db the database instance used to create the statements.
+ */
+void createDraftLogCheckpointTable(const std::shared_ptr<Db::Database> &db) {
+    db->createStatement(
+        "CREATE TABLE draft_log_checkpoint ("
+        "id INTEGER PRIMARY KEY CHECK (id = 0), "
+        "generation INTEGER NOT NULL, "
+        "position INTEGER NOT NULL"
+        ")"
+    )->execute<void>();
+}
+
+/**
+ * Copies the notes to the table "notes_epoch", converting their last update dates from ISO-8601 to seconds since the
+ * epoch, with a transaction for each chunk of notes.
+ * The copy restarts after the last copied note, so a migration which was interrupted isn't repeated from the start.
+ * The notes mustn't be updated or deleted until the migration ends, which is true since it runs before initialize()
+ * returns the database to the repositories.
+ *
+ * @param db the database instance used to create the statements.
+ */
+void copyNotesWithEpochDates(const std::shared_ptr<Db::Database> &db) {
+    db->executeTransaction([&] {
+        createNotesTable(db, "notes_epoch");
+    }, Db::TransactionMode::Immediate);
+
+    int copiedNotes;
+    do {
+        db->executeTransaction([&] {
+            auto stmt = db->createStatement(
+                "INSERT INTO notes_epoch (id, title, description, last_update_date) "
+                "SELECT rowid, title, description, CAST(strftime('%s', last_update_date) AS INTEGER) "
+                "FROM notes "
+                "WHERE rowid > (SELECT coalesce(max(id), 0) FROM notes_epoch) "
+                "ORDER BY rowid "
+                "LIMIT ?"
+            );
+            stmt->bind(1, epochMigrationChunkSize);
+            stmt->execute<void>();
+            copiedNotes = stmt->changes();
+        }, Db::TransactionMode::Immediate);
+    } while (copiedNotes == epochMigrationChunkSize);
+}
+
+/**
+ * Replaces the table "notes" containing the dates as text with the table "notes_epoch" filled by
+ * copyNotesWithEpochDates(), keeping the rowids as ids, so the substring index doesn't need to be rebuilt.
+ * This method runs in a database transaction.
+ *
+ * @param db the database instance used to create the statements.
+ */
+void replaceNotesTable(const std::shared_ptr<Db::Database> &db) {
+    // The notes inserted after the last chunk are copied in this transaction.
+    db->createStatement(
+        "INSERT INTO notes_epoch (id, title, description, last_update_date) "
+        "SELECT rowid, title, description, CAST(strftime('%s', last_update_date) AS INTEGER) "
+        "FROM notes "
+        "WHERE rowid > (SELECT coalesce(max(id), 0) FROM notes_epoch)"
+    )->execute<void>();
+    // The triggers and the index of the table are dropped with it.
+    db->createStatement("DROP TABLE notes")->execute<void>();
+    db->createStatement("ALTER TABLE notes_epoch RENAME TO notes")->execute<void>();
+    createSubstringIndexTriggers(db);
 }
 }
 }
@@ -0,0 +1,53 @@
+#include "core/include_macros.hpp"
+#include AMALGAMATION(note_match.hpp)
+
+NoteMatch::NoteMatch(int id,
+                     std::string title,
+                     std::string snippet,
+                     std::vector<Range> titleMatches,
+                     std::vector<Range> snippetMatches,
+                     std::time_t lastUpdateDate) {
+    this->id = id;
+    this->title = std::move(title);
+    this->snippet = std::move(snippet);
+    this->titleMatches = std::move(titleMatches);
+    this->snippetMatches = std::move(snippetMatches);
+    this->lastUpdateDate = lastUpdateDate;
+}
+
+int NoteMatch::getId() const {
+    return id;
+}
+
+std::string NoteMatch::getTitle() const {
+    return title;
+}
+
+std::string NoteMatch::getSnippet() const {
+    return snippet;
+}
+
+std::vector<NoteMatch::Range> NoteMatch::getTitleMatches() const {
+    return titleMatches;
+}
+
+std::vector<NoteMatch::Range> NoteMatch::getSnippetMatches() const {
+    return snippetMatches;
+}
+
+std::time_t NoteMatch::getLastUpdateTime() const {
+    return lastUpdateDate;
+}
+
+bool operator==(const NoteMatch::Range &first, const NoteMatch::Range &second) {
+    return first.start == second.start && first.length == second.length;
+}
+
+bool operator==(const NoteMatch &first, const NoteMatch &second) {
+    return first.id == second.id &&
+        first.title == second.title &&
+        first.snippet == second.snippet &&
+        first.titleMatches == second.titleMatches &&
+        first.snippetMatches == second.snippetMatches &&
+        difftime(first.lastUpdateDate, second.lastUpdateDate) == 0;
+}
@@ -0,0 +1,32 @@
+#include "core/include_macros.hpp"
+#include AMALGAMATION(note_summary.hpp)
+
+NoteSummary::NoteSummary(int id, std::string title, std::string snippet, std::time_t lastUpdateDate) {
+    this->id = id;
+    this->title = std::move(title);
+    this->snippet = std::move(snippet);
+    this->lastUpdateDate = lastUpdateDate;
+}
+
+int NoteSummary::getId() const {
+    return id;
+}
+
+std::string NoteSummary::getTitle() const {
+    return title;
+}
+
+std::string NoteSummary::getSnippet() const {
+    return snippet;
+}
+
+std::time_t NoteSummary::getLastUpdateTime() const {
+    return lastUpdateDate;
+}
+
+bool operator==(const NoteSummary &first, const NoteSummary &second) {
+    return first.id == second.id &&
+        first.title == second.title &&
+        first.snippet == second.snippet &&
+        difftime(first.lastUpdateDate, second.lastUpdateDate) == 0;
+}
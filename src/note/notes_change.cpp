@@ -0,0 +1,26 @@
+#include "core/include_macros.hpp"
+#include AMALGAMATION(notes_change.hpp)
+
+NotesChange::NotesChange(std::vector<int> insertedIds, std::vector<int> updatedIds, std::vector<int> deletedIds) {
+    this->insertedIds = std::move(insertedIds);
+    this->updatedIds = std::move(updatedIds);
+    this->deletedIds = std::move(deletedIds);
+}
+
+std::vector<int> NotesChange::getInsertedIds() const {
+    return insertedIds;
+}
+
+std::vector<int> NotesChange::getUpdatedIds() const {
+    return updatedIds;
+}
+
+std::vector<int> NotesChange::getDeletedIds() const {
+    return deletedIds;
+}
+
+bool operator==(const NotesChange &first, const NotesChange &second) {
+    return first.insertedIds == second.insertedIds &&
+        first.updatedIds == second.updatedIds &&
+        first.deletedIds == second.deletedIds;
+}
@@ -4,8 +4,11 @@
 #include "drafts_repository_factory.hpp"
 #include AMALGAMATION(notes_interactor_factory.hpp)
 
-std::shared_ptr<NotesInteractor> NotesInteractorFactory::create() {
-    auto notesRepository = NotesRepositoryFactory::create();
-    auto draftsRepository = DraftsRepositoryFactory::create();
+std::shared_ptr<NotesInteractor> NotesInteractorFactory::create(size_t noteCacheBudget,
+                                                                stdx::optional<DraftFlushPolicy> draftFlushPolicy,
+                                                                bool preloadDrafts,
+                                                                const stdx::optional<std::string> &draftLogPath) {
+    auto notesRepository = NotesRepositoryFactory::create(noteCacheBudget);
+    auto draftsRepository = DraftsRepositoryFactory::create(draftFlushPolicy, preloadDrafts, draftLogPath);
     return std::make_shared<NotesInteractorImpl>(notesRepository, draftsRepository);
 }
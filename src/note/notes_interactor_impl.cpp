@@ -6,26 +6,48 @@ NotesInteractorImpl::NotesInteractorImpl(std::shared_ptr<NotesRepository> notesR
     notesRepository(std::move(notesRepository)),
     draftsRepository(std::move(draftsRepository)) {}
 
-void NotesInteractorImpl::insertNote(Draft note) {
-    notesRepository->insert(note);
+Note NotesInteractorImpl::insertNote(Draft note) {
+    auto insertedNote = notesRepository->insert(std::move(note));
     // The draft isn't needed anymore if the note is saved.
     deleteNewDraft();
+    return insertedNote;
 }
 
-void NotesInteractorImpl::updateNote(int id, Draft note) {
-    notesRepository->update(id, note);
+stdx::optional<Note> NotesInteractorImpl::updateNote(int id, Draft note) {
+    auto updatedNote = notesRepository->update(id, std::move(note));
     // The draft isn't needed anymore if the note is saved.
     draftsRepository->deleteExisting(id);
+    return updatedNote;
 }
 
 std::vector<Note> NotesInteractorImpl::getAllNotes() {
     return notesRepository->getAll();
 }
 
+NotesPage NotesInteractorImpl::getNotesPage(size_t size, stdx::optional<NotesPage::Key> after) {
+    return notesRepository->getPage(size, std::move(after));
+}
+
+void NotesInteractorImpl::forEachNote(const std::function<void(Note)> &consumer) {
+    notesRepository->forEach(consumer);
+}
+
+std::vector<NoteSummary> NotesInteractorImpl::getNoteSummaries() {
+    return notesRepository->getSummaries();
+}
+
+stdx::optional<Note> NotesInteractorImpl::getNoteById(int id) {
+    return notesRepository->getById(id);
+}
+
 std::vector<Note> NotesInteractorImpl::getNotesByText(std::string text) {
     return notesRepository->getByText(text);
 }
 
+std::vector<NoteMatch> NotesInteractorImpl::getNotesByText(std::string text, size_t limit) {
+    return notesRepository->getRankedByText(text, limit);
+}
+
 stdx::optional<Draft> NotesInteractorImpl::getNewDraft() {
     return draftsRepository->getNew();
 }
@@ -35,19 +57,35 @@ stdx::optional<Draft> NotesInteractorImpl::getExistingDraft(int id) {
 }
 
 void NotesInteractorImpl::updateNewDraftTitle(std::string title) {
-    draftsRepository->updateNewTitle(title);
+    draftsRepository->updateNewTitle(std::move(title));
 }
 
 void NotesInteractorImpl::updateNewDraftDescription(std::string description) {
-    draftsRepository->updateNewDescription(description);
+    draftsRepository->updateNewDescription(std::move(description));
 }
 
 void NotesInteractorImpl::updateExistingDraftTitle(int id, std::string title) {
-    draftsRepository->updateExistingTitle(id, title);
+    draftsRepository->updateExistingTitle(id, std::move(title));
 }
 
 void NotesInteractorImpl::updateExistingDraftDescription(int id, std::string description) {
-    draftsRepository->updateExistingDescription(id, description);
+    draftsRepository->updateExistingDescription(id, std::move(description));
+}
+
+void NotesInteractorImpl::insertInNewDraftDescription(size_t offset, std::string text) {
+    draftsRepository->insertInNewDescription(offset, std::move(text));
+}
+
+void NotesInteractorImpl::eraseFromNewDraftDescription(size_t offset, size_t count) {
+    draftsRepository->eraseFromNewDescription(offset, count);
+}
+
+void NotesInteractorImpl::insertInExistingDraftDescription(int id, size_t offset, std::string text) {
+    draftsRepository->insertInExistingDescription(id, offset, std::move(text));
+}
+
+void NotesInteractorImpl::eraseFromExistingDraftDescription(int id, size_t offset, size_t count) {
+    draftsRepository->eraseFromExistingDescription(id, offset, count);
 }
 
 void NotesInteractorImpl::deleteNote(int id) {
@@ -67,3 +105,11 @@ void NotesInteractorImpl::deleteExistingDraft(int id) {
 void NotesInteractorImpl::persistChanges() {
     draftsRepository->persist();
 }
+
+int NotesInteractorImpl::subscribe(std::function<void(NotesChange)> listener) {
+    return notesRepository->subscribe(std::move(listener));
+}
+
+void NotesInteractorImpl::unsubscribe(int subscriptionId) {
+    notesRepository->unsubscribe(subscriptionId);
+}
@@ -11,14 +11,24 @@ class NotesInteractorImpl : public NotesInteractor {
     NotesInteractorImpl(std::shared_ptr<NotesRepository> notesRepository,
                         std::shared_ptr<DraftsRepository> draftsRepository);
 
-    void insertNote(Draft note) override;
+    Note insertNote(Draft note) override;
 
-    void updateNote(int id, Draft note) override;
+    stdx::optional<Note> updateNote(int id, Draft note) override;
 
     std::vector<Note> getAllNotes() override;
 
+    NotesPage getNotesPage(size_t size, stdx::optional<NotesPage::Key> after) override;
+
+    void forEachNote(const std::function<void(Note)> &consumer) override;
+
+    std::vector<NoteSummary> getNoteSummaries() override;
+
+    stdx::optional<Note> getNoteById(int id) override;
+
     std::vector<Note> getNotesByText(std::string text) override;
 
+    std::vector<NoteMatch> getNotesByText(std::string text, size_t limit) override;
+
     stdx::optional<Draft> getNewDraft() override;
 
     stdx::optional<Draft> getExistingDraft(int id) override;
@@ -31,6 +41,14 @@ class NotesInteractorImpl : public NotesInteractor {
 
     void updateExistingDraftDescription(int id, std::string description) override;
 
+    void insertInNewDraftDescription(size_t offset, std::string text) override;
+
+    void eraseFromNewDraftDescription(size_t offset, size_t count) override;
+
+    void insertInExistingDraftDescription(int id, size_t offset, std::string text) override;
+
+    void eraseFromExistingDraftDescription(int id, size_t offset, size_t count) override;
+
     void deleteNote(int id) override;
 
     void deleteNewDraft() override;
@@ -39,6 +57,10 @@ class NotesInteractorImpl : public NotesInteractor {
 
     void persistChanges() override;
 
+    int subscribe(std::function<void(NotesChange)> listener) override;
+
+    void unsubscribe(int subscriptionId) override;
+
    private:
     std::shared_ptr<NotesRepository> notesRepository;
     std::shared_ptr<DraftsRepository> draftsRepository;
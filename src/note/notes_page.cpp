@@ -0,0 +1,36 @@
+#include "core/include_macros.hpp"
+#include AMALGAMATION(notes_page.hpp)
+
+NotesPage::Key::Key(std::time_t lastUpdateDate, int id) {
+    this->lastUpdateDate = lastUpdateDate;
+    this->id = id;
+}
+
+std::time_t NotesPage::Key::getLastUpdateTime() const {
+    return lastUpdateDate;
+}
+
+int NotesPage::Key::getId() const {
+    return id;
+}
+
+NotesPage::NotesPage(std::vector<Note> notes, stdx::optional<Key> nextKey) {
+    this->notes = std::move(notes);
+    this->nextKey = std::move(nextKey);
+}
+
+std::vector<Note> NotesPage::getNotes() const {
+    return notes;
+}
+
+stdx::optional<NotesPage::Key> NotesPage::getNextKey() const {
+    return nextKey;
+}
+
+bool operator==(const NotesPage::Key &first, const NotesPage::Key &second) {
+    return first.id == second.id && difftime(first.lastUpdateDate, second.lastUpdateDate) == 0;
+}
+
+bool operator==(const NotesPage &first, const NotesPage &second) {
+    return first.notes == second.notes && first.nextKey == second.nextKey;
+}
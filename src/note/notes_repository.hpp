@@ -1,22 +1,76 @@
 #pragma once
 
+#include <functional>
 #include <string>
 #include <vector>
 #include "core/include_macros.hpp"
 #include AMALGAMATION(draft.hpp)
 #include AMALGAMATION(note.hpp)
+#include AMALGAMATION(note_match.hpp)
+#include AMALGAMATION(note_summary.hpp)
+#include AMALGAMATION(notes_change.hpp)
+#include AMALGAMATION(notes_page.hpp)
+#include AMALGAMATION(std_optional_compat.hpp)
 
 class NotesRepository {
    public:
-    virtual void insert(Draft note) = 0;
+    /**
+     * Inserts a note with the given title and description, updated now.
+     *
+     * @return the inserted note, with its id and its last update date.
+     */
+    virtual Note insert(Draft note) = 0;
 
     virtual void deleteWithId(int id) = 0;
 
-    virtual void update(int id, Draft note) = 0;
+    /**
+     * Replaces the title and the description of a note, updating it now.
+     *
+     * @return the updated note or an empty optional if it doesn't exist.
+     */
+    virtual stdx::optional<Note> update(int id, Draft note) = 0;
 
     virtual void deleteAll() = 0;
 
     virtual std::vector<Note> getAll() = 0;
 
+    /**
+     * Gets the notes after the given key, from the most recently updated one.
+     *
+     * @param size the maximum number of notes in the page.
+     * @param after the key of the previous page, or an empty optional to get the first page.
+     * @return the page, with the key of the next one if there are other notes.
+     */
+    virtual NotesPage getPage(size_t size, stdx::optional<NotesPage::Key> after) = 0;
+
+    /**
+     * Passes the notes to the given consumer while they are read, from the most recently updated one.
+     */
+    virtual void forEach(const std::function<void(Note)> &consumer) = 0;
+
+    /**
+     * Gets the summaries of all the notes, from the most recently updated one, without reading their descriptions
+     * after the snippet.
+     */
+    virtual std::vector<NoteSummary> getSummaries() = 0;
+
+    /**
+     * Gets the note with the given id, with its whole description.
+     *
+     * @return the note or an empty optional if it doesn't exist.
+     */
+    virtual stdx::optional<Note> getById(int id) = 0;
+
     virtual std::vector<Note> getByText(std::string text) = 0;
+
+    virtual std::vector<NoteMatch> getRankedByText(std::string text, size_t limit) = 0;
+
+    /**
+     * Registers a listener notified after the commits which changed the notes, on the thread which committed.
+     *
+     * @return the id used to unsubscribe the listener.
+     */
+    virtual int subscribe(std::function<void(NotesChange)> listener) = 0;
+
+    virtual void unsubscribe(int subscriptionId) = 0;
 };
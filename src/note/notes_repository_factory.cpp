@@ -4,8 +4,8 @@
 #include "time/clock_impl.hpp"
 #include AMALGAMATION(database_client.hpp)
 
-std::shared_ptr<NotesRepository> NotesRepositoryFactory::create() {
+std::shared_ptr<NotesRepository> NotesRepositoryFactory::create(size_t cacheBudget) {
     auto db = Db::Client::get();
     auto clock = std::make_shared<Time::ClockImpl>();
-    return std::make_shared<NotesRepositoryImpl>(db, clock);
+    return std::make_shared<NotesRepositoryImpl>(db, clock, cacheBudget);
 }
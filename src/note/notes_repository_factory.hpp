@@ -5,5 +5,10 @@
 
 class NotesRepositoryFactory {
    public:
-    static std::shared_ptr<NotesRepository> create();
+    /**
+     * Creates the repository of the notes stored in the database of Db::Client.
+     *
+     * @param cacheBudget the maximum number of bytes of the notes cached in memory. When it's 0, they aren't cached.
+     */
+    static std::shared_ptr<NotesRepository> create(size_t cacheBudget = 0);
 };
\ No newline at end of file
@@ -1,79 +1,475 @@
+#include <algorithm>
+#include <climits>
 #include "core/include_macros.hpp"
 #include "notes_repository_impl.hpp"
-#include AMALGAMATION(time_format.hpp)
 #include AMALGAMATION(database_cursor.hpp)
 
-NotesRepositoryImpl::NotesRepositoryImpl(std::shared_ptr<Db::Database> db, std::shared_ptr<Time::Clock> clock)
-    : db(std::move(db)), clock(std::move(clock)) {}
+/* PRIVATE */ namespace {
 
-void NotesRepositoryImpl::insert(Draft draftNote) {
-    auto movedDraftNote = std::move(draftNote);
-    auto stmt = db->createStatement("INSERT INTO notes (title, description, last_update_date) "
-                                    "VALUES (?, ?, ?)");
-    stmt->bind(1, movedDraftNote.getTitle());
-    stmt->bind(2, movedDraftNote.getDescription());
-    stmt->bind(3, Time::Format::format(clock->currentTimeSeconds()));
-    stmt->execute<void>();
+// The maximum number of characters of a snippet and how many of them precede the first occurrence of the text.
+const int snippetCharacters = 80;
+const int snippetCharactersBeforeMatch = 20;
+
+// The maximum number of characters of the first line of the description shown in the summary of a note.
+const int summarySnippetCharacters = 80;
+
+// The age in seconds at which the boost given to the most recent notes falls from 2 to 1.5 (30 days).
+// The boost decays hyperbolically, so it's 1 + 1 / (1 + age / scale) and not halved every 30 days.
+const double recencyScaleSeconds = 2592000.0;
 }
 
-void NotesRepositoryImpl::deleteWithId(int id) {
-    auto stmt = db->createStatement("DELETE FROM notes "
-                                    "WHERE rowid = ?");
-    stmt->bind(1, id);
-    stmt->execute<void>();
+NotesRepositoryImpl::NotesRepositoryImpl(std::shared_ptr<Db::Database> db,
+                                         std::shared_ptr<Time::Clock> clock,
+                                         size_t cacheBudget) : db(std::move(db)), clock(std::move(clock)) {
+    if (cacheBudget > 0) {
+        this->cache = std::make_shared<NoteCache>(cacheBudget);
+    }
 }
 
-void NotesRepositoryImpl::update(int id, Draft draftNote) {
-    auto stmt = db->createStatement("UPDATE notes "
-                                    "SET title = ?, description = ?, last_update_date = ? "
-                                    "WHERE rowid = ?");
-    stmt->bind(1, draftNote.getTitle());
-    stmt->bind(2, draftNote.getDescription());
-    stmt->bind(3, Time::Format::format(clock->currentTimeSeconds()));
-    stmt->bind(4, id);
-    stmt->execute<void>();
+Note NotesRepositoryImpl::insert(Draft draftNote) {
+    auto movedDraftNote = std::move(draftNote);
+    auto time = clock->currentTimeSeconds();
+    int id = 0;
+    // The notes written by the concurrent callers share a commit, when the writer thread is enabled.
+    db->executeGroupedTransaction([&] {
+        auto stmt = db->createStatement("INSERT INTO notes (title, description, last_update_date) "
+                                        "VALUES (?, ?, ?)");
+        stmt->bind(1, movedDraftNote.getTitle());
+        stmt->bind(2, movedDraftNote.getDescription());
+        stmt->bind<long long>(3, time);
+        stmt->execute<void>();
+        id = static_cast<int>(stmt->lastInsertRowId());
+    });
+    auto note = Note(id, movedDraftNote.getTitle(), movedDraftNote.getDescription(), time);
+    changeCache([note](NoteCache &cache) {
+        cache.put(note);
+    });
+    return note;
+} // LCOV_EXCL_BR_LINE
+
+void NotesRepositoryImpl::deleteWithId(int id) {
+    db->executeGroupedTransaction([&] {
+        auto stmt = db->createStatement("DELETE FROM notes "
+                                        "WHERE rowid = ?");
+        stmt->bind(1, id);
+        stmt->execute<void>();
+    });
+    changeCache([id](NoteCache &cache) {
+        cache.remove(id);
+    });
 }
 
+stdx::optional<Note> NotesRepositoryImpl::update(int id, Draft draftNote) {
+    auto time = clock->currentTimeSeconds();
+    int changes = 0;
+    db->executeGroupedTransaction([&] {
+        auto stmt = db->createStatement("UPDATE notes "
+                                        "SET title = ?, description = ?, last_update_date = ? "
+                                        "WHERE rowid = ?");
+        stmt->bind(1, draftNote.getTitle());
+        stmt->bind(2, draftNote.getDescription());
+        stmt->bind<long long>(3, time);
+        stmt->bind(4, id);
+        stmt->execute<void>();
+        changes = stmt->changes();
+    });
+    if (changes == 0) {
+        return stdx::nullopt;
+    }
+    auto note = Note(id, draftNote.getTitle(), draftNote.getDescription(), time);
+    changeCache([note](NoteCache &cache) {
+        cache.replace(note);
+    });
+    return note;
+} // LCOV_EXCL_BR_LINE
+
 void NotesRepositoryImpl::deleteAll() {
-    auto stmt = db->createStatement("DELETE FROM notes");
-    stmt->execute<void>();
+    db->executeGroupedTransaction([this] {
+        db->createStatement("DELETE FROM notes")->execute<void>();
+    });
+    changeCache([](NoteCache &cache) {
+        cache.removeAll();
+    });
 }
 
 std::vector<Note> NotesRepositoryImpl::getAll() {
+    long long dataVersion = 0;
+    unsigned long cacheGeneration = 0;
+    auto useCache = canReadCache();
+    if (useCache) {
+        // The generation is read before the notes, so the notes changed while they are queried aren't cached.
+        cacheGeneration = cache->generation();
+        dataVersion = db->dataVersion();
+        cache->validate(dataVersion);
+        auto cachedNotes = cache->getAll();
+        if (cachedNotes) {
+            return std::move(*cachedNotes);
+        }
+    }
     std::vector<Note> notes;
-    auto stmt = db->createStatement("SELECT rowid, title, description, last_update_date FROM notes");
+    // The notes are sorted by rowid, like the ones of the cache.
+    auto stmt = db->createStatement("SELECT rowid, title, description, last_update_date FROM notes ORDER BY rowid");
     auto cursor = stmt->execute<std::shared_ptr<Db::Cursor>>();
-    while (cursor->next()) {
-        auto id = cursor->get<int>(0);
-        auto title = cursor->get<std::string>(1);
-        auto description = cursor->get<std::string>(2);
-        auto lastUpdateTimeISO_8601 = cursor->get<std::string>(3);
-        auto lastUpdateTime = Time::Format::parse(lastUpdateTimeISO_8601);
-        notes.emplace_back(id, title, description, lastUpdateTime);
+    readNotes(cursor, notes);
+    if (useCache) {
+        // If another connection commits after reading the version, the cache is dropped by the next read.
+        cache->load(notes, dataVersion, cacheGeneration);
     }
     return notes;
 } // LCOV_EXCL_BR_LINE
 
-std::vector<Note> NotesRepositoryImpl::getByText(std::string text) {
+NotesPage NotesRepositoryImpl::getPage(size_t size, stdx::optional<NotesPage::Key> after) {
+    if (size == 0) {
+        // An empty page doesn't move the position of the pagination.
+        return NotesPage({}, std::move(after));
+    }
+    // The pages are read scanning the index on last_update_date, whose entries are sorted by rowid too, from the key of
+    // the previous page, so the notes before it aren't read again like with OFFSET.
+    std::shared_ptr<Db::Statement> stmt;
+    if (after) {
+        stmt = db->createStatement(
+            "SELECT rowid, title, description, last_update_date "
+            "FROM notes "
+            "WHERE (last_update_date, rowid) < (?, ?) "
+            "ORDER BY last_update_date DESC, rowid DESC "
+            "LIMIT ?"
+        );
+        stmt->bind<long long>(1, after->getLastUpdateTime());
+        stmt->bind(2, after->getId());
+        stmt->bind(3, toLimit(size));
+    } else {
+        stmt = db->createStatement(
+            "SELECT rowid, title, description, last_update_date "
+            "FROM notes "
+            "ORDER BY last_update_date DESC, rowid DESC "
+            "LIMIT ?"
+        );
+        stmt->bind(1, toLimit(size));
+    }
     std::vector<Note> notes;
+    auto cursor = stmt->execute<std::shared_ptr<Db::Cursor>>();
+    readNotes(cursor, notes);
+
+    stdx::optional<NotesPage::Key> nextKey;
+    // One more note than the page size is read to know if there's a next page.
+    if (notes.size() > size) {
+        notes.pop_back();
+        nextKey = NotesPage::Key(notes.back().getLastUpdateTime(), notes.back().getId());
+    }
+    return NotesPage(std::move(notes), std::move(nextKey));
+} // LCOV_EXCL_BR_LINE
+
+void NotesRepositoryImpl::forEach(const std::function<void(Note)> &consumer) {
     auto stmt = db->createStatement(
         "SELECT rowid, title, description, last_update_date "
         "FROM notes "
-        "WHERE title LIKE ?"
-        "OR description LIKE ?"
+        "ORDER BY last_update_date DESC, rowid DESC"
+    );
+    stmt->execute<std::shared_ptr<Db::Cursor>>()->forEachRow<int, std::string, std::string, long long>(
+        [&consumer](int id, std::string title, std::string description, long long lastUpdateTime) {
+            consumer(Note(id, std::move(title), std::move(description), static_cast<std::time_t>(lastUpdateTime)));
+        });
+} // LCOV_EXCL_BR_LINE
+
+std::vector<NoteSummary> NotesRepositoryImpl::getSummaries() {
+    // The snippet is cut by SQLite, so only its characters are copied for each note.
+    auto stmt = db->createStatement(
+        "SELECT rowid, "
+        "title, "
+        "substr(description, 1, "
+        "min(coalesce(nullif(instr(description, char(10)), 0) - 1, length(description)), " +
+            std::to_string(summarySnippetCharacters) + ")), "
+        "last_update_date "
+        "FROM notes "
+        "ORDER BY last_update_date DESC, rowid DESC"
     );
-    // In this way all the notes which contain the given text in the title or the description will be retrieved.
-    auto likeText = "%" + text + "%";
-    stmt->bind(1, likeText);
-    stmt->bind(2, likeText);
+    std::vector<NoteSummary> summaries;
+    stmt->execute<std::shared_ptr<Db::Cursor>>()->forEachRow<int, std::string, std::string, long long>(
+        [&summaries](int id, std::string title, std::string snippet, long long lastUpdateTime) {
+            summaries.emplace_back(id, std::move(title), std::move(snippet), static_cast<std::time_t>(lastUpdateTime));
+        });
+    return summaries;
+} // LCOV_EXCL_BR_LINE
+
+stdx::optional<Note> NotesRepositoryImpl::getById(int id) {
+    auto stmt = db->createStatement("SELECT rowid, title, description, last_update_date "
+                                    "FROM notes "
+                                    "WHERE rowid = ?");
+    stmt->bind(1, id);
+    std::vector<Note> notes;
     auto cursor = stmt->execute<std::shared_ptr<Db::Cursor>>();
-    while (cursor->next()) {
-        auto id = cursor->get<int>(0);
-        auto title = cursor->get<std::string>(1);
-        auto description = cursor->get<std::string>(2);
-        auto lastUpdateTimeISO_8601 = cursor->get<std::string>(3);
-        auto lastUpdateTime = Time::Format::parse(lastUpdateTimeISO_8601);
-        notes.emplace_back(id, title, description, lastUpdateTime);
+    readNotes(cursor, notes);
+    if (notes.empty()) {
+        return stdx::nullopt;
     }
+    return std::move(notes.front());
+} // LCOV_EXCL_BR_LINE
+
+std::vector<Note> NotesRepositoryImpl::getByText(std::string text) {
+    if (text.empty()) {
+        // An empty text is contained in all the notes.
+        return getAll();
+    }
+    if (canReadCache()) {
+        cache->validate(db->dataVersion());
+        if (cache->isLoaded()) {
+            // Only the rowids of the found notes are read from SQLite, without copying their text.
+            std::vector<int> ids;
+            createTextStatement(text, "notes.rowid")->execute<std::shared_ptr<Db::Cursor>>()->forEachRow<int>(
+                [&ids](int id) {
+                    ids.push_back(id);
+                });
+            auto cachedNotes = cache->getAll(ids);
+            if (cachedNotes) {
+                return std::move(*cachedNotes);
+            }
+        } else {
+            cache->countMiss();
+        }
+    }
+    std::vector<Note> notes;
+    auto stmt = createTextStatement(text, "notes.rowid, notes.title, notes.description, notes.last_update_date");
+    auto cursor = stmt->execute<std::shared_ptr<Db::Cursor>>();
+    readNotes(cursor, notes);
     return notes;
 } // LCOV_EXCL_BR_LINE
+
+std::vector<NoteMatch> NotesRepositoryImpl::getRankedByText(std::string text, size_t limit) {
+    // The description isn't copied, since only its snippet is returned.
+    const std::string columns = "notes.rowid, notes.title, notes.description, notes.last_update_date";
+    // A note updated now has its score doubled, while the boost fades for the oldest notes.
+    const std::string recencyBoost =
+        "(1.0 + 1.0 / (1.0 + max(0, ?1 - notes.last_update_date) / " +
+            std::to_string(recencyScaleSeconds) + "))";
+
+    std::shared_ptr<Db::Statement> stmt;
+    if (countCharacters(text) < 3) {
+        // Without the index there isn't a relevance score, so the notes are ranked only by recency. The index on
+        // last_update_date is read backwards, so the scan stops when the limit is reached.
+        stmt = db->createStatement(
+            "SELECT " + columns + " "
+            "FROM notes "
+            "WHERE notes.title LIKE ?2 ESCAPE '\\' "
+            "OR notes.description LIKE ?2 ESCAPE '\\' "
+            "ORDER BY notes.last_update_date DESC, notes.rowid DESC "
+            "LIMIT ?3"
+        );
+        stmt->bind(2, "%" + escapeLike(text) + "%");
+    } else {
+        // The BM25 score is negative and lower for the most relevant notes, so the boost makes it even lower.
+        stmt = db->createStatement(
+            "SELECT " + columns + " "
+            "FROM notes_trigram "
+            "JOIN notes ON notes.rowid = notes_trigram.rowid "
+            "WHERE notes_trigram MATCH ?2 "
+            "ORDER BY bm25(notes_trigram) * " + recencyBoost + ", notes.rowid DESC "
+            "LIMIT ?3"
+        );
+        stmt->bind<long long>(1, clock->currentTimeSeconds());
+        stmt->bind(2, toPhraseQuery(text));
+    }
+    stmt->bind(3, static_cast<int>(std::min(limit, static_cast<size_t>(INT_MAX))));
+
+    std::vector<NoteMatch> matches;
+    auto foldedText = foldCase(text);
+    stmt->execute<std::shared_ptr<Db::Cursor>>()->forEachRow<int, std::string, stdx::string_view, long long>(
+        [&](int id, std::string title, stdx::string_view description, long long lastUpdateTime) {
+            auto titleMatches = findOccurrences(title, foldedText);
+            std::vector<NoteMatch::Range> snippetMatches;
+            auto snippet = cutSnippet(description, foldedText, snippetMatches);
+            matches.emplace_back(id,
+                                 std::move(title),
+                                 std::move(snippet),
+                                 std::move(titleMatches),
+                                 std::move(snippetMatches),
+                                 static_cast<std::time_t>(lastUpdateTime));
+        });
+    return matches;
+} // LCOV_EXCL_BR_LINE
+
+int NotesRepositoryImpl::subscribe(std::function<void(NotesChange)> listener) {
+    return db->addChangeListener([listener = std::move(listener)](const std::vector<Db::TableChanges> &tables) {
+        for (const auto &table : tables) {
+            // e.g. the shadow tables of the substring index are changed too.
+            if (table.table != "notes") {
+                continue;
+            }
+            listener(NotesChange(std::vector<int>(table.insertedRowIds.begin(), table.insertedRowIds.end()),
+                                 std::vector<int>(table.updatedRowIds.begin(), table.updatedRowIds.end()),
+                                 std::vector<int>(table.deletedRowIds.begin(), table.deletedRowIds.end())));
+        }
+    });
+}
+
+void NotesRepositoryImpl::unsubscribe(int subscriptionId) {
+    db->removeChangeListener(subscriptionId);
+}
+
+stdx::optional<NoteCache::Stats> NotesRepositoryImpl::getCacheStats() const {
+    if (!cache) {
+        return stdx::nullopt;
+    }
+    return cache->stats();
+}
+
+bool NotesRepositoryImpl::canReadCache() const {
+    return cache && !db->isInTransaction();
+}
+
+void NotesRepositoryImpl::changeCache(std::function<void(NoteCache &)> change) {
+    if (!cache) {
+        return;
+    }
+    db->executeAfterCommit([cache = cache, change = std::move(change)] {
+        change(*cache);
+    });
+}
+
+std::shared_ptr<Db::Statement> NotesRepositoryImpl::createTextStatement(const std::string &text,
+                                                                        const std::string &columns) {
+    std::shared_ptr<Db::Statement> stmt;
+    if (countCharacters(text) < 3) {
+        // The text is shorter than a trigram so the substring index can't be used, and all the notes are scanned.
+        stmt = db->createStatement(
+            "SELECT " + columns + " "
+            "FROM notes "
+            "WHERE notes.title LIKE ? ESCAPE '\\' "
+            "OR notes.description LIKE ? ESCAPE '\\' "
+            "ORDER BY notes.rowid"
+        );
+        auto likeText = "%" + escapeLike(text) + "%";
+        stmt->bind(1, likeText);
+        stmt->bind(2, likeText);
+    } else {
+        // The index finds the notes containing all the trigrams of the text in the same order, so the whole text.
+        stmt = db->createStatement(
+            "SELECT " + columns + " "
+            "FROM notes_trigram "
+            "JOIN notes ON notes.rowid = notes_trigram.rowid "
+            "WHERE notes_trigram MATCH ? "
+            "ORDER BY notes_trigram.rowid"
+        );
+        stmt->bind(1, toPhraseQuery(text));
+    }
+    return stmt;
+}
+
+void NotesRepositoryImpl::readNotes(const std::shared_ptr<Db::Cursor> &cursor, std::vector<Note> &notes) {
+    cursor->forEachRow<int, std::string, std::string, long long>([&notes](int id,
+                                                                          std::string title,
+                                                                          std::string description,
+                                                                          long long lastUpdateTime) {
+        // The strings are moved since they are already copies of the columns.
+        notes.emplace_back(id, std::move(title), std::move(description), static_cast<std::time_t>(lastUpdateTime));
+    });
+}
+
+int NotesRepositoryImpl::toLimit(size_t size) {
+    return static_cast<int>(std::min(size, static_cast<size_t>(INT_MAX - 1)) + 1);
+}
+
+size_t NotesRepositoryImpl::countCharacters(const std::string &text) {
+    size_t count = 0;
+    for (char c : text) {
+        // Every UTF-8 character has a single byte which isn't a continuation byte.
+        if (!isContinuationByte(c)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+std::string NotesRepositoryImpl::toPhraseQuery(const std::string &text) {
+    // The quotes inside a FTS5 string are escaped doubling them, while any other character is matched literally.
+    std::string query = "\"";
+    for (char c : text) {
+        if (c == '"') {
+            query += '"';
+        }
+        query += c;
+    }
+    query += '"';
+    return query;
+}
+
+std::string NotesRepositoryImpl::escapeLike(const std::string &text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '%' || c == '_' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+std::string NotesRepositoryImpl::foldCase(std::string text) {
+    for (char &c : text) {
+        c = foldCase(c);
+    }
+    return text;
+}
+
+char NotesRepositoryImpl::foldCase(char c) {
+    if (c >= 'A' && c <= 'Z') {
+        return static_cast<char>(c - 'A' + 'a');
+    }
+    return c;
+}
+
+bool NotesRepositoryImpl::isContinuationByte(char c) {
+    // The continuation bytes of UTF-8 are 10xxxxxx.
+    return (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+}
+
+std::vector<NoteMatch::Range> NotesRepositoryImpl::findOccurrences(stdx::string_view text,
+                                                                    const std::string &foldedSearchedText) {
+    std::vector<NoteMatch::Range> ranges;
+    auto length = foldedSearchedText.size();
+    if (length == 0) {
+        return ranges;
+    }
+    // The text is compared folding a byte at a time, so it isn't copied.
+    size_t start = 0;
+    while (start + length <= text.size()) {
+        size_t matched = 0;
+        while (matched < length && foldCase(text[start + matched]) == foldedSearchedText[matched]) {
+            matched++;
+        }
+        if (matched == length) {
+            ranges.push_back(NoteMatch::Range{start, length});
+            start += length;
+        } else {
+            start++;
+        }
+    }
+    return ranges;
+}
+
+std::string NotesRepositoryImpl::cutSnippet(stdx::string_view description,
+                                            const std::string &foldedSearchedText,
+                                            std::vector<NoteMatch::Range> &matches) {
+    auto occurrences = findOccurrences(description, foldedSearchedText);
+    size_t start = 0;
+    if (!occurrences.empty()) {
+        start = occurrences.front().start;
+        // The occurrence starts a character, so moving back by whole characters keeps the snippet valid UTF-8.
+        for (int characters = 0; characters < snippetCharactersBeforeMatch && start > 0; characters++) {
+            do {
+                start--;
+            } while (start > 0 && isContinuationByte(description[start]));
+        }
+    }
+    size_t end = start;
+    for (int characters = 0; characters < snippetCharacters && end < description.size(); characters++) {
+        do {
+            end++;
+        } while (end < description.size() && isContinuationByte(description[end]));
+    }
+    for (const auto &occurrence : occurrences) {
+        if (occurrence.start >= start && occurrence.start + occurrence.length <= end) {
+            matches.push_back(NoteMatch::Range{occurrence.start - start, occurrence.length});
+        }
+    }
+    return std::string(description.substr(start, end - start));
+} // LCOV_EXCL_BR_LINE
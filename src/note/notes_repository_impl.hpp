@@ -2,26 +2,135 @@
 
 #include "core/include_macros.hpp"
 #include "notes_repository.hpp"
+#include "note_cache.hpp"
 #include AMALGAMATION(database.hpp)
 #include AMALGAMATION(clock.hpp)
+#include AMALGAMATION(database_cursor.hpp)
 
 class NotesRepositoryImpl : public NotesRepository {
    public:
-    NotesRepositoryImpl(std::shared_ptr<Db::Database> db, std::shared_ptr<Time::Clock> clock);
+    /**
+     * The main constructor.
+     *
+     * @param db the database containing the notes.
+     * @param clock the clock used to get the last update date of the notes.
+     * @param cacheBudget the maximum number of bytes of the notes cached in memory. When it's 0, they aren't cached.
+     */
+    NotesRepositoryImpl(std::shared_ptr<Db::Database> db, std::shared_ptr<Time::Clock> clock, size_t cacheBudget = 0);
 
-    void insert(Draft note) override;
+    Note insert(Draft note) override;
 
     void deleteWithId(int id) override;
 
-    void update(int id, Draft note) override;
+    stdx::optional<Note> update(int id, Draft note) override;
 
     void deleteAll() override;
 
     std::vector<Note> getAll() override;
 
+    NotesPage getPage(size_t size, stdx::optional<NotesPage::Key> after) override;
+
+    void forEach(const std::function<void(Note)> &consumer) override;
+
+    std::vector<NoteSummary> getSummaries() override;
+
+    stdx::optional<Note> getById(int id) override;
+
     std::vector<Note> getByText(std::string text) override;
 
+    std::vector<NoteMatch> getRankedByText(std::string text, size_t limit) override;
+
+    int subscribe(std::function<void(NotesChange)> listener) override;
+
+    void unsubscribe(int subscriptionId) override;
+
+    /**
+     * @return the counters of the cache of the notes, or an empty optional if the notes aren't cached.
+     */
+    [[nodiscard]] stdx::optional<NoteCache::Stats> getCacheStats() const;
+
    private:
     std::shared_ptr<Db::Database> db;
     std::shared_ptr<Time::Clock> clock;
+    // It's shared with the changes applied after the caller's transaction is committed.
+    std::shared_ptr<NoteCache> cache;
+
+    /**
+     * Checks if the cache can be read, which isn't possible inside a transaction since it holds only the committed
+     * notes.
+     */
+    bool canReadCache() const;
+
+    /**
+     * Applies a change to the cache once the caller's transaction, if any, is committed, so a rolled back change
+     * doesn't reach it.
+     */
+    void changeCache(std::function<void(NoteCache &)> change);
+
+    /**
+     * Creates the statement which finds the notes containing the given text, sorted by rowid.
+     *
+     * @param text the searched text, which can't be empty.
+     * @param columns the selected columns of the notes, qualified with the table name "notes".
+     */
+    std::shared_ptr<Db::Statement> createTextStatement(const std::string &text, const std::string &columns);
+
+    /**
+     * Reads all the rows of a cursor selecting rowid, title, description and last_update_date.
+     *
+     * @param cursor the cursor which will be consumed.
+     * @param notes the vector which will contain the read notes.
+     */
+    static void readNotes(const std::shared_ptr<Db::Cursor> &cursor, std::vector<Note> &notes);
+
+    /**
+     * Converts the size of a page to the LIMIT of its query, which reads one more note to know if there's a next page.
+     */
+    static int toLimit(size_t size);
+
+    /**
+     * Counts the UTF-8 characters of the given text.
+     */
+    static size_t countCharacters(const std::string &text);
+
+    /**
+     * Converts a text in a FTS5 phrase which matches it literally, e.g. without interpreting its quotes or operators.
+     */
+    static std::string toPhraseQuery(const std::string &text);
+
+    /**
+     * Escapes the wildcards of the operator LIKE contained in the given text, using the backslash as escape character.
+     */
+    static std::string escapeLike(const std::string &text);
+
+    /**
+     * Converts the ASCII letters of the given text to lower case, as the substring index and the SQL function lower().
+     */
+    static std::string foldCase(std::string text);
+
+    static char foldCase(char c);
+
+    static bool isContinuationByte(char c);
+
+    /**
+     * Finds the non-overlapping occurrences of a text, ignoring the case of the ASCII letters.
+     *
+     * @param text the text in which the occurrences are searched.
+     * @param foldedSearchedText the searched text, already converted by foldCase().
+     * @return the ranges of bytes of the occurrences, or an empty vector if the searched text is empty.
+     */
+    static std::vector<NoteMatch::Range> findOccurrences(stdx::string_view text, const std::string &foldedSearchedText);
+
+    /**
+     * Cuts the snippet of a description which starts some characters before the first occurrence of the searched
+     * text, or at its beginning if the description doesn't contain it, without splitting its UTF-8 characters.
+     *
+     * @param description the whole description.
+     * @param foldedSearchedText the searched text, already converted by foldCase().
+     * @param matches the vector which will contain the ranges of bytes of the occurrences inside the snippet.
+     * @return the snippet.
+     */
+    static std::string cutSnippet(stdx::string_view description,
+                                  const std::string &foldedSearchedText,
+                                  std::vector<NoteMatch::Range> &matches);
 };
\ No newline at end of file
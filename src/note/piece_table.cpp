@@ -0,0 +1,147 @@
+#include <stdexcept>
+#include "piece_table.hpp"
+#include "core/exception_macros.hpp"
+
+/* PRIVATE */ namespace {
+
+// Beyond this number of pieces, the edits far from the previous one become slower than copying the text.
+const size_t maxPieces = 512;
+}
+
+PieceTable::PieceTable(std::string original) : original(std::move(original)) {
+    length = this->original.size();
+    if (length > 0) {
+        pieces.push_back(Piece{Source::Original, 0, length});
+    }
+}
+
+void PieceTable::insert(size_t offset, stdx::string_view text) {
+    checkRange(offset, 0);
+    if (text.empty()) {
+        return;
+    }
+    if (offset > 0) {
+        auto location = locate(offset - 1);
+        auto &piece = pieces[location.first];
+        if (piece.source == Source::Added && location.second + piece.length == offset &&
+            piece.start + piece.length == added.size()) {
+            // The text is appended to the last inserted one, like the characters typed one after the other.
+            added.append(text.data(), text.size());
+            piece.length += text.size();
+            length += text.size();
+            return;
+        }
+    }
+    auto index = splitAt(offset);
+    pieces.insert(pieces.begin() + index, Piece{Source::Added, added.size(), text.size()});
+    added.append(text.data(), text.size());
+    length += text.size();
+    cachedIndex = index;
+    cachedOffset = offset;
+    compactIfNeeded();
+}
+
+void PieceTable::erase(size_t offset, size_t count) {
+    checkRange(offset, count);
+    if (count == 0) {
+        return;
+    }
+    auto location = locate(offset);
+    auto &piece = pieces[location.first];
+    if (offset > location.second && offset + count == location.second + piece.length) {
+        // The end of a piece is deleted, like the characters deleted with backspace after typing them.
+        if (piece.source == Source::Added && piece.start + piece.length == added.size()) {
+            added.resize(added.size() - count);
+        }
+        piece.length -= count;
+        length -= count;
+        return;
+    }
+    auto first = splitAt(offset);
+    auto last = splitAt(offset + count);
+    pieces.erase(pieces.begin() + first, pieces.begin() + last);
+    length -= count;
+    cachedIndex = first;
+    cachedOffset = offset;
+    compactIfNeeded();
+}
+
+void PieceTable::checkRange(size_t offset, size_t count) const {
+    if (offset > length) {
+        THROW(std::out_of_range("The offset " + std::to_string(offset) + " is after the end of the text"));
+    }
+    if (count > length - offset) {
+        THROW(std::out_of_range("The range of " + std::to_string(count) + " bytes from the offset " +
+                                std::to_string(offset) + " exceeds the end of the text"));
+    }
+}
+
+size_t PieceTable::size() const {
+    return length;
+}
+
+size_t PieceTable::pieceCount() const {
+    return pieces.size();
+}
+
+std::string PieceTable::toString() const {
+    std::string text;
+    text.reserve(length);
+    for (const auto &piece : pieces) {
+        const auto &buffer = piece.source == Source::Original ? original : added;
+        text.append(buffer, piece.start, piece.length);
+    }
+    return text;
+} // LCOV_EXCL_BR_LINE
+
+bool operator==(const PieceTable &first, const PieceTable &second) {
+    return first.length == second.length && first.toString() == second.toString();
+}
+
+std::pair<size_t, size_t> PieceTable::locate(size_t offset) {
+    auto index = cachedIndex;
+    auto pieceOffset = cachedOffset;
+    if (index > pieces.size()) {
+        index = 0;
+        pieceOffset = 0;
+    }
+    while (index > 0 && offset < pieceOffset) {
+        index--;
+        pieceOffset -= pieces[index].length;
+    }
+    while (index < pieces.size() && offset >= pieceOffset + pieces[index].length) {
+        pieceOffset += pieces[index].length;
+        index++;
+    }
+    cachedIndex = index;
+    cachedOffset = pieceOffset;
+    return std::make_pair(index, pieceOffset);
+}
+
+size_t PieceTable::splitAt(size_t offset) {
+    auto location = locate(offset);
+    auto index = location.first;
+    if (index == pieces.size() || location.second == offset) {
+        return index;
+    }
+    auto &piece = pieces[index];
+    auto headLength = offset - location.second;
+    auto tail = Piece{piece.source, piece.start + headLength, piece.length - headLength};
+    piece.length = headLength;
+    pieces.insert(pieces.begin() + index + 1, tail);
+    return index + 1;
+}
+
+void PieceTable::compactIfNeeded() {
+    if (pieces.size() <= maxPieces) {
+        return;
+    }
+    original = toString();
+    added.clear();
+    pieces.clear();
+    if (length > 0) {
+        pieces.push_back(Piece{Source::Original, 0, length});
+    }
+    cachedIndex = 0;
+    cachedOffset = 0;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+#include "core/include_macros.hpp"
+#include AMALGAMATION(std_string_view_compat.hpp)
+
+/**
+ * A text edited with insertions and deletions which don't copy the rest of the text.
+ * The text is a sequence of pieces pointing to the original text or to an append-only buffer of the inserted text.
+ * The piece of the last edit is remembered, so the edits near the previous one, like the characters typed by the
+ * user, locate their piece in constant time and cost only the size of the edit.
+ * The offsets and the lengths are in bytes.
+ */
+class PieceTable {
+   public:
+    PieceTable() = default;
+
+    explicit PieceTable(std::string original);
+
+    /**
+     * Inserts a text before the given offset.
+     *
+     * @param offset the offset of the insertion, from 0 to size().
+     * @param text the inserted text.
+     */
+    void insert(size_t offset, stdx::string_view text);
+
+    /**
+     * Deletes a range of the text.
+     *
+     * @param offset the offset of the first deleted byte.
+     * @param count the number of deleted bytes, which must not exceed the end of the text.
+     */
+    void erase(size_t offset, size_t count);
+
+    /**
+     * Checks that a range can be edited, without changing the text.
+     * It's the same check done by insert(), with a count of 0, and by erase().
+     *
+     * @param offset the offset of the first byte of the range, from 0 to size().
+     * @param count the number of bytes of the range, which must not exceed the end of the text.
+     * @throws std::out_of_range if the range exceeds the end of the text.
+     */
+    void checkRange(size_t offset, size_t count) const;
+
+    [[nodiscard]] size_t size() const;
+
+    /**
+     * @return the number of pieces of the text, which is 1 after the text is compacted.
+     */
+    [[nodiscard]] size_t pieceCount() const;
+
+    /**
+     * Copies the pieces in a contiguous string.
+     */
+    [[nodiscard]] std::string toString() const;
+
+    friend bool operator==(const PieceTable &first, const PieceTable &second);
+
+   private:
+    enum class Source {
+        Original,
+        Added
+    };
+
+    struct Piece {
+        Source source;
+        size_t start;
+        size_t length;
+    };
+
+    std::string original;
+    std::string added;
+    std::vector<Piece> pieces;
+    size_t length = 0;
+    // The index of the piece of the last edit and its offset in the text.
+    size_t cachedIndex = 0;
+    size_t cachedOffset = 0;
+
+    /**
+     * Finds the piece containing the given offset, walking from the piece of the last edit.
+     *
+     * @return the index of the piece and its offset in the text, or the number of pieces and the size of the text
+     * when the offset is the end of the text.
+     */
+    std::pair<size_t, size_t> locate(size_t offset);
+
+    /**
+     * Splits the piece containing the given offset, so a piece starts at the offset.
+     *
+     * @return the index of the piece starting at the offset, or the number of pieces if it's the end of the text.
+     */
+    size_t splitAt(size_t offset);
+
+    /**
+     * Copies the pieces in a new original text when they are too many, so locating a piece stays cheap.
+     */
+    void compactIfNeeded();
+};
@@ -1,25 +1,149 @@
-#include <iomanip>
-#include <sstream>
+#include <stdexcept>
 #include "core/include_macros.hpp"
+#include "core/exception_macros.hpp"
 #include AMALGAMATION(time_format.hpp)
 
 namespace Time::Format {
 
+/* PRIVATE */ namespace {
+
+const long long secondsPerDay = 86400;
+
+// The days before the first day of each month, in the common years and in the leap years.
+const int daysBeforeMonth[2][13] = {
+    {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334, 365},
+    {0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335, 366}
+};
+
+// The days from 0000-01-01 to 1970-01-01.
+const long long daysBeforeEpoch = 719528;
+
+// The days of a cycle of the Gregorian calendar, which repeats every 400 years.
+const long long daysPer400Years = 146097;
+
+const long long maxYear = 9999;
+
+bool isLeapYear(long long year) {
+    return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+}
+
+/**
+ * Counts the days from 0000-01-01 to the first day of the given year, which must not be negative.
+ */
+long long daysBeforeYear(long long year) {
+    if (year == 0) {
+        return 0;
+    }
+    // The year 0 is a leap year too.
+    return 365 * year + (year - 1) / 4 - (year - 1) / 100 + (year - 1) / 400 + 1;
+}
+
+/**
+ * Divides rounding towards negative infinity, so the times before the epoch belong to the previous day.
+ */
+long long floorDivide(long long dividend, long long divisor) {
+    auto quotient = dividend / divisor;
+    return (dividend % divisor < 0) ? quotient - 1 : quotient;
+}
+
+void writeDigits(char *buffer, long long value, int count) {
+    for (int i = count - 1; i >= 0; i--) {
+        buffer[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+bool readDigits(const char *text, int count, int &value) {
+    value = 0;
+    for (int i = 0; i < count; i++) {
+        auto digit = text[i] - '0';
+        if (digit < 0 || digit > 9) {
+            return false;
+        }
+        value = value * 10 + digit;
+    }
+    return true;
+}
+}
+
 ISO_8601 format(std::time_t time) {
-    // Create a buffer of the same result's size.
-    char timeBuffer[sizeof "0000-00-00T00:00:00Z"];
-    // Convert the time in seconds to the ISO-8601 format.
-    strftime(timeBuffer, sizeof timeBuffer, "%FT%TZ", gmtime(&time));
-    return timeBuffer;
-}
-
-std::time_t parse(ISO_8601 formattedDate) {
-    auto movedDate = std::move(formattedDate);
-    tm tm{};
-    auto ss = std::istringstream(movedDate);
-    // Fill the time struct reading the ISO-8601 time.
-    ss >> std::get_time(&tm, "%Y-%m-%dT%TZ");
-    // Get the time_t value for the struct.
-    return timegm(&tm);
-}
-}
\ No newline at end of file
+    char buffer[length];
+    auto end = format(time, buffer);
+    return ISO_8601(buffer, end);
+}
+
+char *format(std::time_t time, char *buffer) {
+    auto seconds = static_cast<long long>(time);
+    auto days = floorDivide(seconds, secondsPerDay) + daysBeforeEpoch;
+    auto secondOfDay = seconds - floorDivide(seconds, secondsPerDay) * secondsPerDay;
+    if (days < 0 || days >= daysBeforeYear(maxYear + 1)) {
+        THROW(std::out_of_range("The time " + std::to_string(seconds) + " is outside the years 0000-9999"));
+    }
+
+    // The year is estimated with the average length of the years and then corrected, if it's the next one.
+    auto year = days * 400 / daysPer400Years;
+    while (daysBeforeYear(year) > days) {
+        year--;
+    }
+    while (daysBeforeYear(year + 1) <= days) {
+        year++;
+    }
+    auto dayOfYear = static_cast<int>(days - daysBeforeYear(year));
+    const int *monthStarts = daysBeforeMonth[isLeapYear(year) ? 1 : 0];
+    int month = 1;
+    while (monthStarts[month] <= dayOfYear) {
+        month++;
+    }
+
+    writeDigits(buffer, year, 4);
+    buffer[4] = '-';
+    writeDigits(buffer + 5, month, 2);
+    buffer[7] = '-';
+    writeDigits(buffer + 8, dayOfYear - monthStarts[month - 1] + 1, 2);
+    buffer[10] = 'T';
+    writeDigits(buffer + 11, secondOfDay / 3600, 2);
+    buffer[13] = ':';
+    writeDigits(buffer + 14, secondOfDay / 60 % 60, 2);
+    buffer[16] = ':';
+    writeDigits(buffer + 17, secondOfDay % 60, 2);
+    buffer[19] = 'Z';
+    return buffer + length;
+}
+
+std::time_t parse(stdx::string_view formattedTime) {
+    auto time = tryParse(formattedTime);
+    if (!time) {
+        THROW(std::invalid_argument("The time \"" + std::string(formattedTime) + "\" isn't in the ISO-8601 format"));
+    }
+    return *time;
+}
+
+stdx::optional<std::time_t> tryParse(stdx::string_view formattedTime) {
+    if (formattedTime.size() != length) {
+        return stdx::nullopt;
+    }
+    const char *text = formattedTime.data();
+    if (text[4] != '-' || text[7] != '-' || text[10] != 'T' || text[13] != ':' || text[16] != ':' || text[19] != 'Z') {
+        return stdx::nullopt;
+    }
+    int year, month, day, hour, minute, second;
+    if (!readDigits(text, 4, year) ||
+        !readDigits(text + 5, 2, month) ||
+        !readDigits(text + 8, 2, day) ||
+        !readDigits(text + 11, 2, hour) ||
+        !readDigits(text + 14, 2, minute) ||
+        !readDigits(text + 17, 2, second)) {
+        return stdx::nullopt;
+    }
+    if (month < 1 || month > 12 || hour > 23 || minute > 59 || second > 59) {
+        return stdx::nullopt;
+    }
+    const int *monthStarts = daysBeforeMonth[isLeapYear(year) ? 1 : 0];
+    if (day < 1 || day > monthStarts[month] - monthStarts[month - 1]) {
+        return stdx::nullopt;
+    }
+
+    auto days = daysBeforeYear(year) + monthStarts[month - 1] + day - 1 - daysBeforeEpoch;
+    return static_cast<std::time_t>(days * secondsPerDay + hour * 3600 + minute * 60 + second);
+}
+}
@@ -0,0 +1,55 @@
+#include <future>
+#include <vector>
+#include "core/mpsc_queue.hpp"
+#include <gtest/gtest.h>
+
+TEST(MpscQueueTest, givenEmptyQueueWhenPopIsInvokedThenFalseIsReturned) {
+    auto queue = MpscQueue<int>();
+    int value = 0;
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.pop(value));
+}
+
+TEST(MpscQueueTest, givenPushedValuesWhenPopIsInvokedThenTheyAreReturnedInOrder) {
+    auto queue = MpscQueue<int>();
+    queue.push(1);
+    queue.push(2);
+    int value = 0;
+
+    EXPECT_FALSE(queue.empty());
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(1, value);
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(2, value);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(MpscQueueTest, givenMultipleProducersWhenTheyPushConcurrentlyThenAllValuesArePoppedInTheirOrder) {
+    auto queue = MpscQueue<int>();
+    const int producers = 4;
+    const int valuesPerProducer = 1000;
+    std::vector<std::future<void>> pushes;
+    for (int producer = 0; producer < producers; producer++) {
+        pushes.push_back(std::async(std::launch::async, [&queue, producer] {
+            for (int i = 0; i < valuesPerProducer; i++) {
+                queue.push(producer * valuesPerProducer + i);
+            }
+        }));
+    }
+    for (auto &push : pushes) {
+        push.wait();
+    }
+
+    std::vector<int> lastValues(producers, -1);
+    int popped = 0;
+    int value;
+    while (queue.pop(value)) {
+        auto producer = value / valuesPerProducer;
+        // The values of the same producer keep their order.
+        EXPECT_GT(value, lastValues[producer]);
+        lastValues[producer] = value;
+        popped++;
+    }
+    EXPECT_EQ(producers * valuesPerProducer, popped);
+}
@@ -0,0 +1,85 @@
+#include <cstdio>
+#include <future>
+#include <thread>
+#include "busy_handler_test.hpp"
+
+void BusyHandlerTest::SetUp() {
+    sqlite3_open_v2(dbPath, &locker, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr);
+    sqlite3_exec(locker, "CREATE TABLE dummy_table (col_int INTEGER)", nullptr, nullptr, nullptr);
+    sqlite3_open_v2(dbPath, &db, SQLITE_OPEN_READWRITE, nullptr);
+}
+
+void BusyHandlerTest::TearDown() {
+    sqlite3_close(db);
+    sqlite3_close(locker);
+    std::remove(dbPath);
+}
+
+Db::BusyPolicy BusyHandlerTest::timeoutPolicy(int timeoutMs) {
+    auto policy = Db::BusyPolicy();
+    policy.timeout = std::chrono::milliseconds(timeoutMs);
+    return policy;
+}
+
+TEST_F(BusyHandlerTest, givenDefaultPolicyWhenLockIsHeldThenStatementFailsImmediately) {
+    auto handler = Db::Sql::BusyHandler(Db::BusyPolicy());
+    handler.install(db);
+    sqlite3_exec(locker, "BEGIN EXCLUSIVE", nullptr, nullptr, nullptr);
+
+    int rc = sqlite3_exec(db, "INSERT INTO dummy_table (col_int) VALUES (1)", nullptr, nullptr, nullptr);
+
+    EXPECT_EQ(SQLITE_BUSY, rc);
+    auto stats = handler.stats();
+    EXPECT_EQ(0, stats.retries);
+    EXPECT_EQ(0, stats.timeouts);
+    EXPECT_EQ(0, stats.waitTime.count());
+}
+
+TEST_F(BusyHandlerTest, givenTimeoutWhenLockIsNeverReleasedThenStatementFailsWhenTimeoutExpires) {
+    auto handler = Db::Sql::BusyHandler(timeoutPolicy(30));
+    handler.install(db);
+    sqlite3_exec(locker, "BEGIN EXCLUSIVE", nullptr, nullptr, nullptr);
+
+    auto start = std::chrono::steady_clock::now();
+    int rc = sqlite3_exec(db, "INSERT INTO dummy_table (col_int) VALUES (1)", nullptr, nullptr, nullptr);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(SQLITE_BUSY, rc);
+    EXPECT_GE(elapsed, std::chrono::milliseconds(30));
+    auto stats = handler.stats();
+    EXPECT_GT(stats.retries, 0);
+    EXPECT_EQ(1, stats.timeouts);
+    EXPECT_GT(stats.waitTime.count(), 0);
+    EXPECT_LE(stats.waitTime, elapsed);
+}
+
+TEST_F(BusyHandlerTest, givenTimeoutWhenLockIsReleasedWhileWaitingThenStatementSucceeds) {
+    auto handler = Db::Sql::BusyHandler(timeoutPolicy(5000));
+    handler.install(db);
+    sqlite3_exec(locker, "BEGIN EXCLUSIVE", nullptr, nullptr, nullptr);
+
+    auto release = std::async(std::launch::async, [this] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        sqlite3_exec(locker, "COMMIT", nullptr, nullptr, nullptr);
+    });
+    int rc = sqlite3_exec(db, "INSERT INTO dummy_table (col_int) VALUES (1)", nullptr, nullptr, nullptr);
+    release.wait();
+
+    EXPECT_EQ(SQLITE_OK, rc);
+    auto stats = handler.stats();
+    EXPECT_GT(stats.retries, 0);
+    EXPECT_EQ(0, stats.timeouts);
+}
+
+TEST_F(BusyHandlerTest, givenTransactionRetriesWhenAttemptsAreExhaustedThenTransactionIsNotRetried) {
+    auto policy = Db::BusyPolicy();
+    policy.transactionRetries = 2;
+    auto handler = Db::Sql::BusyHandler(policy);
+
+    EXPECT_TRUE(handler.awaitTransactionRetry(1));
+    EXPECT_TRUE(handler.awaitTransactionRetry(2));
+    EXPECT_FALSE(handler.awaitTransactionRetry(3));
+    auto stats = handler.stats();
+    EXPECT_EQ(2, stats.transactionRetries);
+    EXPECT_GT(stats.waitTime.count(), 0);
+}
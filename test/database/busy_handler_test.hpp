@@ -0,0 +1,19 @@
+#pragma once
+
+#include "sqlite3/sqlite3.h"
+#include "database/busy_handler.hpp"
+#include <gtest/gtest.h>
+
+class BusyHandlerTest : public ::testing::Test {
+   protected:
+    const char *dbPath = "busy_handler_test.db";
+    // The connection which holds the lock awaited by db.
+    sqlite3 *locker{};
+    sqlite3 *db{};
+
+    void SetUp() override;
+
+    void TearDown() override;
+
+    static Db::BusyPolicy timeoutPolicy(int timeoutMs);
+};
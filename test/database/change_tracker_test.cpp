@@ -0,0 +1,143 @@
+#include "change_tracker_test.hpp"
+#include "database/sqlite_exception.hpp"
+#include "core/test_exceptions_macros.hpp"
+
+/* PRIVATE */ namespace {
+
+Db::TableChanges tableChanges(std::string table,
+                              std::vector<long long> inserted,
+                              std::vector<long long> updated,
+                              std::vector<long long> deleted) {
+    return Db::TableChanges{std::move(table), std::move(inserted), std::move(updated), std::move(deleted)};
+}
+}
+
+void ChangeTrackerTest::SetUp() {
+    db = std::make_shared<Db::Sql::Database>(":memory:", SQLITE_OPEN_READWRITE);
+    db->createStatement("CREATE TABLE dummy_table (col_int INTEGER)")->execute<void>();
+    db->addChangeListener([this](const std::vector<Db::TableChanges> &changes) {
+        notifications.push_back(changes);
+    });
+}
+
+void ChangeTrackerTest::TearDown() {
+    db = nullptr;
+}
+
+TEST_F(ChangeTrackerTest, givenStatementOutsideTransactionWhenItIsExecutedThenChangesAreNotified) {
+    db->createStatement("INSERT INTO dummy_table (col_int) VALUES (1)")->execute<void>();
+
+    ASSERT_EQ(1, notifications.size());
+    EXPECT_EQ(std::vector<Db::TableChanges>({tableChanges("dummy_table", {1}, {}, {})}), notifications[0]);
+}
+
+TEST_F(ChangeTrackerTest, givenTransactionWhenItIsCommittedThenCoalescedChangesAreNotifiedOnce) {
+    db->createStatement("INSERT INTO dummy_table (rowid, col_int) VALUES (1, 1), (2, 2)")->execute<void>();
+    notifications.clear();
+
+    db->executeTransaction([&] {
+        db->createStatement("INSERT INTO dummy_table (rowid, col_int) VALUES (3, 3), (4, 4)")->execute<void>();
+        db->createStatement("UPDATE dummy_table SET col_int = 5 WHERE rowid IN (1, 3)")->execute<void>();
+        db->createStatement("DELETE FROM dummy_table WHERE rowid IN (2, 4)")->execute<void>();
+        // The listener isn't notified before the commit.
+        EXPECT_TRUE(notifications.empty());
+    });
+
+    ASSERT_EQ(1, notifications.size());
+    EXPECT_EQ(std::vector<Db::TableChanges>({tableChanges("dummy_table", {3}, {1}, {2})}), notifications[0]);
+}
+
+TEST_F(ChangeTrackerTest, givenFailingTransactionWhenItIsRolledBackThenChangesAreNotNotified) {
+    EXPECT_LIB_THROW(db->executeTransaction([&] {
+        db->createStatement("INSERT INTO dummy_table (col_int) VALUES (1)")->execute<void>();
+        db->createStatement("INVALID STATEMENT")->execute<void>();
+    }), Db::Sql::Exception);
+    db->createStatement("INSERT INTO dummy_table (rowid, col_int) VALUES (7, 2)")->execute<void>();
+
+    ASSERT_EQ(1, notifications.size());
+    EXPECT_EQ(std::vector<Db::TableChanges>({tableChanges("dummy_table", {7}, {}, {})}), notifications[0]);
+}
+
+TEST_F(ChangeTrackerTest, givenFailingNestedTransactionWhenItIsRolledBackThenOnlyOuterChangesAreNotified) {
+    db->executeTransaction([&] {
+        db->createStatement("INSERT INTO dummy_table (rowid, col_int) VALUES (1, 1)")->execute<void>();
+        EXPECT_LIB_THROW(db->executeTransaction([&] {
+            db->createStatement("INSERT INTO dummy_table (rowid, col_int) VALUES (2, 2)")->execute<void>();
+            db->createStatement("INVALID STATEMENT")->execute<void>();
+        }), Db::Sql::Exception);
+    });
+
+    ASSERT_EQ(1, notifications.size());
+    EXPECT_EQ(std::vector<Db::TableChanges>({tableChanges("dummy_table", {1}, {}, {})}), notifications[0]);
+}
+
+TEST_F(ChangeTrackerTest, givenAbortedBatchWhenItIsRolledBackThenChangesAreNotNotified) {
+    db->createStatement("CREATE UNIQUE INDEX dummy_index ON dummy_table (col_int)")->execute<void>();
+    auto stmt = db->createStatement("INSERT INTO dummy_table (col_int) VALUES (?)");
+
+    EXPECT_LIB_THROW(stmt->executeBatch(std::vector<std::tuple<int>>({
+        std::make_tuple(1),
+        std::make_tuple(1)
+    }), Db::Statement::BatchMode::AbortOnFailure), Db::Sql::Exception);
+
+    EXPECT_TRUE(notifications.empty());
+}
+
+TEST_F(ChangeTrackerTest, givenRemovedListenerWhenChangesAreCommittedThenItIsNotNotified) {
+    int otherNotifications = 0;
+    auto listenerId = db->addChangeListener([&otherNotifications](const std::vector<Db::TableChanges> &) {
+        otherNotifications++;
+    });
+
+    db->removeChangeListener(listenerId);
+    db->createStatement("INSERT INTO dummy_table (col_int) VALUES (1)")->execute<void>();
+
+    EXPECT_EQ(0, otherNotifications);
+    EXPECT_EQ(1, notifications.size());
+}
+
+TEST_F(ChangeTrackerTest, givenListenerWritingWhenItIsNotifiedThenItsChangesAreNotifiedAfterwards) {
+    bool written = false;
+    db->addChangeListener([&](const std::vector<Db::TableChanges> &) {
+        if (!written) {
+            written = true;
+            db->createStatement("INSERT INTO dummy_table (rowid, col_int) VALUES (9, 9)")->execute<void>();
+        }
+    });
+
+    db->createStatement("INSERT INTO dummy_table (rowid, col_int) VALUES (1, 1)")->execute<void>();
+
+    ASSERT_EQ(2, notifications.size());
+    EXPECT_EQ(std::vector<Db::TableChanges>({tableChanges("dummy_table", {9}, {}, {})}), notifications[1]);
+}
+
+TEST(ChangeTrackerCoalesceTest, givenChangesOfSameRowWhenCoalesceIsInvokedThenLastStateIsReturned) {
+    auto changes = Db::Sql::ChangeTracker::coalesce({
+        // Inserted and updated.
+        std::make_tuple(SQLITE_INSERT, std::string("b"), 1LL),
+        std::make_tuple(SQLITE_UPDATE, std::string("b"), 1LL),
+        // Inserted and deleted.
+        std::make_tuple(SQLITE_INSERT, std::string("b"), 2LL),
+        std::make_tuple(SQLITE_DELETE, std::string("b"), 2LL),
+        // Deleted and inserted again.
+        std::make_tuple(SQLITE_DELETE, std::string("a"), 3LL),
+        std::make_tuple(SQLITE_INSERT, std::string("a"), 3LL),
+        // Updated and deleted.
+        std::make_tuple(SQLITE_UPDATE, std::string("a"), 4LL),
+        std::make_tuple(SQLITE_DELETE, std::string("a"), 4LL)
+    });
+
+    EXPECT_EQ(std::vector<Db::TableChanges>({
+        tableChanges("a", {}, {3}, {4}),
+        tableChanges("b", {1}, {}, {})
+    }), changes);
+}
+
+TEST(ChangeTrackerCoalesceTest, givenRowInsertedAndDeletedWhenCoalesceIsInvokedThenItsTableIsNotReturned) {
+    auto changes = Db::Sql::ChangeTracker::coalesce({
+        std::make_tuple(SQLITE_INSERT, std::string("a"), 1LL),
+        std::make_tuple(SQLITE_DELETE, std::string("a"), 1LL)
+    });
+
+    EXPECT_TRUE(changes.empty());
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+#include "database/sqlite_database.hpp"
+
+class ChangeTrackerTest : public ::testing::Test {
+   protected:
+    std::shared_ptr<Db::Sql::Database> db;
+    // The changes received by the listener, one element for each notification.
+    std::vector<std::vector<Db::TableChanges>> notifications;
+
+    void SetUp() override;
+
+    void TearDown() override;
+};
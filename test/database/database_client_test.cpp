@@ -36,4 +36,14 @@ TEST_F(DatabaseClientTest, givenInitializedDbWhenInitializeIsInvokedMultipleTime
 
     // They should point to the same location.
     EXPECT_EQ(secondDb, db);
+}
+
+TEST_F(DatabaseClientTest, givenOptionsWhenCreateIsInvokedThenOptionsAreAppliedToDb) {
+    auto options = Db::Options();
+    options.tempStore = Db::TempStore::Memory;
+
+    Db::Client::create(":memory:", options);
+
+    // MEMORY is 2.
+    EXPECT_EQ(2, Db::Client::get()->createStatement("PRAGMA temp_store")->execute<int>());
 }
\ No newline at end of file
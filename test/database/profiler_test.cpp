@@ -0,0 +1,165 @@
+#include "profiler_test.hpp"
+#include "database/sqlite_database.hpp"
+
+void ProfilerTest::SetUp() {
+    sqlite3_open(":memory:", &db);
+    sqlite3_exec(db,
+                 "CREATE TABLE dummy_table (col_int INTEGER PRIMARY KEY, col_text TEXT);"
+                 "INSERT INTO dummy_table (col_int, col_text) VALUES (1, 'first'), (2, 'second'), (3, 'third');",
+                 nullptr,
+                 nullptr,
+                 nullptr);
+    profiler.install(db);
+}
+
+void ProfilerTest::TearDown() {
+    sqlite3_close(db);
+}
+
+void ProfilerTest::execute(const char *sql) {
+    sqlite3_exec(db, sql, nullptr, nullptr, nullptr);
+}
+
+Db::Sql::Profiler::Entry ProfilerTest::entryOf(const std::string &sql) {
+    for (auto &entry : profiler.entries()) {
+        if (entry.sql == sql) {
+            return entry;
+        }
+    }
+    ADD_FAILURE() << "The statement \"" << sql << "\" wasn't profiled.";
+    return Db::Sql::Profiler::Entry{};
+}
+
+TEST(ProfilerNormalizeTest, givenQueryWithLiteralsWhenNormalizeIsInvokedThenLiteralsAreReplaced) {
+    EXPECT_EQ("SELECT * FROM note2 WHERE id = ? AND title = ? LIMIT ?",
+              Db::Sql::Profiler::normalize("SELECT *  FROM note2\n WHERE id = 12 AND title = 'it''s' LIMIT 1.5 "));
+}
+
+TEST(ProfilerNormalizeTest, givenQueryWithParametersWhenNormalizeIsInvokedThenParametersAreKept) {
+    EXPECT_EQ("SELECT * FROM notes WHERE id = ?2 OR title = :title",
+              Db::Sql::Profiler::normalize("SELECT * FROM notes WHERE id = ?2 OR title = :title"));
+}
+
+TEST_F(ProfilerTest, givenExecutedQueriesWhenEntriesAreRetrievedThenCallsAndRowsAreCounted) {
+    execute("SELECT col_text FROM dummy_table WHERE col_int = 1");
+    execute("SELECT col_text FROM dummy_table WHERE col_int = 2");
+    execute("SELECT col_text FROM dummy_table");
+
+    auto lookup = entryOf("SELECT col_text FROM dummy_table WHERE col_int = ?");
+    EXPECT_EQ(2, lookup.calls);
+    EXPECT_EQ(2, lookup.rows);
+    EXPECT_EQ(0, lookup.fullScanSteps);
+    auto scan = entryOf("SELECT col_text FROM dummy_table");
+    EXPECT_EQ(1, scan.calls);
+    EXPECT_EQ(3, scan.rows);
+    EXPECT_GE(scan.totalTimeNs, scan.p99TimeNs);
+    EXPECT_GE(scan.p99TimeNs, scan.p50TimeNs);
+}
+
+TEST_F(ProfilerTest, givenLikeQueryWhenItIsExecutedThenFullScanIsCounted) {
+    execute("SELECT col_int FROM dummy_table WHERE col_text LIKE '%ir%'");
+
+    auto entry = entryOf("SELECT col_int FROM dummy_table WHERE col_text LIKE ?");
+    EXPECT_EQ(2, entry.rows);
+    EXPECT_EQ(2, entry.fullScanSteps);
+}
+
+TEST_F(ProfilerTest, givenQueryOrderedByUnindexedColumnWhenItIsExecutedThenSortIsCounted) {
+    execute("SELECT col_int FROM dummy_table ORDER BY col_text");
+
+    EXPECT_EQ(1, entryOf("SELECT col_int FROM dummy_table ORDER BY col_text").sorts);
+}
+
+TEST_F(ProfilerTest, givenSameStatementExecutedTwiceWhenEntriesAreRetrievedThenCountersAreNotDuplicated) {
+    sqlite3_stmt *stmt;
+    sqlite3_prepare_v2(db, "SELECT col_int FROM dummy_table WHERE col_text LIKE '%ir%'", -1, &stmt, nullptr);
+    while (sqlite3_step(stmt) == SQLITE_ROW) {}
+    sqlite3_reset(stmt);
+    while (sqlite3_step(stmt) == SQLITE_ROW) {}
+    sqlite3_finalize(stmt);
+
+    auto entry = entryOf("SELECT col_int FROM dummy_table WHERE col_text LIKE ?");
+    EXPECT_EQ(2, entry.calls);
+    EXPECT_EQ(4, entry.rows);
+    EXPECT_EQ(4, entry.fullScanSteps);
+}
+
+TEST_F(ProfilerTest, givenProfiledQueryWhenToJsonIsInvokedThenEscapedJsonIsReturned) {
+    profiler.clear();
+    execute("SELECT \"col_int\" FROM dummy_table WHERE col_int = 1");
+
+    auto json = profiler.toJson();
+
+    EXPECT_EQ(0, json.find("{\"statements\":[{\"sql\":\"SELECT \\\"col_int\\\" FROM dummy_table WHERE col_int = ?\","
+                           "\"calls\":1,\"rows\":1,\"totalTimeNs\":"));
+    EXPECT_NE(std::string::npos, json.find("\"fullScanSteps\":0,\"sorts\":0,\"autoIndexes\":0}]}"));
+}
+
+TEST_F(ProfilerTest, givenClearedProfilerWhenToJsonIsInvokedThenNoStatementIsReturned) {
+    execute("SELECT col_int FROM dummy_table");
+
+    profiler.clear();
+
+    EXPECT_TRUE(profiler.entries().empty());
+    EXPECT_EQ("{\"statements\":[]}", profiler.toJson());
+}
+
+TEST(ProfilerDatabaseTest, givenProfilingOptionWhenStatementsAreExecutedThenTheyAreProfiled) {
+    auto options = Db::Options();
+    options.profiling = true;
+    auto db = Db::Sql::Database(":memory:", SQLITE_OPEN_READWRITE, options);
+
+    db.createStatement("CREATE TABLE dummy_table (col_int INTEGER)")->execute<void>();
+    db.createStatement("SELECT COUNT(*) FROM dummy_table")->execute<int>();
+
+    ASSERT_TRUE(db.getProfiler() != nullptr);
+    auto entries = db.getProfiler()->entries();
+    EXPECT_EQ(2, entries.size());
+}
+
+TEST(ProfilerDatabaseTest, givenDefaultOptionsWhenDatabaseIsCreatedThenItIsNotProfiled) {
+    auto db = Db::Sql::Database(":memory:", SQLITE_OPEN_READWRITE);
+
+    EXPECT_TRUE(db.getProfiler() == nullptr);
+}
+
+TEST_F(ProfilerTest, givenRowsReturnedBeforeClearWhenExecutionEndsThenOnlyFollowingRowsAreCounted) {
+    sqlite3_stmt *stmt;
+    sqlite3_prepare_v2(db, "SELECT col_int FROM dummy_table", -1, &stmt, nullptr);
+    ASSERT_EQ(SQLITE_ROW, sqlite3_step(stmt));
+
+    profiler.clear();
+    while (sqlite3_step(stmt) == SQLITE_ROW) {}
+    sqlite3_finalize(stmt);
+
+    auto entry = entryOf("SELECT col_int FROM dummy_table");
+    EXPECT_EQ(1, entry.calls);
+    EXPECT_EQ(2, entry.rows);
+}
+
+TEST_F(ProfilerTest, givenConnectionsSharingProfilerWhenTheirRowsAreInterleavedThenTheyAreMerged) {
+    sqlite3 *otherDb;
+    sqlite3_open(":memory:", &otherDb);
+    sqlite3_exec(otherDb,
+                 "CREATE TABLE dummy_table (col_int INTEGER PRIMARY KEY, col_text TEXT);"
+                 "INSERT INTO dummy_table (col_int, col_text) VALUES (1, 'first'), (2, 'second');",
+                 nullptr,
+                 nullptr,
+                 nullptr);
+    profiler.install(otherDb);
+    sqlite3_stmt *stmt;
+    sqlite3_prepare_v2(db, "SELECT col_int FROM dummy_table", -1, &stmt, nullptr);
+    sqlite3_stmt *otherStmt;
+    sqlite3_prepare_v2(otherDb, "SELECT col_int FROM dummy_table", -1, &otherStmt, nullptr);
+
+    ASSERT_EQ(SQLITE_ROW, sqlite3_step(stmt));
+    while (sqlite3_step(otherStmt) == SQLITE_ROW) {}
+    while (sqlite3_step(stmt) == SQLITE_ROW) {}
+    sqlite3_finalize(otherStmt);
+    sqlite3_finalize(stmt);
+    sqlite3_close(otherDb);
+
+    auto entry = entryOf("SELECT col_int FROM dummy_table");
+    EXPECT_EQ(2, entry.calls);
+    EXPECT_EQ(5, entry.rows);
+}
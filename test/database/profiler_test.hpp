@@ -0,0 +1,19 @@
+#pragma once
+
+#include "sqlite3/sqlite3.h"
+#include "database/profiler.hpp"
+#include <gtest/gtest.h>
+
+class ProfilerTest : public ::testing::Test {
+   protected:
+    sqlite3 *db{};
+    Db::Sql::Profiler profiler;
+
+    void SetUp() override;
+
+    void TearDown() override;
+
+    void execute(const char *sql);
+
+    Db::Sql::Profiler::Entry entryOf(const std::string &sql);
+};
@@ -0,0 +1,114 @@
+#include <cstdio>
+#include <future>
+#include "reader_pool_test.hpp"
+#include "database/reader_pool.hpp"
+
+void ReaderPoolTest::SetUp() {
+    auto options = Db::Options();
+    options.journalMode = Db::JournalMode::Wal;
+    writer = std::make_unique<Db::Sql::Database>(dbPath, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, options);
+    writer->createStatement("CREATE TABLE dummy_table (col_int INTEGER)")->execute<void>();
+    writer->createStatement("INSERT INTO dummy_table (col_int) VALUES (1), (2)")->execute<void>();
+}
+
+void ReaderPoolTest::TearDown() {
+    writer = nullptr;
+    std::remove(dbPath);
+    std::remove((std::string(dbPath) + "-wal").c_str());
+    std::remove((std::string(dbPath) + "-shm").c_str());
+}
+
+Db::Options ReaderPoolTest::readerOptions(size_t readerConnections) {
+    auto options = Db::Options();
+    options.readerConnections = readerConnections;
+    return options;
+}
+
+TEST_F(ReaderPoolTest, givenReaderConnectionsWhenPoolIsCreatedThenReadersAreOpened) {
+    auto pool = Db::Sql::ReaderPool(*writer, dbPath, readerOptions(3));
+
+    EXPECT_EQ(3, pool.size());
+}
+
+TEST_F(ReaderPoolTest, givenReadQueryWhenCreateStatementIsInvokedThenStatementRunsOnReader) {
+    auto pool = Db::Sql::ReaderPool(*writer, dbPath, readerOptions(1));
+
+    auto stmt = pool.createStatement("SELECT COUNT(*) FROM dummy_table");
+
+    ASSERT_TRUE(stmt != nullptr);
+    EXPECT_EQ(2, stmt->execute<int>());
+    EXPECT_EQ(1, pool.stats().leases);
+}
+
+TEST_F(ReaderPoolTest, givenWriteQueryWhenCreateStatementIsInvokedThenNullIsReturned) {
+    auto pool = Db::Sql::ReaderPool(*writer, dbPath, readerOptions(1));
+
+    EXPECT_TRUE(pool.createStatement("INSERT INTO dummy_table (col_int) VALUES (3)") == nullptr);
+    EXPECT_TRUE(pool.createStatement("BEGIN TRANSACTION") == nullptr);
+    EXPECT_TRUE(pool.createStatement("INSERT INTO dummy_table (col_int) VALUES (3)") == nullptr);
+    // The queries are classified on the writer, so they don't lease any reader.
+    EXPECT_EQ(0, pool.stats().leases);
+}
+
+TEST_F(ReaderPoolTest, givenReaderLeasedByAnotherThreadWhenCreateStatementIsInvokedWithWriteQueryThenItDoesNotWait) {
+    auto pool = Db::Sql::ReaderPool(*writer, dbPath, readerOptions(1));
+    auto stmt = pool.createStatement("SELECT COUNT(*) FROM dummy_table");
+
+    auto writeStmt = std::async(std::launch::async, [&pool] {
+        return pool.createStatement("INSERT INTO dummy_table (col_int) VALUES (3)");
+    });
+
+    EXPECT_TRUE(writeStmt.get() == nullptr);
+    EXPECT_EQ(1, pool.stats().leases);
+    EXPECT_EQ(0, pool.stats().waits);
+}
+
+TEST_F(ReaderPoolTest, givenReaderLeasedByCurrentThreadWhenCreateStatementIsInvokedThenSameReaderIsUsed) {
+    auto pool = Db::Sql::ReaderPool(*writer, dbPath, readerOptions(1));
+    auto cursor = pool.createStatement("SELECT col_int FROM dummy_table")->execute<std::shared_ptr<Db::Cursor>>();
+    ASSERT_TRUE(cursor->next());
+
+    // The only reader is owned by the cursor but the thread doesn't wait for itself.
+    auto count = pool.createStatement("SELECT COUNT(*) FROM dummy_table")->execute<int>();
+
+    EXPECT_EQ(2, count);
+    EXPECT_EQ(1, pool.stats().leases);
+    EXPECT_EQ(0, pool.stats().waits);
+}
+
+TEST_F(ReaderPoolTest, givenReaderLeasedByAnotherThreadWhenCreateStatementIsInvokedThenThreadWaitsForIt) {
+    auto pool = Db::Sql::ReaderPool(*writer, dbPath, readerOptions(1));
+    auto stmt = pool.createStatement("SELECT COUNT(*) FROM dummy_table");
+
+    auto count = std::async(std::launch::async, [&pool] {
+        return pool.createStatement("SELECT COUNT(*) FROM dummy_table")->execute<int>();
+    });
+    // Wait until the other thread is blocked on the only reader, then release it.
+    while (pool.stats().waits == 0) {
+        std::this_thread::yield();
+    }
+    stmt = nullptr;
+
+    EXPECT_EQ(2, count.get());
+    EXPECT_EQ(2, pool.stats().leases);
+}
+
+TEST_F(ReaderPoolTest, givenCommittedWriteWhenReaderQueriesThenChangeIsVisible) {
+    auto pool = Db::Sql::ReaderPool(*writer, dbPath, readerOptions(1));
+
+    writer->createStatement("INSERT INTO dummy_table (col_int) VALUES (3)")->execute<void>();
+
+    EXPECT_EQ(3, pool.createStatement("SELECT COUNT(*) FROM dummy_table")->execute<int>());
+}
+
+TEST_F(ReaderPoolTest, givenProfilerWhenReadQueryRunsOnReaderThenItIsRecordedByTheSameProfiler) {
+    auto profiler = std::make_shared<Db::Sql::Profiler>();
+    auto pool = Db::Sql::ReaderPool(*writer, dbPath, readerOptions(2), profiler);
+
+    pool.createStatement("SELECT COUNT(*) FROM dummy_table")->execute<int>();
+
+    auto entries = profiler->entries();
+    ASSERT_EQ(1, entries.size());
+    EXPECT_EQ("SELECT COUNT(*) FROM dummy_table", entries[0].sql);
+    EXPECT_EQ(1, entries[0].rows);
+}
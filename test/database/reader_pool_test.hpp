@@ -0,0 +1,17 @@
+#pragma once
+
+#include <memory>
+#include <gtest/gtest.h>
+#include "database/sqlite_database.hpp"
+
+class ReaderPoolTest : public ::testing::Test {
+   protected:
+    const char *dbPath = "reader_pool_test.db";
+    std::unique_ptr<Db::Sql::Database> writer;
+
+    void SetUp() override;
+
+    void TearDown() override;
+
+    Db::Options readerOptions(size_t readerConnections);
+};
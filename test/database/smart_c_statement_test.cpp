@@ -1,3 +1,5 @@
+#include <thread>
+#include <vector>
 #include "smart_c_statement_test.hpp"
 #include "database/smart_c_statement.hpp"
 #include "database/sqlite_exception.hpp"
@@ -115,4 +117,22 @@ TEST_F(SmartCStatementTest, givenMultipleOwnersWhenUseCountIsInvokedThenTheOwner
     // The count will be increased to 3 again since we are invoking the copy constructor.
     auto secondCopy = stmt;
     ASSERT_EQ(2, stmt.useCount());
-}
\ No newline at end of file
+}
+
+TEST_F(SmartCStatementTest, givenCopiesOnMultipleThreadsWhenTheyAreDestroyedThenUseCountIsConsistent) {
+    auto stmt = Db::Sql::SmartCStatement(db, "SELECT col_int FROM dummy_table");
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&stmt] {
+            for (int copy = 0; copy < 10000; copy++) {
+                auto owner = Db::Sql::SmartCStatement(stmt);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(1, stmt.useCount());
+}
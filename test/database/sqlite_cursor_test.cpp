@@ -1,5 +1,6 @@
 #include "sqlite_cursor_test.hpp"
 #include "database/smart_c_statement.hpp"
+#include "database/database_exception.hpp"
 #include "database/sqlite_exception.hpp"
 #include "core/test_exceptions_macros.hpp"
 
@@ -92,6 +93,29 @@ TEST_F(SQLiteCursorTest, givenTrueNextWhenGetIntIsInvokedOnCorrectColumnThenValu
     EXPECT_EQ(expected, value);
 }
 
+TEST_F(SQLiteCursorTest, givenTrueNextWhenGetInt64IsInvokedOnDifferentTypeColumnThenExceptionIsThrown) {
+    insertRecord("text", 4.5, 2, true);
+    auto cursor = selectAll();
+    cursor->next();
+
+    EXPECT_LIB_THROW(cursor->get<long long>(1), Db::Sql::Exception);
+}
+
+TEST_F(SQLiteCursorTest, givenRecordsWhenForEachRowIsInvokedWithInt64ThenValuesAreDecoded) {
+    insertRecord("text", 4.5, 2147483647, true);
+    auto cursor = selectAll();
+    std::vector<long long> values;
+
+    cursor->forEachRow<stdx::string_view, double, long long, bool>([&values](stdx::string_view,
+                                                                             double,
+                                                                             long long value,
+                                                                             bool) {
+        values.push_back(value + 1);
+    });
+
+    EXPECT_EQ(std::vector<long long>({2147483648LL}), values);
+}
+
 TEST_F(SQLiteCursorTest, givenFalseNextWhenGetDoubleIsInvokedThenExceptionIsThrown) {
     auto cursor = selectAll();
     cursor->next();
@@ -214,6 +238,115 @@ TEST_F(SQLiteCursorTest, givenTrueNextWhenGetStringIsInvokedOnCorrectColumnThenV
     EXPECT_EQ(expected, value);
 }
 
+TEST_F(SQLiteCursorTest, givenFalseNextWhenGetStringViewIsInvokedThenExceptionIsThrown) {
+    auto cursor = selectAll();
+    cursor->next();
+
+    EXPECT_LIB_THROW(cursor->get<stdx::string_view>(0), Db::Sql::Exception);
+}
+
+TEST_F(SQLiteCursorTest, givenTrueNextWhenGetStringViewIsInvokedOnOutOfIndexColumnThenExceptionIsThrown) {
+    insertRecord("text", 4.5, 2, true);
+    auto cursor = selectAll();
+    cursor->next();
+
+    EXPECT_LIB_THROW(cursor->get<stdx::string_view>(67), Db::Sql::Exception);
+}
+
+TEST_F(SQLiteCursorTest, givenTrueNextWhenGetStringViewIsInvokedOnDifferentTypeColumnThenExceptionIsThrown) {
+    insertRecord("text", 4.5, 2, true);
+    auto cursor = selectAll();
+    cursor->next();
+
+    EXPECT_LIB_THROW(cursor->get<stdx::string_view>(2), Db::Sql::Exception);
+}
+
+TEST_F(SQLiteCursorTest, givenTrueNextWhenGetStringViewIsInvokedOnCorrectColumnThenValueIsReturned) {
+    auto expected = "text";
+    insertRecord(expected, 4.5, 2, true);
+    auto cursor = selectAll();
+    cursor->next();
+
+    auto value = cursor->get<stdx::string_view>(0);
+
+    EXPECT_EQ(expected, value);
+    EXPECT_EQ(4, value.size());
+}
+
+TEST_F(SQLiteCursorTest, givenTextWithNullCharacterWhenGetStringIsInvokedThenWholeValueIsReturned) {
+    // The size of the text is read from SQLite so the null characters don't truncate it.
+    sqlite3_step(Db::Sql::SmartCStatement(
+        db,
+        "INSERT INTO dummy_table (col_string, col_double, col_int, col_bool) "
+        "VALUES (CAST(x'610062' AS TEXT), 4.5, 2, 1)"
+    ));
+    auto cursor = selectAll();
+    cursor->next();
+
+    auto value = cursor->get<std::string>(0);
+
+    EXPECT_EQ(std::string("a\0b", 3), value);
+}
+
+TEST_F(SQLiteCursorTest, givenRecordsWhenForEachRowIsInvokedThenConsumerReceivesDecodedValues) {
+    insertRecord("first", 4.5, 1, true);
+    insertRecord("second", 6.7, 2, false);
+    auto cursor = selectAll();
+    std::vector<std::string> texts;
+    std::vector<double> doubles;
+    std::vector<int> ints;
+    std::vector<bool> bools;
+
+    cursor->forEachRow<stdx::string_view, double, int, bool>([&](stdx::string_view text,
+                                                                 double doubleValue,
+                                                                 int intValue,
+                                                                 bool boolValue) {
+        texts.emplace_back(text);
+        doubles.push_back(doubleValue);
+        ints.push_back(intValue);
+        bools.push_back(boolValue);
+    });
+
+    EXPECT_EQ(std::vector<std::string>({"first", "second"}), texts);
+    EXPECT_EQ(std::vector<double>({4.5, 6.7}), doubles);
+    EXPECT_EQ(std::vector<int>({1, 2}), ints);
+    EXPECT_EQ(std::vector<bool>({true, false}), bools);
+}
+
+TEST_F(SQLiteCursorTest, givenRecordsWhenRowsIsInvokedThenTuplesAreReturned) {
+    insertRecord("first", 4.5, 1, true);
+    insertRecord("second", 6.7, 2, false);
+    auto cursor = selectAll();
+
+    auto rows = cursor->rows<std::string, double, int, bool>();
+
+    ASSERT_EQ(2, rows.size());
+    EXPECT_EQ(std::make_tuple(std::string("first"), 4.5, 1, true), rows[0]);
+    EXPECT_EQ(std::make_tuple(std::string("second"), 6.7, 2, false), rows[1]);
+}
+
+TEST_F(SQLiteCursorTest, givenZeroRecordsWhenRowsIsInvokedThenEmptyVectorIsReturned) {
+    auto cursor = selectAll();
+
+    auto rows = cursor->rows<std::string, double, int, bool>();
+
+    EXPECT_TRUE(rows.empty());
+}
+
+TEST_F(SQLiteCursorTest, givenDifferentColumnCountWhenRowsIsInvokedThenExceptionIsThrown) {
+    insertRecord("text", 4.5, 2, true);
+    auto cursor = selectAll();
+
+    EXPECT_LIB_THROW(cursor->rows<std::string>(), Db::Exception);
+}
+
+TEST_F(SQLiteCursorTest, givenDifferentColumnTypeWhenRowsIsInvokedThenExceptionIsThrown) {
+    insertRecord("text", 4.5, 2, true);
+    auto cursor = selectAll();
+
+    EXPECT_LIB_THROW((cursor->rows<int, double, int, bool>()), Db::Exception);
+}
+
 TEST_F(SQLiteCursorTest, givenErrorInSqliteStepWhenNextIsInvokedThenExceptionIsThrown) {
     insertRecord("text", 4.5, 1, true);
     // We try to insert a record with the same id to simulate a constraint violation.
@@ -1,3 +1,6 @@
+#include <atomic>
+#include <future>
+#include <stdexcept>
 #include <gtest/gtest.h>
 #include <database/sqlite_exception.hpp>
 #include "database/sqlite_database.hpp"
@@ -36,6 +39,496 @@ TEST(SQLiteDatabaseTest, givenInitializedDbWhenCreateStatementIsInvokedThenSqlSt
     EXPECT_TRUE(std::dynamic_pointer_cast<Db::Sql::Statement>(stmt));
 }
 
+TEST(SQLiteDatabaseTest, givenReleasedStatementWhenCreateStatementIsInvokedWithSameSqlThenCachedStatementIsUsed) {
+    auto db = Db::Sql::Database(":memory:", SQLITE_OPEN_READWRITE);
+    db.createStatement("PRAGMA user_version = 3")->execute<void>();
+
+    auto version = db.createStatement("PRAGMA user_version")->execute<int>();
+    version = db.createStatement("PRAGMA user_version")->execute<int>();
+
+    EXPECT_EQ(3, version);
+    EXPECT_EQ(1, db.statementCacheStats().hits);
+    EXPECT_EQ(2, db.statementCacheStats().misses);
+}
+
+TEST(SQLiteDatabaseTest, givenZeroCacheCapacityWhenCreateStatementIsInvokedThenStatementsAreNotCached) {
+    auto options = Db::Options();
+    options.statementCacheCapacity = 0;
+    auto db = Db::Sql::Database(":memory:", SQLITE_OPEN_READWRITE, options);
+
+    db.createStatement("PRAGMA user_version")->execute<int>();
+    db.createStatement("PRAGMA user_version")->execute<int>();
+
+    EXPECT_EQ(0, db.statementCacheStats().hits);
+    EXPECT_EQ(2, db.statementCacheStats().misses);
+}
+
+TEST(SQLiteDatabaseTest, givenDefaultOptionsWhenDatabaseIsCreatedThenSqliteDefaultsAreKept) {
+    auto db = Db::Sql::Database("sqlite_database_test.db", SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+
+    EXPECT_EQ("delete", db.createStatement("PRAGMA journal_mode")->execute<stdx::optional<std::string>>());
+    std::remove("sqlite_database_test.db");
+}
+
+TEST(SQLiteDatabaseTest, givenOptionsWhenDatabaseIsCreatedThenPragmasAreApplied) {
+    auto options = Db::Options();
+    options.pageSize = 8192;
+    options.journalMode = Db::JournalMode::Wal;
+    options.synchronous = Db::Synchronous::Normal;
+    options.cacheSize = -4096;
+    options.mmapSize = 1048576;
+    options.tempStore = Db::TempStore::Memory;
+    {
+        auto db = Db::Sql::Database("sqlite_database_test.db", SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, options);
+
+        EXPECT_EQ(8192, db.createStatement("PRAGMA page_size")->execute<int>());
+        EXPECT_EQ("wal", db.createStatement("PRAGMA journal_mode")->execute<stdx::optional<std::string>>());
+        // NORMAL is 1.
+        EXPECT_EQ(1, db.createStatement("PRAGMA synchronous")->execute<int>());
+        EXPECT_EQ(-4096, db.createStatement("PRAGMA cache_size")->execute<int>());
+        EXPECT_EQ(1048576, db.createStatement("PRAGMA mmap_size")->execute<int>());
+        // MEMORY is 2.
+        EXPECT_EQ(2, db.createStatement("PRAGMA temp_store")->execute<int>());
+    }
+    std::remove("sqlite_database_test.db");
+    std::remove("sqlite_database_test.db-wal");
+    std::remove("sqlite_database_test.db-shm");
+}
+
+TEST(SQLiteDatabaseTest, givenUriOptionWhenDatabaseIsCreatedThenPathIsInterpretedAsUri) {
+    auto options = Db::Options();
+    options.uri = true;
+    auto db = Db::Sql::Database("file:uri_test?mode=memory", SQLITE_OPEN_READWRITE, options);
+
+    db.createStatement("PRAGMA user_version = 5")->execute<void>();
+
+    EXPECT_EQ(5, db.createStatement("PRAGMA user_version")->execute<int>());
+}
+
+TEST(SQLiteDatabaseTest, givenReaderConnectionsWithoutWalWhenDatabaseIsCreatedThenExceptionIsThrown) {
+    auto options = Db::Options();
+    options.readerConnections = 2;
+
+    EXPECT_LIB_THROW(Db::Sql::Database(":memory:", SQLITE_OPEN_READWRITE, options), Db::Sql::Exception);
+}
+
+TEST(SQLiteDatabaseTest, givenReaderConnectionsWhenCreateStatementIsInvokedThenQueriesAreRoutedByType) {
+    auto options = Db::Options();
+    options.journalMode = Db::JournalMode::Wal;
+    options.readerConnections = 2;
+    {
+        auto db = Db::Sql::Database("sqlite_database_test.db", SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, options);
+        db.createStatement("CREATE TABLE dummy_table (col_int INTEGER)")->execute<void>();
+        db.createStatement("INSERT INTO dummy_table (col_int) VALUES (1)")->execute<void>();
+        // The query is prepared on the writer only the first time, to classify it.
+        auto count = db.createStatement("SELECT COUNT(*) FROM dummy_table")->execute<int>();
+        auto writerStats = db.statementCacheStats();
+
+        auto secondCount = db.createStatement("SELECT COUNT(*) FROM dummy_table")->execute<int>();
+
+        EXPECT_EQ(1, count);
+        EXPECT_EQ(1, secondCount);
+        // The query ran on a reader so it didn't reach the writer's cache.
+        EXPECT_EQ(writerStats.misses, db.statementCacheStats().misses);
+        EXPECT_EQ(writerStats.hits, db.statementCacheStats().hits);
+        EXPECT_EQ(2, db.readerPoolStats().leases);
+    }
+    std::remove("sqlite_database_test.db");
+    std::remove("sqlite_database_test.db-wal");
+    std::remove("sqlite_database_test.db-shm");
+}
+
+TEST(SQLiteDatabaseTest, givenReaderConnectionsWhenTransactionIsExecutedThenOnlyItsThreadReadsUncommittedChanges) {
+    auto options = Db::Options();
+    options.journalMode = Db::JournalMode::Wal;
+    options.readerConnections = 1;
+    {
+        auto db = Db::Sql::Database("sqlite_database_test.db", SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, options);
+        db.createStatement("CREATE TABLE dummy_table (col_int INTEGER)")->execute<void>();
+
+        db.executeTransaction([&db] {
+            db.createStatement("INSERT INTO dummy_table (col_int) VALUES (1)")->execute<void>();
+            // The transaction thread reads from the writer.
+            EXPECT_EQ(1, db.createStatement("SELECT COUNT(*) FROM dummy_table")->execute<int>());
+            // Any other thread reads from a reader, which sees only the committed changes.
+            auto otherThreadCount = std::async(std::launch::async, [&db] {
+                return db.createStatement("SELECT COUNT(*) FROM dummy_table")->execute<int>();
+            });
+            EXPECT_EQ(0, otherThreadCount.get());
+        });
+
+        EXPECT_EQ(1, db.createStatement("SELECT COUNT(*) FROM dummy_table")->execute<int>());
+    }
+    std::remove("sqlite_database_test.db");
+    std::remove("sqlite_database_test.db-wal");
+    std::remove("sqlite_database_test.db-shm");
+}
+
+TEST(SQLiteDatabaseTest, givenReaderConnectionsWhenDataVersionIsInvokedThenOnlyCommitsOfOtherConnectionsChangeIt) {
+    auto options = Db::Options();
+    options.journalMode = Db::JournalMode::Wal;
+    options.readerConnections = 1;
+    {
+        auto db = Db::Sql::Database("sqlite_database_test.db", SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, options);
+        db.createStatement("CREATE TABLE dummy_table (col_int INTEGER)")->execute<void>();
+        auto initialVersion = db.dataVersion();
+
+        db.createStatement("INSERT INTO dummy_table (col_int) VALUES (1)")->execute<void>();
+        auto versionAfterOwnCommit = db.dataVersion();
+        auto other = Db::Sql::Database("sqlite_database_test.db", SQLITE_OPEN_READWRITE);
+        other.createStatement("INSERT INTO dummy_table (col_int) VALUES (2)")->execute<void>();
+
+        EXPECT_EQ(initialVersion, versionAfterOwnCommit);
+        EXPECT_NE(initialVersion, db.dataVersion());
+    }
+    std::remove("sqlite_database_test.db");
+    std::remove("sqlite_database_test.db-wal");
+    std::remove("sqlite_database_test.db-shm");
+}
+
+#ifdef EXCEPTIONS_ENABLED
+TEST(SQLiteDatabaseTest, givenThrowingTransactionWhenExecuteTransactionIsInvokedThenChangesAreRolledBack) {
+    auto db = Db::Sql::Database(":memory:", SQLITE_OPEN_READWRITE);
+    db.createStatement("CREATE TABLE dummy_table (col_int INTEGER)")->execute<void>();
+
+    EXPECT_THROW(db.executeTransaction([&db] {
+        db.createStatement("INSERT INTO dummy_table (col_int) VALUES (1)")->execute<void>();
+        throw std::runtime_error("dummy-error");
+    }), std::runtime_error);
+
+    EXPECT_EQ(0, db.createStatement("SELECT COUNT(*) FROM dummy_table")->execute<int>());
+    // The database can start another transaction since the previous one was closed.
+    db.executeTransaction([&db] {
+        db.createStatement("INSERT INTO dummy_table (col_int) VALUES (2)")->execute<void>();
+    });
+    EXPECT_EQ(1, db.createStatement("SELECT COUNT(*) FROM dummy_table")->execute<int>());
+}
+
+TEST(SQLiteDatabaseTest, givenTransactionOnOtherThreadWhenStatementIsExecutedThenItIsNotRolledBackWithIt) {
+    auto db = Db::Sql::Database(":memory:", SQLITE_OPEN_READWRITE);
+    db.createStatement("CREATE TABLE dummy_table (col_int INTEGER)")->execute<void>();
+    std::promise<void> transactionStarted;
+    std::promise<void> insertionStarted;
+    std::atomic<bool> inserted(false);
+
+    auto transaction = std::async(std::launch::async, [&] {
+        db.executeTransaction([&] {
+            db.createStatement("INSERT INTO dummy_table (col_int) VALUES (1)")->execute<void>();
+            transactionStarted.set_value();
+            insertionStarted.get_future().wait();
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            // The insertion of the other thread waits for the end of this transaction instead of joining it.
+            EXPECT_FALSE(inserted);
+            throw std::runtime_error("dummy-error");
+        });
+    });
+    transactionStarted.get_future().wait();
+    auto insertion = std::async(std::launch::async, [&db, &inserted] {
+        db.createStatement("INSERT INTO dummy_table (col_int) VALUES (2)")->execute<void>();
+        inserted = true;
+    });
+    insertionStarted.set_value();
+
+    ASSERT_LIB_THROW(transaction.get(), std::runtime_error);
+    insertion.get();
+    EXPECT_EQ(2, db.createStatement("SELECT col_int FROM dummy_table")->execute<int>());
+    EXPECT_EQ(1, db.createStatement("SELECT COUNT(*) FROM dummy_table")->execute<int>());
+}
+
+TEST(SQLiteDatabaseTest, givenThrowingNestedTransactionWhenOuterTransactionCatchesItThenOnlyNestedOneIsRolledBack) {
+    auto db = Db::Sql::Database(":memory:", SQLITE_OPEN_READWRITE);
+    db.createStatement("CREATE TABLE dummy_table (col_int INTEGER)")->execute<void>();
+
+    db.executeTransaction([&db] {
+        db.createStatement("INSERT INTO dummy_table (col_int) VALUES (1)")->execute<void>();
+        try {
+            db.executeTransaction([&db] {
+                db.createStatement("INSERT INTO dummy_table (col_int) VALUES (2)")->execute<void>();
+                throw std::runtime_error("dummy-error");
+            });
+        } catch (const std::runtime_error &) {
+            // The outer transaction goes on.
+        }
+        db.createStatement("INSERT INTO dummy_table (col_int) VALUES (3)")->execute<void>();
+    });
+
+    auto values = db.createStatement("SELECT col_int FROM dummy_table ORDER BY col_int")->
+        execute<std::shared_ptr<Db::Cursor>>()->rows<int>();
+    EXPECT_EQ(std::vector<std::tuple<int>>({std::make_tuple(1), std::make_tuple(3)}), values);
+}
+
+TEST(SQLiteDatabaseTest, givenNoTransactionWhenExecuteAfterCommitIsInvokedThenActionIsExecutedImmediately) {
+    auto db = Db::Sql::Database(":memory:", SQLITE_OPEN_READWRITE);
+    bool executed = false;
+
+    db.executeAfterCommit([&executed] {
+        executed = true;
+    });
+
+    EXPECT_TRUE(executed);
+    EXPECT_FALSE(db.isInTransaction());
+}
+
+TEST(SQLiteDatabaseTest, givenNestedTransactionsWhenExecuteAfterCommitIsInvokedThenActionsWaitForOutermostCommit) {
+    auto db = Db::Sql::Database(":memory:", SQLITE_OPEN_READWRITE);
+    std::vector<int> actions;
+
+    db.executeTransaction([&] {
+        EXPECT_TRUE(db.isInTransaction());
+        db.executeAfterCommit([&actions] {
+            actions.push_back(1);
+        });
+        db.executeTransaction([&] {
+            db.executeAfterCommit([&actions] {
+                actions.push_back(2);
+            });
+        });
+        EXPECT_TRUE(actions.empty());
+    });
+
+    EXPECT_EQ(std::vector<int>({1, 2}), actions);
+    EXPECT_FALSE(db.isInTransaction());
+}
+
+TEST(SQLiteDatabaseTest, givenRolledBackTransactionsWhenExecuteAfterCommitIsInvokedThenTheirActionsAreDiscarded) {
+    auto db = Db::Sql::Database(":memory:", SQLITE_OPEN_READWRITE);
+    std::vector<int> actions;
+
+    EXPECT_THROW(db.executeTransaction([&] {
+        db.executeAfterCommit([&actions] {
+            actions.push_back(1);
+        });
+        throw std::runtime_error("dummy-error");
+    }), std::runtime_error);
+    db.executeTransaction([&] {
+        db.executeAfterCommit([&actions] {
+            actions.push_back(2);
+        });
+        try {
+            db.executeTransaction([&] {
+                db.executeAfterCommit([&actions] {
+                    actions.push_back(3);
+                });
+                throw std::runtime_error("dummy-error");
+            });
+        } catch (const std::runtime_error &) {
+            // The outer transaction goes on.
+        }
+    });
+
+    EXPECT_EQ(std::vector<int>({2}), actions);
+}
+
+TEST(SQLiteDatabaseTest, givenTransactionRetriesWhenTransactionIsBusyThenItIsExecutedAgain) {
+    auto options = Db::Options();
+    options.busyPolicy.transactionRetries = 2;
+    auto db = Db::Sql::Database(":memory:", SQLITE_OPEN_READWRITE, options);
+    db.createStatement("CREATE TABLE dummy_table (col_int INTEGER)")->execute<void>();
+
+    int attempts = 0;
+    db.executeTransaction([&db, &attempts] {
+        db.createStatement("INSERT INTO dummy_table (col_int) VALUES (1)")->execute<void>();
+        if (++attempts == 1) {
+            throw Db::Sql::Exception("dummy-busy-error", SQLITE_BUSY);
+        }
+    });
+
+    EXPECT_EQ(2, attempts);
+    // The changes of the failed attempt were rolled back.
+    EXPECT_EQ(1, db.createStatement("SELECT COUNT(*) FROM dummy_table")->execute<int>());
+    EXPECT_EQ(1, db.busyStats().transactionRetries);
+}
+
+TEST(SQLiteDatabaseTest, givenTransactionRetriesWhenTransactionFailsForOtherErrorsThenItIsNotExecutedAgain) {
+    auto options = Db::Options();
+    options.busyPolicy.transactionRetries = 2;
+    auto db = Db::Sql::Database(":memory:", SQLITE_OPEN_READWRITE, options);
+
+    int attempts = 0;
+    EXPECT_THROW(db.executeTransaction([&attempts] {
+        attempts++;
+        throw Db::Sql::Exception("dummy-error", SQLITE_CONSTRAINT);
+    }), Db::Sql::Exception);
+
+    EXPECT_EQ(1, attempts);
+    EXPECT_EQ(0, db.busyStats().transactionRetries);
+}
+
+TEST(SQLiteDatabaseTest, givenTransactionRetriesWhenTransactionIsAlwaysBusyThenExceptionIsThrownAfterLastAttempt) {
+    auto options = Db::Options();
+    options.busyPolicy.transactionRetries = 2;
+    auto db = Db::Sql::Database(":memory:", SQLITE_OPEN_READWRITE, options);
+
+    int attempts = 0;
+    int nestedAttempts = 0;
+    EXPECT_THROW(db.executeTransaction([&db, &attempts, &nestedAttempts] {
+        attempts++;
+        // Only the outermost transaction is executed again.
+        db.executeTransaction([&nestedAttempts] {
+            nestedAttempts++;
+            throw Db::Sql::Exception("dummy-busy-error", SQLITE_BUSY);
+        });
+    }), Db::Sql::Exception);
+
+    EXPECT_EQ(3, attempts);
+    EXPECT_EQ(3, nestedAttempts);
+    EXPECT_EQ(2, db.busyStats().transactionRetries);
+}
+#endif
+
+TEST(SQLiteDatabaseTest, givenBusyTimeoutWhenAnotherConnectionReleasesTheLockThenTransactionWaitsForIt) {
+    {
+        auto options = Db::Options();
+        options.busyPolicy.timeout = std::chrono::milliseconds(5000);
+        auto db = Db::Sql::Database("sqlite_database_test.db", SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, options);
+        db.createStatement("CREATE TABLE dummy_table (col_int INTEGER)")->execute<void>();
+        sqlite3 *otherDb;
+        sqlite3_open_v2("sqlite_database_test.db", &otherDb, SQLITE_OPEN_READWRITE, nullptr);
+        sqlite3_exec(otherDb, "BEGIN EXCLUSIVE", nullptr, nullptr, nullptr);
+
+        auto release = std::async(std::launch::async, [otherDb] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            sqlite3_exec(otherDb, "COMMIT", nullptr, nullptr, nullptr);
+        });
+        db.executeTransaction([&db] {
+            db.createStatement("INSERT INTO dummy_table (col_int) VALUES (1)")->execute<void>();
+        }, Db::TransactionMode::Immediate);
+        release.wait();
+
+        EXPECT_EQ(1, db.createStatement("SELECT COUNT(*) FROM dummy_table")->execute<int>());
+        auto stats = db.busyStats();
+        EXPECT_GT(stats.retries, 0);
+        EXPECT_EQ(0, stats.timeouts);
+        EXPECT_GT(stats.waitTime.count(), 0);
+        sqlite3_close(otherDb);
+    }
+    std::remove("sqlite_database_test.db");
+}
+
+TEST(SQLiteDatabaseTest, givenNestedTransactionsWhenTheyReturnThenAllChangesAreCommitted) {
+    auto db = Db::Sql::Database(":memory:", SQLITE_OPEN_READWRITE);
+    db.createStatement("CREATE TABLE dummy_table (col_int INTEGER)")->execute<void>();
+
+    db.executeTransaction([&db] {
+        db.createStatement("INSERT INTO dummy_table (col_int) VALUES (1)")->execute<void>();
+        db.executeTransaction([&db] {
+            db.createStatement("INSERT INTO dummy_table (col_int) VALUES (2)")->execute<void>();
+            db.executeTransaction([&db] {
+                db.createStatement("INSERT INTO dummy_table (col_int) VALUES (3)")->execute<void>();
+            });
+        });
+    });
+
+    EXPECT_EQ(3, db.createStatement("SELECT COUNT(*) FROM dummy_table")->execute<int>());
+}
+
+TEST(SQLiteDatabaseTest, givenImmediateModeWhenTransactionStartsThenWriteLockIsAcquired) {
+    {
+        auto db = Db::Sql::Database("sqlite_database_test.db", SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+        sqlite3 *otherDb;
+        sqlite3_open_v2("sqlite_database_test.db", &otherDb, SQLITE_OPEN_READWRITE, nullptr);
+
+        db.executeTransaction([otherDb] {
+            // Another writer can't start while the lock is held.
+            EXPECT_EQ(SQLITE_BUSY, sqlite3_exec(otherDb, "BEGIN IMMEDIATE", nullptr, nullptr, nullptr));
+        }, Db::TransactionMode::Immediate);
+        db.executeTransaction([otherDb] {
+            // The deferred transaction didn't read or write anything so it doesn't hold any lock.
+            EXPECT_EQ(SQLITE_OK, sqlite3_exec(otherDb, "BEGIN IMMEDIATE", nullptr, nullptr, nullptr));
+            sqlite3_exec(otherDb, "ROLLBACK", nullptr, nullptr, nullptr);
+        }, Db::TransactionMode::Deferred);
+
+        sqlite3_close(otherDb);
+    }
+    std::remove("sqlite_database_test.db");
+}
+
+TEST(SQLiteDatabaseTest, givenNoWriterThreadWhenSubmitTransactionIsInvokedThenItIsExecutedOnCallerThread) {
+    auto db = Db::Sql::Database(":memory:", SQLITE_OPEN_READWRITE);
+    db.createStatement("CREATE TABLE dummy_table (col_int INTEGER)")->execute<void>();
+
+    auto future = db.submitTransaction([&db] {
+        db.createStatement("INSERT INTO dummy_table (col_int) VALUES (1)")->execute<void>();
+    });
+
+    EXPECT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds(0)));
+    EXPECT_EQ(1, db.createStatement("SELECT COUNT(*) FROM dummy_table")->execute<int>());
+    EXPECT_EQ(0, db.writeExecutorStats().transactions);
+}
+
+TEST(SQLiteDatabaseTest, givenWriterThreadWhenSubmitTransactionIsInvokedThenItIsExecutedOnWriterThread) {
+    auto options = Db::Options();
+    options.writerThread = true;
+    auto db = Db::Sql::Database(":memory:", SQLITE_OPEN_READWRITE, options);
+    db.createStatement("CREATE TABLE dummy_table (col_int INTEGER)")->execute<void>();
+
+    auto callerThread = std::this_thread::get_id();
+    std::thread::id transactionThread;
+    db.submitTransaction([&db, &transactionThread] {
+        transactionThread = std::this_thread::get_id();
+        db.createStatement("INSERT INTO dummy_table (col_int) VALUES (1)")->execute<void>();
+    }).get();
+
+    EXPECT_NE(callerThread, transactionThread);
+    EXPECT_EQ(1, db.createStatement("SELECT COUNT(*) FROM dummy_table")->execute<int>());
+    EXPECT_EQ(1, db.writeExecutorStats().transactions);
+}
+
+TEST(SQLiteDatabaseTest, givenWriterThreadWhenExecuteGroupedTransactionIsInvokedThenItReturnsAfterWriterCommits) {
+    auto options = Db::Options();
+    options.writerThread = true;
+    auto db = Db::Sql::Database(":memory:", SQLITE_OPEN_READWRITE, options);
+    db.createStatement("CREATE TABLE dummy_table (col_int INTEGER)")->execute<void>();
+
+    auto callerThread = std::this_thread::get_id();
+    std::thread::id transactionThread;
+    db.executeGroupedTransaction([&db, &transactionThread] {
+        transactionThread = std::this_thread::get_id();
+        db.createStatement("INSERT INTO dummy_table (col_int) VALUES (1)")->execute<void>();
+    });
+
+    EXPECT_NE(callerThread, transactionThread);
+    EXPECT_EQ(1, db.createStatement("SELECT COUNT(*) FROM dummy_table")->execute<int>());
+    EXPECT_EQ(1, db.writeExecutorStats().transactions);
+}
+
+TEST(SQLiteDatabaseTest, givenWriterThreadAndTransactionWhenExecuteGroupedTransactionIsInvokedThenItIsNestedInIt) {
+    auto options = Db::Options();
+    options.writerThread = true;
+    auto db = Db::Sql::Database(":memory:", SQLITE_OPEN_READWRITE, options);
+    db.createStatement("CREATE TABLE dummy_table (col_int INTEGER)")->execute<void>();
+
+    auto callerThread = std::this_thread::get_id();
+    std::thread::id transactionThread;
+    db.executeTransaction([&db, &transactionThread] {
+        // The writer thread would wait for this transaction, so the grouped one is executed in it.
+        db.executeGroupedTransaction([&db, &transactionThread] {
+            transactionThread = std::this_thread::get_id();
+            db.createStatement("INSERT INTO dummy_table (col_int) VALUES (1)")->execute<void>();
+        });
+    });
+
+    EXPECT_EQ(callerThread, transactionThread);
+    EXPECT_EQ(1, db.createStatement("SELECT COUNT(*) FROM dummy_table")->execute<int>());
+    EXPECT_EQ(0, db.writeExecutorStats().transactions);
+}
+
+#ifdef EXCEPTIONS_ENABLED
+TEST(SQLiteDatabaseTest, givenWriterThreadAndFailingTransactionWhenExecuteGroupedTransactionIsInvokedThenItThrows) {
+    auto options = Db::Options();
+    options.writerThread = true;
+    auto db = Db::Sql::Database(":memory:", SQLITE_OPEN_READWRITE, options);
+    db.createStatement("CREATE TABLE dummy_table (col_int INTEGER)")->execute<void>();
+
+    EXPECT_THROW(db.executeGroupedTransaction([&db] {
+        db.createStatement("INSERT INTO dummy_table (col_int) VALUES (1)")->execute<void>();
+        throw std::runtime_error("dummy-error");
+    }), std::runtime_error);
+
+    EXPECT_EQ(0, db.createStatement("SELECT COUNT(*) FROM dummy_table")->execute<int>());
+}
+#endif
+
 // It's necessary to put the following tests in the same namespace of Db::Sql::Database to allow friend classes.
 namespace Db::Sql {
 
@@ -16,3 +16,24 @@ TEST(SQLiteExceptionTest, givenSqliteErrorWhenWhatIsInvokedThenErrorStringIsRetu
     // related to the error code SQLITE_NOMEN.
     EXPECT_STREQ(sqlite3_errstr(SQLITE_NOMEM), exc.what());
 }
+
+TEST(SQLiteExceptionTest, givenMsgWhenResultCodeIsNotGivenThenGenericErrorIsReturned) {
+    auto exc = Db::Sql::Exception("A dummy message.");
+
+    EXPECT_EQ(SQLITE_ERROR, exc.getResultCode());
+    EXPECT_FALSE(exc.isBusy());
+}
+
+TEST(SQLiteExceptionTest, givenLockErrorsWhenIsBusyIsInvokedThenTrueIsReturned) {
+    EXPECT_TRUE(Db::Sql::Exception("A dummy message.", SQLITE_BUSY).isBusy());
+    EXPECT_TRUE(Db::Sql::Exception("A dummy message.", SQLITE_BUSY_SNAPSHOT).isBusy());
+    EXPECT_TRUE(Db::Sql::Exception("A dummy message.", SQLITE_LOCKED).isBusy());
+    EXPECT_FALSE(Db::Sql::Exception("A dummy message.", SQLITE_CONSTRAINT).isBusy());
+}
+
+TEST(SQLiteExceptionTest, givenSqliteErrorWhenGetResultCodeIsInvokedThenExtendedErrorCodeIsReturned) {
+    sqlite3 *db = nullptr;
+    auto exc = Db::Sql::Exception(db);
+
+    EXPECT_EQ(SQLITE_NOMEM, exc.getResultCode());
+}
@@ -301,6 +301,23 @@ TEST_F(SQLiteStatementTest, givenValidSqlBindingWhenBindIntIsInvokedThenValueIsB
     ASSERT_EQ(1, cursor->get<int>(0));
 }
 
+TEST_F(SQLiteStatementTest, givenValidSqlBindingWhenBindInt64IsInvokedThenValueIsBoundCorrectly) {
+    int rc = sqlite3_step(Db::Sql::SmartCStatement(db, "CREATE TABLE dummy_table (id INTEGER PRIMARY KEY)"));
+    // The statement should be executed correctly.
+    ASSERT_EQ(SQLITE_DONE, rc);
+    auto statement = Db::Sql::Statement(db, "INSERT INTO dummy_table (id) VALUES (?)");
+    // A value which doesn't fit in 32 bits.
+    long long value = 4102444800LL;
+
+    statement.bind<long long>(1, value);
+    statement.execute<void>();
+    auto readStmt = Db::Sql::Statement(db, "SELECT id FROM dummy_table");
+    auto cursor = readStmt.execute<std::shared_ptr<Db::Cursor>>();
+
+    ASSERT_TRUE(cursor->next());
+    ASSERT_EQ(value, cursor->get<long long>(0));
+}
+
 TEST_F(SQLiteStatementTest, givenErrorInSqlBindingWhenBindDoubleIsInvokedThenExceptionIsThrown) {
     int rc = sqlite3_step(Db::Sql::SmartCStatement(db, "CREATE TABLE dummy_table (number REAL PRIMARY KEY)"));
     // The statement should be executed correctly.
@@ -389,4 +406,127 @@ TEST_F(SQLiteStatementTest, givenValidSqlBindingWhenBindBoolFalseIsInvokedThenVa
 
     ASSERT_TRUE(cursor->next());
     ASSERT_EQ(false, cursor->get<bool>(0));
-}
\ No newline at end of file
+}
+
+TEST_F(SQLiteStatementTest, givenRowsWhenExecuteBatchIsInvokedThenAllRowsAreInsertedInOneTransaction) {
+    sqlite3_step(Db::Sql::SmartCStatement(db, "CREATE TABLE dummy_table (id INTEGER PRIMARY KEY, name TEXT)"));
+    auto statement = Db::Sql::Statement(db, "INSERT INTO dummy_table (id, name) VALUES (?, ?)");
+    auto rows = std::vector<std::tuple<int, std::string>>{{1, "first"}, {2, "second"}, {3, "third"}};
+
+    auto result = statement.executeBatch(rows);
+
+    EXPECT_EQ(3, result.executedRows);
+    EXPECT_TRUE(result.failures.empty());
+    // The batch transaction is closed.
+    EXPECT_TRUE(sqlite3_get_autocommit(db));
+    auto count = Db::Sql::Statement(db, "SELECT COUNT(*) FROM dummy_table").execute<int>();
+    EXPECT_EQ(3, count);
+    auto name = Db::Sql::Statement(db, "SELECT name FROM dummy_table WHERE id = 2").execute<stdx::optional<std::string>>();
+    EXPECT_EQ("second", name);
+}
+
+TEST_F(SQLiteStatementTest, givenFailingRowWhenExecuteBatchIsInvokedThenFailureIsReportedAndOtherRowsAreKept) {
+    sqlite3_step(Db::Sql::SmartCStatement(db, "CREATE TABLE dummy_table (id INTEGER PRIMARY KEY, name TEXT)"));
+    auto statement = Db::Sql::Statement(db, "INSERT INTO dummy_table (id, name) VALUES (?, ?)");
+    // The second row violates the primary key.
+    auto rows = std::vector<std::tuple<int, std::string>>{{1, "first"}, {1, "second"}, {3, "third"}};
+
+    auto result = statement.executeBatch(rows);
+
+    EXPECT_EQ(2, result.executedRows);
+    ASSERT_EQ(1, result.failures.size());
+    EXPECT_EQ(1, result.failures[0].row);
+    EXPECT_FALSE(result.failures[0].message.empty());
+    EXPECT_EQ(2, Db::Sql::Statement(db, "SELECT COUNT(*) FROM dummy_table").execute<int>());
+}
+
+TEST_F(SQLiteStatementTest, givenFailingRowAndAbortModeWhenExecuteBatchIsInvokedThenBatchIsRolledBack) {
+    sqlite3_step(Db::Sql::SmartCStatement(db, "CREATE TABLE dummy_table (id INTEGER PRIMARY KEY, name TEXT)"));
+    auto statement = Db::Sql::Statement(db, "INSERT INTO dummy_table (id, name) VALUES (?, ?)");
+    auto rows = std::vector<std::tuple<int, std::string>>{{1, "first"}, {1, "second"}, {3, "third"}};
+
+    ASSERT_LIB_THROW(statement.executeBatch(rows, Db::Statement::BatchMode::AbortOnFailure), Db::Sql::Exception);
+
+    EXPECT_TRUE(sqlite3_get_autocommit(db));
+    EXPECT_EQ(0, Db::Sql::Statement(db, "SELECT COUNT(*) FROM dummy_table").execute<int>());
+}
+
+TEST_F(SQLiteStatementTest, givenRowRollingBackTransactionWhenExecuteBatchIsInvokedThenBatchIsAborted) {
+    sqlite3_exec(db, "CREATE TABLE dummy_table (id INTEGER PRIMARY KEY, name TEXT);"
+                     "CREATE TRIGGER dummy_trigger BEFORE INSERT ON dummy_table WHEN NEW.id = 2 "
+                     "BEGIN SELECT RAISE(ROLLBACK, 'dummy-error'); END",
+                 nullptr, nullptr, nullptr);
+    auto statement = Db::Sql::Statement(db, "INSERT INTO dummy_table (id, name) VALUES (?, ?)");
+    // The second row rolls back the whole transaction, like SQLITE_FULL, so the third one mustn't be committed alone.
+    auto rows = std::vector<std::tuple<int, std::string>>{{1, "first"}, {2, "second"}, {3, "third"}};
+
+    ASSERT_LIB_THROW(statement.executeBatch(rows), Db::Sql::Exception);
+
+    EXPECT_TRUE(sqlite3_get_autocommit(db));
+    EXPECT_EQ(0, Db::Sql::Statement(db, "SELECT COUNT(*) FROM dummy_table").execute<int>());
+}
+
+TEST_F(SQLiteStatementTest, givenOpenTransactionWhenExecuteBatchIsInvokedThenBatchIsNestedInIt) {
+    sqlite3_step(Db::Sql::SmartCStatement(db, "CREATE TABLE dummy_table (id INTEGER PRIMARY KEY, name TEXT)"));
+    auto statement = Db::Sql::Statement(db, "INSERT INTO dummy_table (id, name) VALUES (?, ?)");
+    auto rows = std::vector<std::tuple<int, std::string>>{{1, "first"}, {2, "second"}};
+    sqlite3_exec(db, "BEGIN TRANSACTION", nullptr, nullptr, nullptr);
+
+    statement.executeBatch(rows);
+
+    // The outer transaction is still open.
+    EXPECT_FALSE(sqlite3_get_autocommit(db));
+    sqlite3_exec(db, "ROLLBACK", nullptr, nullptr, nullptr);
+    EXPECT_EQ(0, Db::Sql::Statement(db, "SELECT COUNT(*) FROM dummy_table").execute<int>());
+}
+
+TEST_F(SQLiteStatementTest, givenInvalidBindingWhenExecuteBatchIsInvokedThenBatchIsRolledBack) {
+    sqlite3_step(Db::Sql::SmartCStatement(db, "CREATE TABLE dummy_table (id INTEGER PRIMARY KEY)"));
+    auto statement = Db::Sql::Statement(db, "INSERT INTO dummy_table (id) VALUES (?)");
+    // The statement has a single parameter so the second value can't be bound.
+    auto rows = std::vector<std::tuple<int, int>>{{1, 1}};
+
+    ASSERT_LIB_THROW(statement.executeBatch(rows), Db::Sql::Exception);
+
+    EXPECT_TRUE(sqlite3_get_autocommit(db));
+}
+
+TEST_F(SQLiteStatementTest, givenInsertWhenExecuteIsInvokedThenLastInsertRowIdAndChangesAreOfItsRow) {
+    sqlite3_step(Db::Sql::SmartCStatement(db, "CREATE TABLE dummy_table (id INTEGER PRIMARY KEY, name TEXT)"));
+    auto statement = Db::Sql::Statement(db, "INSERT INTO dummy_table (id, name) VALUES (?, 'dummy')");
+
+    statement.bind(1, 45);
+    statement.execute<void>();
+    // Another insertion on the same connection doesn't change the values read by the statement.
+    sqlite3_exec(db, "INSERT INTO dummy_table (id, name) VALUES (46, 'other')", nullptr, nullptr, nullptr);
+
+    EXPECT_EQ(45, statement.lastInsertRowId());
+    EXPECT_EQ(1, statement.changes());
+}
+
+TEST_F(SQLiteStatementTest, givenUpdateWhenExecuteIsInvokedThenChangesAreTheUpdatedRows) {
+    sqlite3_exec(db, "CREATE TABLE dummy_table (id INTEGER PRIMARY KEY, name TEXT);"
+                     "INSERT INTO dummy_table (id, name) VALUES (1, 'first'), (2, 'second'), (3, 'third')",
+                 nullptr, nullptr, nullptr);
+    auto statement = Db::Sql::Statement(db, "UPDATE dummy_table SET name = 'dummy' WHERE id < ?");
+
+    statement.bind(1, 3);
+    statement.execute<void>();
+    EXPECT_EQ(2, statement.changes());
+
+    statement.bind(1, 0);
+    statement.execute<void>();
+    EXPECT_EQ(0, statement.changes());
+}
+
+TEST_F(SQLiteStatementTest, givenQueryAfterInsertWhenExecuteIsInvokedThenLastInsertRowIdAndChangesAreZero) {
+    sqlite3_exec(db, "CREATE TABLE dummy_table (id INTEGER PRIMARY KEY, name TEXT);"
+                     "INSERT INTO dummy_table (id, name) VALUES (45, 'dummy')",
+                 nullptr, nullptr, nullptr);
+    auto statement = Db::Sql::Statement(db, "SELECT COUNT(*) FROM dummy_table");
+
+    statement.execute<int>();
+
+    EXPECT_EQ(0, statement.lastInsertRowId());
+    EXPECT_EQ(0, statement.changes());
+}
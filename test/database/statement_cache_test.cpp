@@ -0,0 +1,103 @@
+#include "statement_cache_test.hpp"
+#include "database/sqlite_exception.hpp"
+#include "core/test_exceptions_macros.hpp"
+
+void StatementCacheTest::SetUp() {
+    sqlite3_open(":memory:", &db);
+    sqlite3_step(Db::Sql::SmartCStatement(db, "CREATE TABLE dummy_table (col_int INTEGER PRIMARY KEY)"));
+    sqlite3_step(Db::Sql::SmartCStatement(db, "INSERT INTO dummy_table (col_int) VALUES (1)"));
+    sqlite3_step(Db::Sql::SmartCStatement(db, "INSERT INTO dummy_table (col_int) VALUES (2)"));
+}
+
+void StatementCacheTest::TearDown() {
+    sqlite3_close(db);
+}
+
+TEST_F(StatementCacheTest, givenUncachedQueryWhenAcquireIsInvokedThenMissIsCounted) {
+    auto cache = Db::Sql::StatementCache(db, 4);
+
+    auto stmt = cache.acquire("SELECT col_int FROM dummy_table");
+
+    EXPECT_EQ(0, cache.stats().hits);
+    EXPECT_EQ(1, cache.stats().misses);
+    EXPECT_EQ(1, cache.size());
+}
+
+TEST_F(StatementCacheTest, givenReleasedCachedQueryWhenAcquireIsInvokedThenSameStatementIsReturned) {
+    auto cache = Db::Sql::StatementCache(db, 4);
+    sqlite3_stmt *firstStmt = cache.acquire("SELECT col_int FROM dummy_table");
+
+    sqlite3_stmt *secondStmt = cache.acquire("SELECT col_int FROM dummy_table");
+
+    EXPECT_EQ(firstStmt, secondStmt);
+    EXPECT_EQ(1, cache.stats().hits);
+    EXPECT_EQ(1, cache.stats().misses);
+}
+
+TEST_F(StatementCacheTest, givenCachedQueryInUseWhenAcquireIsInvokedThenNewStatementIsReturned) {
+    auto cache = Db::Sql::StatementCache(db, 4);
+    auto firstStmt = cache.acquire("SELECT col_int FROM dummy_table");
+    // Simulate a cursor which is still iterating over the statement.
+    ASSERT_EQ(SQLITE_ROW, sqlite3_step(firstStmt));
+
+    auto secondStmt = cache.acquire("SELECT col_int FROM dummy_table");
+
+    EXPECT_NE((sqlite3_stmt *) firstStmt, (sqlite3_stmt *) secondStmt);
+    EXPECT_EQ(0, cache.stats().hits);
+    EXPECT_EQ(2, cache.stats().misses);
+    // The statement in use shouldn't be touched by the cache.
+    EXPECT_TRUE(sqlite3_stmt_busy(firstStmt));
+    EXPECT_EQ(1, sqlite3_column_int(firstStmt, 0));
+}
+
+TEST_F(StatementCacheTest, givenPartiallyExecutedStatementWhenItIsAcquiredAgainThenItIsResetAndUnbound) {
+    auto cache = Db::Sql::StatementCache(db, 4);
+    {
+        auto stmt = cache.acquire("SELECT col_int FROM dummy_table WHERE col_int >= ?");
+        sqlite3_bind_int(stmt, 1, 2);
+        // The statement isn't stepped until the end.
+        ASSERT_EQ(SQLITE_ROW, sqlite3_step(stmt));
+    }
+
+    auto stmt = cache.acquire("SELECT col_int FROM dummy_table WHERE col_int >= ?");
+
+    EXPECT_FALSE(sqlite3_stmt_busy(stmt));
+    // Since the binding is cleared, the parameter is NULL and no rows match.
+    EXPECT_EQ(SQLITE_DONE, sqlite3_step(stmt));
+}
+
+TEST_F(StatementCacheTest, givenFullCacheWhenAcquireIsInvokedThenLeastRecentlyUsedStatementIsEvicted) {
+    auto cache = Db::Sql::StatementCache(db, 2);
+    sqlite3_stmt *firstStmt = cache.acquire("SELECT 1");
+    cache.acquire("SELECT 2");
+    // Mark the first statement as the most recently used.
+    cache.acquire("SELECT 1");
+
+    cache.acquire("SELECT 3");
+
+    EXPECT_EQ(2, cache.size());
+    EXPECT_EQ(1, cache.stats().evictions);
+    // The first statement is still cached while the second one was evicted.
+    EXPECT_EQ(firstStmt, (sqlite3_stmt *) cache.acquire("SELECT 1"));
+    cache.acquire("SELECT 2");
+    EXPECT_EQ(2, cache.stats().hits);
+    EXPECT_EQ(4, cache.stats().misses);
+}
+
+TEST_F(StatementCacheTest, givenZeroCapacityWhenAcquireIsInvokedThenStatementIsNotCached) {
+    auto cache = Db::Sql::StatementCache(db, 0);
+
+    cache.acquire("SELECT col_int FROM dummy_table");
+    cache.acquire("SELECT col_int FROM dummy_table");
+
+    EXPECT_EQ(0, cache.size());
+    EXPECT_EQ(0, cache.stats().hits);
+    EXPECT_EQ(2, cache.stats().misses);
+}
+
+TEST_F(StatementCacheTest, givenInvalidQueryWhenAcquireIsInvokedThenExceptionIsThrownAndCacheIsUnchanged) {
+    auto cache = Db::Sql::StatementCache(db, 4);
+
+    EXPECT_LIB_THROW(cache.acquire("INVALID_SELECT"), Db::Sql::Exception);
+    EXPECT_EQ(0, cache.size());
+}
\ No newline at end of file
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "sqlite3/sqlite3.h"
+#include "database/statement_cache.hpp"
+#include <gtest/gtest.h>
+
+class StatementCacheTest : public ::testing::Test {
+   protected:
+    sqlite3 *db{};
+
+    void SetUp() override;
+
+    void TearDown() override;
+};
\ No newline at end of file
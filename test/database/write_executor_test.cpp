@@ -0,0 +1,126 @@
+#include <stdexcept>
+#include "write_executor_test.hpp"
+#include "database/write_executor.hpp"
+
+void WriteExecutorTest::SetUp() {
+    db = std::make_unique<Db::Sql::Database>(":memory:", SQLITE_OPEN_READWRITE);
+    db->createStatement("CREATE TABLE dummy_table (col_int INTEGER)")->execute<void>();
+}
+
+void WriteExecutorTest::TearDown() {
+    db = nullptr;
+}
+
+std::function<void()> WriteExecutorTest::insert(int value) {
+    return [this, value] {
+        auto stmt = db->createStatement("INSERT INTO dummy_table (col_int) VALUES (?)");
+        stmt->bind(1, value);
+        stmt->execute<void>();
+    };
+}
+
+int WriteExecutorTest::count() {
+    return db->createStatement("SELECT COUNT(*) FROM dummy_table")->execute<int>();
+}
+
+TEST_F(WriteExecutorTest, givenSubmittedTransactionWhenFutureIsReadyThenChangesAreCommitted) {
+    auto executor = Db::Sql::WriteExecutor(*db, 8);
+
+    executor.submit(insert(1)).get();
+
+    EXPECT_EQ(1, count());
+    EXPECT_EQ(1, executor.stats().transactions);
+    EXPECT_EQ(1, executor.stats().commits);
+}
+
+TEST_F(WriteExecutorTest, givenTransactionsSubmittedWhileWriterIsBusyWhenTheyAreExecutedThenTheyShareOneCommit) {
+    auto executor = Db::Sql::WriteExecutor(*db, 8);
+    std::promise<void> started;
+    std::promise<void> released;
+    auto blocking = executor.submit([&started, &released] {
+        started.set_value();
+        released.get_future().wait();
+    });
+    started.get_future().wait();
+
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 5; i++) {
+        futures.push_back(executor.submit(insert(i)));
+    }
+    released.set_value();
+    blocking.get();
+    for (auto &future : futures) {
+        future.get();
+    }
+
+    EXPECT_EQ(5, count());
+    EXPECT_EQ(6, executor.stats().transactions);
+    EXPECT_EQ(2, executor.stats().commits);
+}
+
+TEST_F(WriteExecutorTest, givenMaxGroupSizeWhenManyTransactionsAreQueuedThenTheyAreSplitInMultipleCommits) {
+    auto executor = Db::Sql::WriteExecutor(*db, 2);
+    std::promise<void> started;
+    std::promise<void> released;
+    auto blocking = executor.submit([&started, &released] {
+        started.set_value();
+        released.get_future().wait();
+    });
+    started.get_future().wait();
+
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 5; i++) {
+        futures.push_back(executor.submit(insert(i)));
+    }
+    released.set_value();
+    for (auto &future : futures) {
+        future.get();
+    }
+
+    EXPECT_EQ(5, count());
+    // The blocking transaction and the groups of 2, 2 and 1 transactions.
+    EXPECT_EQ(4, executor.stats().commits);
+}
+
+#ifdef EXCEPTIONS_ENABLED
+TEST_F(WriteExecutorTest, givenFailingTransactionInGroupWhenItIsExecutedThenOnlyItsFutureFails) {
+    auto executor = Db::Sql::WriteExecutor(*db, 8);
+    std::promise<void> started;
+    std::promise<void> released;
+    auto blocking = executor.submit([&started, &released] {
+        started.set_value();
+        released.get_future().wait();
+    });
+    started.get_future().wait();
+
+    auto first = executor.submit(insert(1));
+    auto failing = executor.submit([this] {
+        insert(2)();
+        throw std::runtime_error("dummy-error");
+    });
+    auto last = executor.submit(insert(3));
+    released.set_value();
+
+    EXPECT_NO_THROW(first.get());
+    EXPECT_THROW(failing.get(), std::runtime_error);
+    EXPECT_NO_THROW(last.get());
+    auto values = db->createStatement("SELECT col_int FROM dummy_table ORDER BY col_int")->
+        execute<std::shared_ptr<Db::Cursor>>()->rows<int>();
+    EXPECT_EQ(std::vector<std::tuple<int>>({std::make_tuple(1), std::make_tuple(3)}), values);
+}
+#endif
+
+TEST_F(WriteExecutorTest, givenQueuedTransactionsWhenExecutorIsDestroyedThenTheyAreExecutedBefore) {
+    std::vector<std::future<void>> futures;
+    {
+        auto executor = Db::Sql::WriteExecutor(*db, 8);
+        for (int i = 0; i < 10; i++) {
+            futures.push_back(executor.submit(insert(i)));
+        }
+    }
+
+    for (auto &future : futures) {
+        EXPECT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds(0)));
+    }
+    EXPECT_EQ(10, count());
+}
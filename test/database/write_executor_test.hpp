@@ -0,0 +1,18 @@
+#pragma once
+
+#include <memory>
+#include <gtest/gtest.h>
+#include "database/sqlite_database.hpp"
+
+class WriteExecutorTest : public ::testing::Test {
+   protected:
+    std::unique_ptr<Db::Sql::Database> db;
+
+    void SetUp() override;
+
+    void TearDown() override;
+
+    std::function<void()> insert(int value);
+
+    int count();
+};
@@ -0,0 +1,169 @@
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <gtest/gtest.h>
+#include "note/draft_flusher.hpp"
+#include "core/test_exceptions_macros.hpp"
+
+/* PRIVATE */ namespace {
+
+// A debounce which is never reached by the tests, so only the explicit flushes and the threshold write the drafts.
+DraftFlushPolicy manualPolicy(size_t dirtyBytesThreshold = 1024) {
+    DraftFlushPolicy policy;
+    policy.debounce = std::chrono::hours(1);
+    policy.dirtyBytesThreshold = dirtyBytesThreshold;
+    return policy;
+}
+}
+
+TEST(DraftFlusherTest, givenNoChangesWhenFlushIsInvokedThenFlushFunctionIsInvoked) {
+    std::atomic<int> flushes(0);
+    auto flusher = DraftFlusher(manualPolicy(), [&flushes] {
+        flushes++;
+        return size_t(0);
+    });
+
+    flusher.flush();
+
+    EXPECT_EQ(1, flushes);
+    EXPECT_EQ(1, flusher.stats().flushes);
+    EXPECT_EQ(0, flusher.stats().updates);
+}
+
+TEST(DraftFlusherTest, givenChangesWhenFlushIsInvokedThenTheyAreWrittenTogether) {
+    std::atomic<int> flushes(0);
+    auto flusher = DraftFlusher(manualPolicy(), [&flushes] {
+        flushes++;
+        return size_t(2);
+    });
+
+    for (int i = 0; i < 10; i++) {
+        flusher.markDirty(1);
+    }
+    flusher.flush();
+
+    EXPECT_EQ(1, flushes);
+    auto stats = flusher.stats();
+    EXPECT_EQ(10, stats.updates);
+    EXPECT_EQ(1, stats.flushes);
+    EXPECT_EQ(2, stats.writtenDrafts);
+    EXPECT_DOUBLE_EQ(5, stats.coalescingRatio());
+    EXPECT_LE(stats.maxFlushTime, stats.totalFlushTime);
+}
+
+TEST(DraftFlusherTest, givenDirtyBytesReachingThresholdWhenMarkDirtyIsInvokedThenChangesAreWritten) {
+    std::promise<void> written;
+    auto flusher = DraftFlusher(manualPolicy(10), [&written] {
+        written.set_value();
+        return size_t(1);
+    });
+
+    flusher.markDirty(4);
+    flusher.markDirty(6);
+
+    EXPECT_EQ(std::future_status::ready, written.get_future().wait_for(std::chrono::seconds(5)));
+}
+
+TEST(DraftFlusherTest, givenDebounceWhenDraftsAreNotChangedAnymoreThenChangesAreWritten) {
+    std::promise<void> written;
+    DraftFlushPolicy policy;
+    policy.debounce = std::chrono::milliseconds(10);
+    std::atomic<int> flushes(0);
+    auto flusher = DraftFlusher(policy, [&written, &flushes] {
+        if (++flushes == 2) {
+            written.set_value();
+        }
+        return size_t(1);
+    });
+    // The worker releases the lock waiting for new changes when the flush returns, so it's idle from now on.
+    flusher.flush();
+
+    flusher.markDirty(1);
+
+    EXPECT_EQ(std::future_status::ready, written.get_future().wait_for(std::chrono::seconds(5)));
+}
+
+TEST(DraftFlusherTest, givenChangesWhenFlusherIsDestroyedThenChangesAreWritten) {
+    std::atomic<int> flushes(0);
+    {
+        auto flusher = DraftFlusher(manualPolicy(), [&flushes] {
+            flushes++;
+            return size_t(1);
+        });
+        flusher.markDirty(1);
+    }
+
+    EXPECT_EQ(1, flushes);
+}
+
+TEST(DraftFlusherTest, givenNoChangesWhenFlusherIsDestroyedThenFlushFunctionIsNotInvoked) {
+    std::atomic<int> flushes(0);
+    {
+        auto flusher = DraftFlusher(manualPolicy(), [&flushes] {
+            flushes++;
+            return size_t(0);
+        });
+    }
+
+    EXPECT_EQ(0, flushes);
+}
+
+#ifdef EXCEPTIONS_ENABLED
+TEST(DraftFlusherTest, givenFailingFlushFunctionWhenFlushIsInvokedThenErrorIsThrownAndChangesAreKept) {
+    std::atomic<int> flushes(0);
+    {
+        auto flusher = DraftFlusher(manualPolicy(), [&flushes]() -> size_t {
+            if (flushes++ == 0) {
+                throw std::runtime_error("dummy-error");
+            }
+            return 1;
+        });
+        flusher.markDirty(1);
+
+        ASSERT_LIB_THROW(flusher.flush(), std::runtime_error);
+
+        auto stats = flusher.stats();
+        EXPECT_EQ(1, stats.flushes);
+        EXPECT_EQ(1, stats.failures);
+        EXPECT_EQ(0, stats.writtenDrafts);
+    }
+    // The failed changes are written again before the flusher is destroyed.
+    EXPECT_EQ(2, flushes);
+}
+
+TEST(DraftFlusherTest, givenSameErrorThrownAgainWhenFlushIsInvokedThenFailureIsCountedOnce) {
+    auto flusher = DraftFlusher(manualPolicy(), []() -> size_t {
+        throw std::runtime_error("dummy-error");
+    });
+    flusher.markDirty(1);
+
+    for (int i = 0; i < 3; i++) {
+        ASSERT_LIB_THROW(flusher.flush(), std::runtime_error);
+    }
+
+    auto stats = flusher.stats();
+    EXPECT_EQ(3, stats.flushes);
+    EXPECT_EQ(1, stats.failures);
+}
+
+TEST(DraftFlusherTest, givenFailedFlushWhenDraftsAreNotChangedAnymoreThenItIsNotRetriedInBackground) {
+    std::atomic<int> flushes(0);
+    DraftFlushPolicy policy;
+    policy.debounce = std::chrono::milliseconds(1);
+    auto flusher = DraftFlusher(policy, [&flushes]() -> size_t {
+        flushes++;
+        throw std::runtime_error("dummy-error");
+    });
+
+    flusher.markDirty(1);
+
+    for (int i = 0; i < 500 && flushes == 0; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    // Many debounces pass, but the failed changes are retried only with the next changes.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(1, flushes);
+    EXPECT_EQ(1, flusher.stats().failures);
+}
+#endif
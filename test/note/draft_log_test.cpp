@@ -0,0 +1,274 @@
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include "note/draft_log.hpp"
+
+/* PRIVATE */ namespace {
+
+const char *logPath = "draft_log_test.log";
+
+DraftLog::Record record(DraftLog::Operation operation, int id, uint64_t offset, uint64_t count, std::string text) {
+    DraftLog::Record record;
+    record.operation = operation;
+    record.id = id;
+    record.offset = offset;
+    record.count = count;
+    record.text = std::move(text);
+    return record;
+}
+}
+
+TEST(DraftLogTest, givenNewFileWhenReadIsInvokedThenNoRecordIsReturned) {
+    std::remove(logPath);
+    auto log = DraftLog(logPath);
+
+    EXPECT_TRUE(log.read().empty());
+    std::remove(logPath);
+}
+
+TEST(DraftLogTest, givenAppendedRecordsWhenLogIsOpenedAgainThenRecordsAreRead) {
+    std::remove(logPath);
+    {
+        auto log = DraftLog(logPath);
+        log.append(DraftLog::Operation::UpdateNewTitle, 0, 0, 0, "dummy-title");
+        log.append(DraftLog::Operation::InsertInExistingDescription, 45, 3, 0, "dummy");
+        log.append(DraftLog::Operation::EraseFromExistingDescription, 45, 2, 4, "");
+    }
+
+    auto log = DraftLog(logPath);
+
+    auto expected = std::vector<DraftLog::Record>{
+        record(DraftLog::Operation::UpdateNewTitle, 0, 0, 0, "dummy-title"),
+        record(DraftLog::Operation::InsertInExistingDescription, 45, 3, 0, "dummy"),
+        record(DraftLog::Operation::EraseFromExistingDescription, 45, 2, 4, "")
+    };
+    EXPECT_EQ(expected, log.read());
+    std::remove(logPath);
+}
+
+TEST(DraftLogTest, givenPositionWhenTruncateIsInvokedThenOnlyFollowingRecordsAreKept) {
+    std::remove(logPath);
+    {
+        auto log = DraftLog(logPath);
+        log.append(DraftLog::Operation::UpdateNewTitle, 0, 0, 0, "dummy-title");
+        auto position = log.position();
+        log.append(DraftLog::Operation::UpdateExistingTitle, 45, 0, 0, "other-title");
+
+        log.truncate(position);
+
+        log.append(DraftLog::Operation::DeleteExisting, 46, 0, 0, "");
+    }
+
+    auto log = DraftLog(logPath);
+
+    auto expected = std::vector<DraftLog::Record>{
+        record(DraftLog::Operation::UpdateExistingTitle, 45, 0, 0, "other-title"),
+        record(DraftLog::Operation::DeleteExisting, 46, 0, 0, "")
+    };
+    EXPECT_EQ(expected, log.read());
+    std::remove(logPath);
+}
+
+TEST(DraftLogTest, givenLastPositionWhenTruncateIsInvokedThenPreviousRecordsAreNotReadAgain) {
+    std::remove(logPath);
+    {
+        auto log = DraftLog(logPath);
+        log.append(DraftLog::Operation::UpdateNewTitle, 0, 0, 0, "dummy-title");
+        log.append(DraftLog::Operation::UpdateNewDescription, 0, 0, 0, "dummy-description");
+
+        log.truncate(log.position());
+    }
+
+    auto log = DraftLog(logPath);
+
+    // The bytes of the previous records are still in the file, but they belong to the previous generation.
+    EXPECT_TRUE(log.read().empty());
+    std::remove(logPath);
+}
+
+TEST(DraftLogTest, givenCorruptedRecordWhenLogIsOpenedAgainThenRecordsBeforeItAreRead) {
+    std::remove(logPath);
+    size_t corruptedPosition;
+    {
+        auto log = DraftLog(logPath);
+        log.append(DraftLog::Operation::UpdateNewTitle, 0, 0, 0, "dummy-title");
+        corruptedPosition = log.position();
+        log.append(DraftLog::Operation::UpdateNewDescription, 0, 0, 0, "dummy-description");
+        log.append(DraftLog::Operation::DeleteNew, 0, 0, 0, "");
+    }
+    {
+        // Changes the last byte of the description, like a record torn by a crash.
+        std::fstream file(logPath, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(static_cast<std::streamoff>(corruptedPosition + 8 + 29 + 16));
+        file.put('X');
+    }
+
+    auto log = DraftLog(logPath);
+
+    auto expected = std::vector<DraftLog::Record>{
+        record(DraftLog::Operation::UpdateNewTitle, 0, 0, 0, "dummy-title")
+    };
+    EXPECT_EQ(expected, log.read());
+    EXPECT_EQ(corruptedPosition, log.position());
+    std::remove(logPath);
+}
+
+TEST(DraftLogTest, givenInvalidFileWhenLogIsOpenedThenItIsEmpty) {
+    std::remove(logPath);
+    {
+        std::ofstream file(logPath, std::ios::binary);
+        file << "dummy-content";
+    }
+
+    auto log = DraftLog(logPath);
+    log.append(DraftLog::Operation::DeleteAll, 0, 0, 0, "");
+
+    auto expected = std::vector<DraftLog::Record>{
+        record(DraftLog::Operation::DeleteAll, 0, 0, 0, "")
+    };
+    EXPECT_EQ(expected, log.read());
+    std::remove(logPath);
+}
+
+TEST(DraftLogTest, givenRecordsLargerThanTheFileWhenTheyAreAppendedThenFileGrows) {
+    std::remove(logPath);
+    auto text = std::string(50000, 'x');
+    {
+        auto log = DraftLog(logPath);
+        for (int i = 0; i < 4; i++) {
+            log.append(DraftLog::Operation::UpdateExistingDescription, i, 0, 0, text);
+        }
+    }
+
+    auto log = DraftLog(logPath);
+
+    auto records = log.read();
+    ASSERT_EQ(4, records.size());
+    EXPECT_EQ(record(DraftLog::Operation::UpdateExistingDescription, 3, 0, 0, text), records[3]);
+    std::remove(logPath);
+}
+
+TEST(DraftLogTest, givenRecordsLargerThanTheFileWhenTheyAreAppendedThenFileIsNotSparse) {
+    std::remove(logPath);
+    {
+        auto log = DraftLog(logPath);
+        log.append(DraftLog::Operation::UpdateExistingDescription, 45, 0, 0, std::string(200000, 'x'));
+    }
+
+    struct stat fileStat{};
+    ASSERT_EQ(0, stat(logPath, &fileStat));
+    // The blocks are allocated when the file grows, so writing in the mapped memory can't fail for a full disk.
+    EXPECT_GE(fileStat.st_blocks * 512, fileStat.st_size);
+    std::remove(logPath);
+}
+
+TEST(DraftLogTest, givenTruncationTornBeforeItsHeaderWhenLogIsOpenedAgainThenAllRecordsAreRead) {
+    std::remove(logPath);
+    {
+        auto log = DraftLog(logPath);
+        log.append(DraftLog::Operation::UpdateNewTitle, 0, 0, 0, "dummy-title");
+        auto position = log.position();
+        log.append(DraftLog::Operation::UpdateExistingTitle, 45, 0, 0, "other-title");
+
+        log.truncate(position);
+    }
+    {
+        // Changes the checksum of the header written by the truncation, like a crash while it was written.
+        std::fstream file(logPath, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(32 + 24);
+        file.put('X');
+    }
+
+    auto log = DraftLog(logPath);
+
+    auto expected = std::vector<DraftLog::Record>{
+        record(DraftLog::Operation::UpdateNewTitle, 0, 0, 0, "dummy-title"),
+        record(DraftLog::Operation::UpdateExistingTitle, 45, 0, 0, "other-title")
+    };
+    EXPECT_EQ(expected, log.read());
+    std::remove(logPath);
+}
+
+TEST(DraftLogTest, givenKeptRecordsWrittenBeforeCurrentOnesWhenTruncationIsTornThenCurrentRecordsAreRead) {
+    std::remove(logPath);
+    {
+        auto log = DraftLog(logPath);
+        log.append(DraftLog::Operation::UpdateNewTitle, 0, 0, 0, "dummy-title");
+        auto position = log.position();
+        log.append(DraftLog::Operation::UpdateExistingTitle, 45, 0, 0, "other-title");
+        // The kept record is written after the current ones, so the next kept record fits before it.
+        log.truncate(position);
+        position = log.position();
+        log.append(DraftLog::Operation::DeleteExisting, 46, 0, 0, "");
+
+        log.truncate(position);
+    }
+    {
+        // The first header was written again by the second truncation.
+        std::fstream file(logPath, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(24);
+        file.put('X');
+    }
+
+    auto log = DraftLog(logPath);
+
+    auto expected = std::vector<DraftLog::Record>{
+        record(DraftLog::Operation::UpdateExistingTitle, 45, 0, 0, "other-title"),
+        record(DraftLog::Operation::DeleteExisting, 46, 0, 0, "")
+    };
+    EXPECT_EQ(expected, log.read());
+    std::remove(logPath);
+}
+
+TEST(DraftLogTest, givenManyTruncationsKeepingRecordsWhenTheyAreAppliedThenFileDoesNotGrow) {
+    std::remove(logPath);
+    {
+        auto log = DraftLog(logPath);
+        for (int i = 0; i < 10000; i++) {
+            auto position = log.position();
+            log.append(DraftLog::Operation::UpdateExistingTitle, i, 0, 0, "dummy-title");
+            log.truncate(position);
+        }
+    }
+
+    struct stat fileStat{};
+    ASSERT_EQ(0, stat(logPath, &fileStat));
+    EXPECT_EQ(64 * 1024, fileStat.st_size);
+    auto log = DraftLog(logPath);
+    auto expected = std::vector<DraftLog::Record>{
+        record(DraftLog::Operation::UpdateExistingTitle, 9999, 0, 0, "dummy-title")
+    };
+    EXPECT_EQ(expected, log.read());
+    std::remove(logPath);
+}
+
+TEST(DraftLogTest, givenPositionWhenReadAfterIsInvokedThenOnlyFollowingRecordsAreReturned) {
+    std::remove(logPath);
+    auto log = DraftLog(logPath);
+    log.append(DraftLog::Operation::UpdateNewTitle, 0, 0, 0, "dummy-title");
+    auto position = log.position();
+    log.append(DraftLog::Operation::DeleteNew, 0, 0, 0, "");
+
+    auto expected = std::vector<DraftLog::Record>{
+        record(DraftLog::Operation::DeleteNew, 0, 0, 0, "")
+    };
+    EXPECT_EQ(expected, log.readAfter(position));
+    EXPECT_TRUE(log.readAfter(log.position()).empty());
+    std::remove(logPath);
+}
+
+TEST(DraftLogTest, givenFirstGenerationWhenLogIsCreatedThenItsRecordsHaveIt) {
+    std::remove(logPath);
+    {
+        auto log = DraftLog(logPath, 45);
+        log.append(DraftLog::Operation::DeleteNew, 0, 0, 0, "");
+    }
+
+    // The first generation is used only when the log is created.
+    auto log = DraftLog(logPath, 1);
+
+    EXPECT_EQ(45, log.currentGeneration());
+    EXPECT_EQ(1, log.read().size());
+    std::remove(logPath);
+}
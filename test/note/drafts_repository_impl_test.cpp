@@ -1,3 +1,9 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <stdexcept>
+#include <thread>
 #include "core/include_macros.hpp"
 #include "drafts_repository_impl_test.hpp"
 #include "note/incomplete_draft_exception.hpp"
@@ -335,6 +341,46 @@ TEST_F(DraftsRepositoryImplTest, givenDraftsInMemoryWhenDeleteAllIsInvokedThenAl
     EXPECT_FALSE(draft);
 }
 
+TEST_F(DraftsRepositoryImplTest, givenFailingDeletionWhenDeleteAllIsInvokedThenDraftsAreKeptInMemory) {
+    repository->updateNewTitle("dummy-title");
+    repository->updateNewDescription("dummy-description");
+    db->createStatement("DROP TABLE pending_drafts_update")->execute<void>();
+
+    EXPECT_LIB_THROW(repository->deleteAll(), std::exception);
+
+    // The deletion of the new draft was rolled back with the one of the existing drafts.
+    EXPECT_EQ(Draft("dummy-title", "dummy-description"), repository->getNew());
+}
+
+TEST_F(DraftsRepositoryImplTest, givenDeleteAllWaitingForDbWhenDraftIsUpdatedThenUpdateDoesNotWaitForIt) {
+    // The draft is opened, so its update doesn't read the DB.
+    repository->updateNewTitle("dummy-title");
+    std::promise<void> transactionStarted;
+    std::promise<void> transactionReleased;
+    auto transaction = std::async(std::launch::async, [&] {
+        db->executeTransaction([&] {
+            transactionStarted.set_value();
+            transactionReleased.get_future().wait();
+        });
+    });
+    transactionStarted.get_future().wait();
+    auto deletion = std::async(std::launch::async, [this] {
+        repository->deleteAll();
+    });
+    // Give the deletion the time to wait for the transaction.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    auto update = std::async(std::launch::async, [this] {
+        repository->updateNewTitle("updated-title");
+    });
+
+    EXPECT_EQ(std::future_status::ready, update.wait_for(std::chrono::seconds(5)));
+    transactionReleased.set_value();
+    transaction.get();
+    deletion.get();
+    update.get();
+}
+
 TEST_F(DraftsRepositoryImplTest, givenDraftsInDbWhenDeleteAllIsInvokedThenAllDraftsAreNotAccessibleAnymore) {
     auto newStmt = db->createStatement("INSERT INTO pending_draft_creation (id, title, description) VALUES (0, ?, ?)");
     newStmt->bind<std::string>(1, "dummy-title");
@@ -499,4 +545,428 @@ TEST_F(DraftsRepositoryImplTest, givenIncompleteExistingDraftInMemoryWhenPersist
     repository->updateExistingTitle(45, "dummy-title");
 
     ASSERT_LIB_THROW(repository->persist(), IncompleteDraftException);
-}
\ No newline at end of file
+}
+
+TEST_F(DraftsRepositoryImplTest, givenIncompleteAndCompleteExistingDraftsWhenPersistIsInvokedThenCompleteOneIsWritten) {
+    repository->updateExistingTitle(45, "dummy-title");
+    repository->updateExistingTitle(87, "other-title");
+    repository->updateExistingDescription(87, "other-description");
+
+    ASSERT_LIB_THROW(repository->persist(), IncompleteDraftException);
+
+    auto cursor = db->createStatement("SELECT rowid, title, description FROM pending_drafts_update")->
+        execute<std::shared_ptr<Db::Cursor>>();
+    ASSERT_TRUE(cursor->next());
+    EXPECT_EQ(87, cursor->get<int>(0));
+    EXPECT_EQ("other-title", cursor->get<std::string>(1));
+    EXPECT_EQ("other-description", cursor->get<std::string>(2));
+    EXPECT_FALSE(cursor->next());
+    // The incomplete draft is kept in memory, so it's written once it's completed.
+    repository->updateExistingDescription(45, "dummy-description");
+    repository->persist();
+    EXPECT_EQ(2, getPendingExistingDraftsCount());
+}
+TEST_F(DraftsRepositoryImplTest, givenNoFlushPolicyWhenGetFlushStatsIsInvokedThenNullOptionalIsReturned) {
+    ASSERT_FALSE(repository->getFlushStats());
+}
+
+TEST_F(DraftsRepositoryImplTest, givenFlushPolicyWhenPersistIsInvokedThenDraftsAreWrittenInBackground) {
+    DraftFlushPolicy policy;
+    policy.debounce = std::chrono::hours(1);
+    repository = std::make_shared<DraftsRepositoryImpl>(db, policy);
+    repository->updateNewTitle("dummy-title");
+    repository->updateNewDescription("dummy-description");
+    repository->updateExistingTitle(45, "dummy-title");
+    repository->updateExistingDescription(45, "dummy-description");
+    repository->updateExistingDescription(45, "other-description");
+
+    repository->persist();
+
+    ASSERT_EQ(1, getPendingNewDraftsCount());
+    ASSERT_EQ(1, getPendingExistingDraftsCount());
+    auto stats = repository->getFlushStats();
+    ASSERT_TRUE(stats);
+    EXPECT_EQ(5, stats->updates);
+    EXPECT_EQ(1, stats->flushes);
+    EXPECT_EQ(2, stats->writtenDrafts);
+    EXPECT_DOUBLE_EQ(2.5, stats->coalescingRatio());
+}
+
+TEST_F(DraftsRepositoryImplTest, givenFlushPolicyAndIncompleteDraftWhenPersistIsInvokedThenExceptionIsThrown) {
+    DraftFlushPolicy policy;
+    policy.debounce = std::chrono::hours(1);
+    repository = std::make_shared<DraftsRepositoryImpl>(db, policy);
+    repository->updateExistingTitle(45, "dummy-title");
+    repository->updateExistingTitle(87, "other-title");
+    repository->updateExistingDescription(87, "other-description");
+
+    ASSERT_LIB_THROW(repository->persist(), IncompleteDraftException);
+
+    EXPECT_EQ(1, getPendingExistingDraftsCount());
+    EXPECT_EQ(1, repository->getFlushStats()->failures);
+}
+
+TEST_F(DraftsRepositoryImplTest, givenFlushPolicyWhenRepositoryIsDestroyedThenDraftsAreWritten) {
+    DraftFlushPolicy policy;
+    policy.debounce = std::chrono::hours(1);
+    repository = std::make_shared<DraftsRepositoryImpl>(db, policy);
+    repository->updateNewTitle("dummy-title");
+    repository->updateNewDescription("dummy-description");
+
+    repository = nullptr;
+
+    ASSERT_EQ(1, getPendingNewDraftsCount());
+}
+
+TEST_F(DraftsRepositoryImplTest, givenFlushPolicyWhenDirtyBytesReachThresholdThenDraftsAreWritten) {
+    DraftFlushPolicy policy;
+    policy.debounce = std::chrono::hours(1);
+    policy.dirtyBytesThreshold = 20;
+    repository = std::make_shared<DraftsRepositoryImpl>(db, policy);
+
+    repository->updateExistingTitle(45, "dummy-title");
+    repository->updateExistingDescription(45, "dummy-description");
+
+    // The flush is started by the threshold, so the test only waits for it.
+    for (int i = 0; i < 500 && repository->getFlushStats()->writtenDrafts == 0; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(1, getPendingExistingDraftsCount());
+}
+
+TEST_F(DraftsRepositoryImplTest, givenFlushPolicyWhenDraftIsDeletedThenItIsNotWrittenAgain) {
+    DraftFlushPolicy policy;
+    policy.debounce = std::chrono::hours(1);
+    repository = std::make_shared<DraftsRepositoryImpl>(db, policy);
+    repository->updateNewTitle("dummy-title");
+    repository->updateNewDescription("dummy-description");
+    repository->persist();
+
+    repository->deleteNew();
+    repository = nullptr;
+
+    ASSERT_EQ(0, getPendingNewDraftsCount());
+}
+
+TEST_F(DraftsRepositoryImplTest, givenPersistedDraftWhenPersistIsInvokedAgainThenItIsNotWrittenAgain) {
+    repository->updateExistingTitle(45, "dummy-title");
+    repository->updateExistingDescription(45, "dummy-description");
+    repository->persist();
+    // The row is changed behind the repository to know if it's written again.
+    db->createStatement("UPDATE pending_drafts_update SET title = 'other-title'")->execute<void>();
+
+    repository->updateExistingTitle(45, "dummy-title");
+    repository->persist();
+
+    auto title = db->createStatement("SELECT title FROM pending_drafts_update WHERE rowid = 45")->
+        execute<stdx::optional<std::string>>();
+    EXPECT_EQ("other-title", *title);
+}
+
+TEST_F(DraftsRepositoryImplTest, givenOneOfManyOpenedDraftsChangedWhenPersistIsInvokedThenOnlyItIsWritten) {
+    for (int id = 1; id <= 3; id++) {
+        repository->updateExistingTitle(id, "dummy-title");
+        repository->updateExistingDescription(id, "dummy-description");
+    }
+    repository->persist();
+    db->createStatement("UPDATE pending_drafts_update SET description = 'other-description'")->execute<void>();
+
+    repository->updateExistingDescription(2, "changed-description");
+    repository->persist();
+
+    auto descriptions = db->createStatement("SELECT description FROM pending_drafts_update ORDER BY rowid")->
+        execute<std::shared_ptr<Db::Cursor>>()->rows<std::string>();
+    EXPECT_EQ((std::vector<std::tuple<std::string>>({
+        std::make_tuple(std::string("other-description")),
+        std::make_tuple(std::string("changed-description")),
+        std::make_tuple(std::string("other-description"))
+    })), descriptions);
+}
+
+TEST_F(DraftsRepositoryImplTest, givenPersistedDraftWhenGetExistingIsInvokedThenItIsReadFromMemory) {
+    repository->updateExistingTitle(45, "dummy-title");
+    repository->updateExistingDescription(45, "dummy-description");
+    repository->persist();
+
+    auto draft = repository->getExisting(45);
+
+    ASSERT_TRUE(draft);
+    EXPECT_EQ("dummy-title", draft->getTitle());
+    EXPECT_EQ("dummy-description", draft->getDescription());
+}
+
+TEST_F(DraftsRepositoryImplTest, givenPersistedEmptyNewDraftWhenGetNewIsInvokedThenNullOptionalIsReturned) {
+    repository->updateNewTitle("dummy-title");
+    repository->updateNewDescription("dummy-description");
+    repository->persist();
+    repository->updateNewTitle("");
+    repository->updateNewDescription("");
+    repository->persist();
+
+    ASSERT_FALSE(repository->getNew());
+    ASSERT_EQ(0, getPendingNewDraftsCount());
+}
+
+TEST_F(DraftsRepositoryImplTest, givenDraftInDbWhenGetExistingIsInvokedTwiceThenItIsReadFromDbOnce) {
+    db->createStatement("INSERT INTO pending_drafts_update (rowid, title, description) "
+                        "VALUES (45, 'dummy-title', 'dummy-description')")->execute<void>();
+    repository->getExisting(45);
+    db->createStatement("DELETE FROM pending_drafts_update")->execute<void>();
+
+    auto draft = repository->getExisting(45);
+
+    ASSERT_TRUE(draft);
+    EXPECT_EQ(Draft("dummy-title", "dummy-description"), *draft);
+}
+
+TEST_F(DraftsRepositoryImplTest, givenPreloadWhenRepositoryIsCreatedThenDraftsAreReadFromMemory) {
+    db->createStatement("INSERT INTO pending_draft_creation (id, title, description) "
+                        "VALUES (0, 'new-title', 'new-description')")->execute<void>();
+    db->createStatement("INSERT INTO pending_drafts_update (rowid, title, description) "
+                        "VALUES (45, 'dummy-title', 'dummy-description'), (46, 'other-title', 'other-description')")->
+        execute<void>();
+    repository = std::make_shared<DraftsRepositoryImpl>(db, stdx::nullopt, true);
+    // The rows are deleted behind the repository to know if the drafts are read from the DB.
+    db->createStatement("DELETE FROM pending_draft_creation")->execute<void>();
+    db->createStatement("DELETE FROM pending_drafts_update")->execute<void>();
+
+    auto newDraft = repository->getNew();
+    auto firstDraft = repository->getExisting(45);
+    auto secondDraft = repository->getExisting(46);
+
+    ASSERT_TRUE(newDraft);
+    EXPECT_EQ(Draft("new-title", "new-description"), *newDraft);
+    ASSERT_TRUE(firstDraft);
+    EXPECT_EQ(Draft("dummy-title", "dummy-description"), *firstDraft);
+    ASSERT_TRUE(secondDraft);
+    EXPECT_EQ(Draft("other-title", "other-description"), *secondDraft);
+}
+
+TEST_F(DraftsRepositoryImplTest, givenPreloadWithoutDraftsWhenGetExistingIsInvokedThenDbIsNotQueried) {
+    repository = std::make_shared<DraftsRepositoryImpl>(db, stdx::nullopt, true);
+    db->createStatement("INSERT INTO pending_drafts_update (rowid, title, description) "
+                        "VALUES (45, 'dummy-title', 'dummy-description')")->execute<void>();
+
+    ASSERT_FALSE(repository->getExisting(45));
+    ASSERT_FALSE(repository->getNew());
+}
+
+TEST_F(DraftsRepositoryImplTest, givenPreloadWhenUpdateExistingTitleIsInvokedThenDescriptionIsKept) {
+    db->createStatement("INSERT INTO pending_drafts_update (rowid, title, description) "
+                        "VALUES (45, 'dummy-title', 'dummy-description')")->execute<void>();
+    repository = std::make_shared<DraftsRepositoryImpl>(db, stdx::nullopt, true);
+
+    repository->updateExistingTitle(45, "changed-title");
+    repository->persist();
+
+    auto rows = db->createStatement("SELECT title, description FROM pending_drafts_update WHERE rowid = 45")->
+        execute<std::shared_ptr<Db::Cursor>>()->rows<std::string, std::string>();
+    EXPECT_EQ((std::vector<std::tuple<std::string, std::string>>({
+        std::make_tuple(std::string("changed-title"), std::string("dummy-description"))
+    })), rows);
+}
+
+TEST_F(DraftsRepositoryImplTest, givenNoNewDraftWhenDescriptionIsEditedThenEmptyDraftIsEdited) {
+    repository->insertInNewDescription(0, "dummy-description");
+    repository->eraseFromNewDescription(0, 6);
+
+    repository->persist();
+
+    auto draft = repository->getNew();
+    ASSERT_TRUE(draft);
+    EXPECT_EQ(Draft("", "description"), *draft);
+    EXPECT_EQ(1, getPendingNewDraftsCount());
+}
+
+TEST_F(DraftsRepositoryImplTest, givenExistingDraftInDbWhenDescriptionIsEditedThenEditedDescriptionIsPersisted) {
+    db->createStatement("INSERT INTO pending_drafts_update (rowid, title, description) "
+                        "VALUES (45, 'dummy-title', 'dummy-description')")->execute<void>();
+
+    repository->insertInExistingDescription(45, 5, " edited");
+    repository->eraseFromExistingDescription(45, 0, 1);
+    repository->persist();
+
+    auto description = db->createStatement("SELECT description FROM pending_drafts_update WHERE rowid = 45")->
+        execute<stdx::optional<std::string>>();
+    EXPECT_EQ("ummy edited-description", *description);
+}
+
+TEST_F(DraftsRepositoryImplTest, givenExistingDraftWithoutDescriptionWhenDescriptionIsEditedThenExceptionIsThrown) {
+    repository->updateExistingTitle(45, "dummy-title");
+
+    ASSERT_LIB_THROW(repository->insertInExistingDescription(45, 0, "dummy"), IncompleteDraftException);
+    ASSERT_LIB_THROW(repository->eraseFromExistingDescription(46, 0, 1), IncompleteDraftException);
+}
+
+TEST_F(DraftsRepositoryImplTest, givenLogWhenRepositoryIsCreatedAgainThenChangesNotPersistedAreWritten) {
+    std::remove("drafts_repository_impl_test.log");
+    db->createStatement("INSERT INTO pending_drafts_update (rowid, title, description) "
+                        "VALUES (45, 'dummy-title', 'dummy-description')")->execute<void>();
+    repository = std::make_shared<DraftsRepositoryImpl>(db, stdx::nullopt, false, "drafts_repository_impl_test.log");
+    repository->updateNewTitle("new-title");
+    repository->updateNewDescription("new-description");
+    repository->insertInExistingDescription(45, 5, " edited");
+    repository->eraseFromExistingDescription(45, 0, 1);
+
+    // The repository is destroyed without persisting the changes, like in a crash.
+    repository = std::make_shared<DraftsRepositoryImpl>(db, stdx::nullopt, false, "drafts_repository_impl_test.log");
+
+    EXPECT_EQ(1, getPendingNewDraftsCount());
+    auto description = db->createStatement("SELECT description FROM pending_drafts_update WHERE rowid = 45")->
+        execute<stdx::optional<std::string>>();
+    EXPECT_EQ("ummy edited-description", *description);
+    EXPECT_EQ(Draft("new-title", "new-description"), *repository->getNew());
+    std::remove("drafts_repository_impl_test.log");
+}
+
+TEST_F(DraftsRepositoryImplTest, givenLogWithDeletedDraftWhenRepositoryIsCreatedAgainThenDraftIsNotWritten) {
+    std::remove("drafts_repository_impl_test.log");
+    repository = std::make_shared<DraftsRepositoryImpl>(db, stdx::nullopt, false, "drafts_repository_impl_test.log");
+    repository->updateNewTitle("new-title");
+    repository->updateNewDescription("new-description");
+    repository->updateExistingTitle(45, "dummy-title");
+    repository->updateExistingDescription(45, "dummy-description");
+    repository->deleteNew();
+
+    repository = std::make_shared<DraftsRepositoryImpl>(db, stdx::nullopt, false, "drafts_repository_impl_test.log");
+
+    EXPECT_EQ(0, getPendingNewDraftsCount());
+    EXPECT_EQ(1, getPendingExistingDraftsCount());
+    std::remove("drafts_repository_impl_test.log");
+}
+
+TEST_F(DraftsRepositoryImplTest, givenLogWhenPersistIsInvokedThenChangesAreNotReplayedAgain) {
+    std::remove("drafts_repository_impl_test.log");
+    repository = std::make_shared<DraftsRepositoryImpl>(db, stdx::nullopt, false, "drafts_repository_impl_test.log");
+    repository->updateExistingTitle(45, "dummy-title");
+    repository->updateExistingDescription(45, "dummy-description");
+    repository->persist();
+    // The draft is changed in the DB, so a replay of the persisted changes would overwrite it.
+    db->createStatement("UPDATE pending_drafts_update SET title = 'other-title' WHERE rowid = 45")->execute<void>();
+
+    repository = std::make_shared<DraftsRepositoryImpl>(db, stdx::nullopt, false, "drafts_repository_impl_test.log");
+
+    auto title = db->createStatement("SELECT title FROM pending_drafts_update WHERE rowid = 45")->
+        execute<stdx::optional<std::string>>();
+    EXPECT_EQ("other-title", *title);
+    std::remove("drafts_repository_impl_test.log");
+}
+
+TEST_F(DraftsRepositoryImplTest, givenLogWithIncompleteDraftWhenPersistIsInvokedThenOnlyItsChangesAreReplayed) {
+    std::remove("drafts_repository_impl_test.log");
+    db->createStatement("INSERT INTO pending_drafts_update (rowid, title, description) "
+                        "VALUES (45, 'dummy-title', 'dummy-description')")->execute<void>();
+    repository = std::make_shared<DraftsRepositoryImpl>(db, stdx::nullopt, false, "drafts_repository_impl_test.log");
+    repository->insertInExistingDescription(45, 5, " edited");
+    repository->updateExistingTitle(46, "other-title");
+    ASSERT_LIB_THROW(repository->persist(), IncompleteDraftException);
+
+    // The repository is destroyed without persisting the incomplete draft, like in a crash.
+    repository = std::make_shared<DraftsRepositoryImpl>(db, stdx::nullopt, false, "drafts_repository_impl_test.log");
+    repository->updateExistingDescription(46, "other-description");
+    repository->persist();
+
+    auto description = db->createStatement("SELECT description FROM pending_drafts_update WHERE rowid = 45")->
+        execute<stdx::optional<std::string>>();
+    EXPECT_EQ("dummy edited-description", *description);
+    EXPECT_EQ(Draft("other-title", "other-description"), *repository->getExisting(46));
+    EXPECT_EQ(2, getPendingExistingDraftsCount());
+    std::remove("drafts_repository_impl_test.log");
+}
+
+TEST_F(DraftsRepositoryImplTest, givenLogNotTruncatedAfterCommitWhenRepositoryIsCreatedAgainThenEditsAreNotReplayed) {
+    std::remove("drafts_repository_impl_test.log");
+    db->createStatement("INSERT INTO pending_drafts_update (rowid, title, description) "
+                        "VALUES (45, 'dummy-title', 'dummy-description')")->execute<void>();
+    repository = std::make_shared<DraftsRepositoryImpl>(db, stdx::nullopt, false, "drafts_repository_impl_test.log");
+    repository->insertInExistingDescription(45, 5, " edited");
+    repository->eraseFromExistingDescription(45, 0, 1);
+    repository->updateExistingTitle(46, "other-title");
+    std::string committedLog;
+    auto listenerId = db->addChangeListener([&committedLog](const std::vector<Db::TableChanges> &) {
+        // The process could crash right after the drafts are committed, before the log is truncated.
+        std::ifstream file("drafts_repository_impl_test.log", std::ios::binary);
+        committedLog.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    });
+    ASSERT_LIB_THROW(repository->persist(), IncompleteDraftException);
+    db->removeChangeListener(listenerId);
+    repository = nullptr;
+    ASSERT_FALSE(committedLog.empty());
+    {
+        std::ofstream file("drafts_repository_impl_test.log", std::ios::binary | std::ios::trunc);
+        file << committedLog;
+    }
+
+    repository = std::make_shared<DraftsRepositoryImpl>(db, stdx::nullopt, false, "drafts_repository_impl_test.log");
+
+    // The edits aren't idempotent, so they would be applied twice if they were replayed.
+    auto description = db->createStatement("SELECT description FROM pending_drafts_update WHERE rowid = 45")->
+        execute<stdx::optional<std::string>>();
+    EXPECT_EQ("ummy edited-description", *description);
+    // The incomplete draft was logged again after the committed position.
+    repository->updateExistingDescription(46, "other-description");
+    EXPECT_EQ(Draft("other-title", "other-description"), *repository->getExisting(46));
+    std::remove("drafts_repository_impl_test.log");
+}
+
+TEST_F(DraftsRepositoryImplTest, givenLogWhenEditOutOfRangeIsInvokedThenItIsNotLogged) {
+    std::remove("drafts_repository_impl_test.log");
+    repository = std::make_shared<DraftsRepositoryImpl>(db, stdx::nullopt, false, "drafts_repository_impl_test.log");
+    repository->updateNewTitle("new-title");
+    repository->updateNewDescription("new-description");
+    repository->updateExistingTitle(45, "dummy-title");
+    repository->updateExistingDescription(45, "dummy-description");
+    ASSERT_LIB_THROW(repository->insertInNewDescription(16, "dummy"), std::out_of_range);
+    ASSERT_LIB_THROW(repository->eraseFromNewDescription(10, 6), std::out_of_range);
+    ASSERT_LIB_THROW(repository->insertInExistingDescription(45, 18, "dummy"), std::out_of_range);
+    ASSERT_LIB_THROW(repository->eraseFromExistingDescription(45, 18, 1), std::out_of_range);
+
+    // The repository is destroyed without persisting the changes, like in a crash.
+    repository = nullptr;
+
+    EXPECT_EQ(4, DraftLog("drafts_repository_impl_test.log").read().size());
+    std::remove("drafts_repository_impl_test.log");
+}
+
+TEST_F(DraftsRepositoryImplTest, givenLogWhenDraftIsDeletedThenDeletionIsLoggedBeforeItIsCommitted) {
+    std::remove("drafts_repository_impl_test.log");
+    db->createStatement("INSERT INTO pending_drafts_update (rowid, title, description) "
+                        "VALUES (45, 'dummy-title', 'dummy-description')")->execute<void>();
+    repository = std::make_shared<DraftsRepositoryImpl>(db, stdx::nullopt, false, "drafts_repository_impl_test.log");
+    repository->updateExistingTitle(45, "new-title");
+    std::vector<DraftLog::Record> committedLog;
+    auto listenerId = db->addChangeListener([&committedLog](const std::vector<Db::TableChanges> &) {
+        // The process could crash right after the deletion is committed.
+        committedLog = DraftLog("drafts_repository_impl_test.log").read();
+    });
+
+    repository->deleteExisting(45);
+
+    db->removeChangeListener(listenerId);
+    ASSERT_FALSE(committedLog.empty());
+    EXPECT_EQ(DraftLog::Operation::DeleteExisting, committedLog.back().operation);
+    EXPECT_EQ(45, committedLog.back().id);
+    std::remove("drafts_repository_impl_test.log");
+}
+
+TEST_F(DraftsRepositoryImplTest, givenDraftChangedWhileItIsDeletedWhenLogIsReplayedThenItIsDeletedToo) {
+    std::remove("drafts_repository_impl_test.log");
+    db->createStatement("INSERT INTO pending_drafts_update (rowid, title, description) "
+                        "VALUES (45, 'dummy-title', 'dummy-description')")->execute<void>();
+    repository = std::make_shared<DraftsRepositoryImpl>(db, stdx::nullopt, false, "drafts_repository_impl_test.log");
+    auto listenerId = db->addChangeListener([this](const std::vector<Db::TableChanges> &) {
+        // The draft is changed after it's deleted from the DB, but before it's deleted from memory.
+        repository->updateExistingTitle(45, "new-title");
+    });
+
+    repository->deleteExisting(45);
+    db->removeChangeListener(listenerId);
+    EXPECT_FALSE(repository->getExisting(45));
+
+    // The repository is destroyed without persisting the changes, like in a crash.
+    repository = std::make_shared<DraftsRepositoryImpl>(db, stdx::nullopt, false, "drafts_repository_impl_test.log");
+
+    EXPECT_EQ(0, getPendingExistingDraftsCount());
+    EXPECT_FALSE(repository->getExisting(45));
+    std::remove("drafts_repository_impl_test.log");
+}
@@ -13,6 +13,14 @@ class DraftsRepositoryMock : public DraftsRepository {
 
     MOCK_METHOD(void, updateExistingDescription, (int id, std::string description), (override));
 
+    MOCK_METHOD(void, insertInNewDescription, (size_t offset, std::string text), (override));
+
+    MOCK_METHOD(void, eraseFromNewDescription, (size_t offset, size_t count), (override));
+
+    MOCK_METHOD(void, insertInExistingDescription, (int id, size_t offset, std::string text), (override));
+
+    MOCK_METHOD(void, eraseFromExistingDescription, (int id, size_t offset, size_t count), (override));
+
     MOCK_METHOD(void, persist, (), (override));
 
     MOCK_METHOD(void, deleteAll, (), (override));
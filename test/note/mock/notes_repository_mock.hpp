@@ -5,15 +5,29 @@
 
 class NotesRepositoryMock : public NotesRepository {
    public:
-    MOCK_METHOD(void, insert, (Draft note), (override));
+    MOCK_METHOD(Note, insert, (Draft note), (override));
 
     MOCK_METHOD(void, deleteWithId, (int id), (override));
 
-    MOCK_METHOD(void, update, (int id, Draft note), (override));
+    MOCK_METHOD(stdx::optional<Note>, update, (int id, Draft note), (override));
 
     MOCK_METHOD(void, deleteAll, (), (override));
 
     MOCK_METHOD(std::vector<Note>, getAll, (), (override));
 
+    MOCK_METHOD(NotesPage, getPage, (size_t size, stdx::optional<NotesPage::Key> after), (override));
+
+    MOCK_METHOD(void, forEach, (const std::function<void(Note)> &consumer), (override));
+
+    MOCK_METHOD(std::vector<NoteSummary>, getSummaries, (), (override));
+
+    MOCK_METHOD(stdx::optional<Note>, getById, (int id), (override));
+
     MOCK_METHOD(std::vector<Note>, getByText, (std::string text), (override));
+
+    MOCK_METHOD(std::vector<NoteMatch>, getRankedByText, (std::string text, size_t limit), (override));
+
+    MOCK_METHOD(int, subscribe, (std::function<void(NotesChange)> listener), (override));
+
+    MOCK_METHOD(void, unsubscribe, (int subscriptionId), (override));
 };
@@ -175,3 +175,48 @@ TEST(MutableDraftTest, givenDifferentFieldsWhenEqualityOperatorIsInvokedThenItRe
 
     EXPECT_FALSE(first == second);
 }
+
+TEST(MutableDraftTest, givenSameFieldsWhenHashIsInvokedThenSameHashIsReturned) {
+    auto first = MutableDraft();
+    auto second = MutableDraft();
+    first.updateTitle("dummy-title");
+    first.updateDescription("dummy-description");
+    second.updateTitle("dummy-title");
+    second.updateDescription("dummy-description");
+
+    EXPECT_EQ(first.hash(), second.hash());
+}
+
+TEST(MutableDraftTest, givenDifferentFieldsWhenHashIsInvokedThenDifferentHashIsReturned) {
+    auto first = MutableDraft();
+    auto second = MutableDraft();
+    first.updateTitle("dummy-title");
+    first.updateDescription("dummy-description");
+    second.updateTitle("dummy-description");
+    second.updateDescription("dummy-title");
+
+    EXPECT_NE(first.hash(), second.hash());
+
+    auto missing = MutableDraft();
+    auto empty = MutableDraft();
+    empty.updateTitle("");
+
+    EXPECT_NE(missing.hash(), empty.hash());
+}
+
+TEST(MutableDraftTest, givenDescriptionWhenItIsEditedThenDescriptionIsChanged) {
+    auto draft = MutableDraft();
+    draft.updateDescription("dummy-description");
+
+    draft.insertInDescription(5, " edited");
+    draft.eraseFromDescription(0, 1);
+
+    EXPECT_EQ("ummy edited-description", draft.requireDescription());
+}
+
+TEST(MutableDraftTest, givenMutableDraftWithoutDescriptionWhenItIsEditedThenExceptionIsThrown) {
+    auto draft = MutableDraft();
+
+    ASSERT_LIB_THROW(draft.insertInDescription(0, "dummy"), CompatBadOptionalAccessException);
+    ASSERT_LIB_THROW(draft.eraseFromDescription(0, 1), CompatBadOptionalAccessException);
+}
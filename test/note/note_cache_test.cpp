@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include "note/note_cache.hpp"
+
+TEST(NoteCacheTest, givenUnloadedCacheWhenGetAllIsInvokedThenMissIsCounted) {
+    auto cache = NoteCache(1024);
+
+    auto notes = cache.getAll();
+
+    EXPECT_FALSE(notes);
+    EXPECT_EQ(0, cache.stats().hits);
+    EXPECT_EQ(1, cache.stats().misses);
+}
+
+TEST(NoteCacheTest, givenLoadedCacheWhenGetAllIsInvokedThenNotesAreReturnedSortedByIdAndHitIsCounted) {
+    auto cache = NoteCache(1024);
+    cache.load({Note(1, "a", "b", 1572085165), Note(3, "c", "d", 1572085166)}, 1, cache.generation());
+
+    auto notes = cache.getAll();
+
+    ASSERT_TRUE(notes);
+    EXPECT_EQ(std::vector<Note>({Note(1, "a", "b", 1572085165), Note(3, "c", "d", 1572085166)}), *notes);
+    EXPECT_EQ(1, cache.stats().hits);
+    EXPECT_EQ(0, cache.stats().misses);
+    EXPECT_DOUBLE_EQ(1.0, cache.stats().hitRatio());
+}
+
+TEST(NoteCacheTest, givenIdsWhenGetAllIsInvokedThenExistentNotesAreReturnedInTheirOrder) {
+    auto cache = NoteCache(1024);
+    cache.load({Note(1, "a", "b", 1572085165), Note(3, "c", "d", 1572085166)}, 1, cache.generation());
+
+    auto notes = cache.getAll(std::vector<int>({3, 2, 1}));
+
+    ASSERT_TRUE(notes);
+    EXPECT_EQ(std::vector<Note>({Note(3, "c", "d", 1572085166), Note(1, "a", "b", 1572085165)}), *notes);
+}
+
+TEST(NoteCacheTest, givenNotesOverBudgetWhenLoadIsInvokedThenCacheIsNotLoaded) {
+    auto cache = NoteCache(100);
+
+    cache.load({Note(1, std::string(200, 'a'), "b", 1572085165)}, 1, cache.generation());
+
+    EXPECT_FALSE(cache.isLoaded());
+    EXPECT_EQ(0, cache.stats().bytes);
+    EXPECT_EQ(100, cache.stats().budget);
+}
+
+TEST(NoteCacheTest, givenNotesInBudgetWhenLoadIsInvokedThenTheirBytesAreCounted) {
+    auto cache = NoteCache(1024);
+
+    cache.load({Note(1, "title", "description", 1572085165)}, 1, cache.generation());
+
+    EXPECT_TRUE(cache.isLoaded());
+    // The bytes include the characters of the strings and the overhead of the note.
+    EXPECT_LT(16, cache.stats().bytes);
+    EXPECT_GE(1024, cache.stats().bytes);
+}
+
+TEST(NoteCacheTest, givenSameDataVersionWhenValidateIsInvokedThenCacheIsKept) {
+    auto cache = NoteCache(1024);
+    cache.load({Note(1, "a", "b", 1572085165)}, 4, cache.generation());
+
+    cache.validate(4);
+
+    EXPECT_TRUE(cache.isLoaded());
+    EXPECT_EQ(0, cache.stats().invalidations);
+}
+
+TEST(NoteCacheTest, givenDifferentDataVersionWhenValidateIsInvokedThenCacheIsDropped) {
+    auto cache = NoteCache(1024);
+    cache.load({Note(1, "a", "b", 1572085165)}, 4, cache.generation());
+
+    cache.validate(5);
+
+    EXPECT_FALSE(cache.isLoaded());
+    EXPECT_EQ(0, cache.stats().bytes);
+    EXPECT_EQ(1, cache.stats().invalidations);
+}
+
+TEST(NoteCacheTest, givenLoadedCacheWhenPutIsInvokedThenNoteIsAddedOrReplaced) {
+    auto cache = NoteCache(1024);
+    cache.load({Note(1, "a", "b", 1572085165)}, 1, cache.generation());
+
+    cache.put(Note(2, "c", "d", 1572085166));
+    cache.put(Note(1, "e", "f", 1572085167));
+
+    EXPECT_EQ(std::vector<Note>({Note(1, "e", "f", 1572085167), Note(2, "c", "d", 1572085166)}), *cache.getAll());
+}
+
+TEST(NoteCacheTest, givenUnloadedCacheWhenPutIsInvokedThenNoteIsNotCached) {
+    auto cache = NoteCache(1024);
+
+    cache.put(Note(1, "a", "b", 1572085165));
+
+    EXPECT_FALSE(cache.isLoaded());
+    EXPECT_EQ(0, cache.stats().bytes);
+}
+
+TEST(NoteCacheTest, givenNoteOverBudgetWhenPutIsInvokedThenCacheIsDropped) {
+    auto cache = NoteCache(200);
+    cache.load({Note(1, "a", "b", 1572085165)}, 1, cache.generation());
+
+    cache.put(Note(2, std::string(200, 'a'), "b", 1572085166));
+
+    EXPECT_FALSE(cache.isLoaded());
+}
+
+TEST(NoteCacheTest, givenInexistentNoteWhenReplaceIsInvokedThenNoteIsNotAdded) {
+    auto cache = NoteCache(1024);
+    cache.load({Note(1, "a", "b", 1572085165)}, 1, cache.generation());
+    auto bytes = cache.stats().bytes;
+
+    cache.replace(Note(2, "c", "d", 1572085166));
+    cache.replace(Note(1, "e", "f", 1572085167));
+
+    EXPECT_EQ(std::vector<Note>({Note(1, "e", "f", 1572085167)}), *cache.getAll());
+    EXPECT_EQ(bytes, cache.stats().bytes);
+}
+
+TEST(NoteCacheTest, givenCachedNoteWhenRemoveIsInvokedThenItsBytesAreReleased) {
+    auto cache = NoteCache(1024);
+    cache.load({Note(1, "a", "b", 1572085165), Note(2, "c", "d", 1572085166)}, 1, cache.generation());
+    auto bytes = cache.stats().bytes;
+
+    cache.remove(1);
+
+    EXPECT_EQ(std::vector<Note>({Note(2, "c", "d", 1572085166)}), *cache.getAll());
+    EXPECT_EQ(bytes / 2, cache.stats().bytes);
+}
+
+TEST(NoteCacheTest, givenLoadedCacheWhenRemoveAllIsInvokedThenCacheIsEmptyAndLoaded) {
+    auto cache = NoteCache(1024);
+    cache.load({Note(1, "a", "b", 1572085165)}, 1, cache.generation());
+
+    cache.removeAll();
+
+    EXPECT_TRUE(cache.isLoaded());
+    EXPECT_EQ(std::vector<Note>(), *cache.getAll());
+    EXPECT_EQ(0, cache.stats().bytes);
+}
+
+TEST(NoteCacheTest, givenHitsAndMissesWhenHitRatioIsInvokedThenFractionOfHitsIsReturned) {
+    auto cache = NoteCache(1024);
+    EXPECT_DOUBLE_EQ(0.0, cache.stats().hitRatio());
+
+    cache.getAll();
+    cache.load({}, 1, cache.generation());
+    cache.getAll();
+    cache.getAll();
+    cache.countMiss();
+
+    EXPECT_DOUBLE_EQ(0.5, cache.stats().hitRatio());
+}
+
+TEST(NoteCacheTest, givenNoteChangedWhileNotesAreQueriedWhenLoadIsInvokedThenNotesAreNotCached) {
+    auto cache = NoteCache(1024);
+    auto generation = cache.generation();
+    // The note is inserted after the notes were queried, so it's missing from them.
+    cache.put(Note(2, "c", "d", 1572085166));
+
+    cache.load({Note(1, "a", "b", 1572085165)}, 1, generation);
+
+    EXPECT_FALSE(cache.isLoaded());
+    cache.load({Note(1, "a", "b", 1572085165), Note(2, "c", "d", 1572085166)}, 1, cache.generation());
+    EXPECT_TRUE(cache.isLoaded());
+}
@@ -16,6 +16,19 @@ void NoteDatabaseInitializerTest::changeVersion(int version) {
     Db::Client::release();
 }
 
+void NoteDatabaseInitializerTest::createNotesTable() {
+    // The table of the notes as it was created by the version 2 of the schema.
+    Db::Client::create(testDbPath);
+    Db::Client::get()->createStatement(
+        "CREATE TABLE notes ("
+        "title TEXT NOT NULL, "
+        "description TEXT NOT NULL, "
+        "last_update_date TEXT NOT NULL"
+        ")"
+    )->execute<void>();
+    Db::Client::release();
+}
+
 void NoteDatabaseInitializerTest::TearDown() {
     Db::Client::release();
     // Remove the database file to reset the environment after each test.
@@ -63,11 +76,19 @@ TEST_F(NoteDatabaseInitializerTest, givenFirstCreationWhenInitializeIsInvokedThe
     EXPECT_EQ("pending_drafts_update", tableCursor->get<std::string>(0));
     EXPECT_TRUE(tableCursor->next());
     EXPECT_EQ("pending_draft_creation", tableCursor->get<std::string>(0));
-    EXPECT_FALSE(tableCursor->next());
+    EXPECT_TRUE(tableCursor->next());
+    EXPECT_EQ("draft_log_checkpoint", tableCursor->get<std::string>(0));
+    // The substring index and its shadow tables.
+    EXPECT_TRUE(tableCursor->next());
+    EXPECT_EQ("notes_trigram", tableCursor->get<std::string>(0));
+    while (tableCursor->next()) {
+        EXPECT_EQ(0, tableCursor->get<std::string>(0).find("notes_trigram_"));
+    }
 }
 
 TEST_F(NoteDatabaseInitializerTest, givenMajorVersionWhenInitializeIsInvokedThenVersionIsUpdated) {
     changeVersion(NoteDb::version - 1);
+    createNotesTable();
 
     NoteDb::initialize(testDbPath);
 
@@ -76,4 +97,190 @@ TEST_F(NoteDatabaseInitializerTest, givenMajorVersionWhenInitializeIsInvokedThen
     auto version = db->createStatement("PRAGMA user_version")->execute<int>();
     // The version should be set to NoteDb::version.
     EXPECT_EQ(NoteDb::version, version);
-}
\ No newline at end of file
+}
+
+TEST_F(NoteDatabaseInitializerTest, givenVersion2WithNotesWhenInitializeIsInvokedThenNotesAreIndexed) {
+    changeVersion(2);
+    createNotesTable();
+    Db::Client::create(testDbPath);
+    Db::Client::get()->createStatement("INSERT INTO notes (title, description, last_update_date) "
+                                       "VALUES ('dummy-title', 'dummy-description', '2019-10-26T10:19:25Z')")->
+        execute<void>();
+    Db::Client::release();
+
+    NoteDb::initialize(testDbPath);
+
+    auto db = Db::Client::get();
+    auto matches = db->createStatement("SELECT COUNT(*) FROM notes_trigram WHERE notes_trigram MATCH '\"my-ti\"'")->
+        execute<int>();
+    EXPECT_EQ(1, matches);
+}
+
+TEST_F(NoteDatabaseInitializerTest, givenVersion3WhenInitializeIsInvokedThenWordIndexIsReplaced) {
+    changeVersion(3);
+    createNotesTable();
+    Db::Client::create(testDbPath);
+    // The word index of the version 3 of the schema, with one of its triggers.
+    Db::Client::get()->createStatement(
+        "CREATE VIRTUAL TABLE notes_fts USING fts5(title, description, content = 'notes', content_rowid = 'rowid')"
+    )->execute<void>();
+    Db::Client::get()->createStatement(
+        "CREATE TRIGGER notes_fts_after_insert AFTER INSERT ON notes BEGIN "
+        "INSERT INTO notes_fts (rowid, title, description) VALUES (new.rowid, new.title, new.description); "
+        "END"
+    )->execute<void>();
+    Db::Client::release();
+
+    NoteDb::initialize(testDbPath);
+
+    auto db = Db::Client::get();
+    auto wordIndexObjects = db->createStatement("SELECT COUNT(*) FROM sqlite_master WHERE name LIKE 'notes_fts%'")->
+        execute<int>();
+    EXPECT_EQ(0, wordIndexObjects);
+    auto substringIndexes = db->createStatement("SELECT COUNT(*) FROM sqlite_master WHERE name = 'notes_trigram'")->
+        execute<int>();
+    EXPECT_EQ(1, substringIndexes);
+}
+
+TEST_F(NoteDatabaseInitializerTest, givenVersion5WithNotesWhenInitializeIsInvokedThenDatesAreConvertedToSeconds) {
+    changeVersion(5);
+    createNotesTable();
+    Db::Client::create(testDbPath);
+    // More notes than a chunk of the migration, with a gap in the rowids.
+    auto insertStmt = Db::Client::get()->createStatement("INSERT INTO notes (rowid, title, description, last_update_date) "
+                                                         "VALUES (?, ?, 'dummy-description', '2019-10-26T10:19:25Z')");
+    std::vector<std::tuple<int, std::string>> rows;
+    for (int i = 1; i <= 2500; i++) {
+        rows.emplace_back(i < 2000 ? i : i + 10, "dummy-title-" + std::to_string(i));
+    }
+    insertStmt->executeBatch(rows);
+    Db::Client::release();
+
+    NoteDb::initialize(testDbPath);
+
+    auto db = Db::Client::get();
+    EXPECT_EQ(2500, db->createStatement("SELECT COUNT(*) FROM notes")->execute<int>());
+    EXPECT_EQ(2500, db->createStatement("SELECT COUNT(*) FROM notes "
+                                        "WHERE typeof(last_update_date) = 'integer' "
+                                        "AND last_update_date = 1572085165")->execute<int>());
+    EXPECT_EQ(2510, db->createStatement("SELECT max(rowid) FROM notes")->execute<int>());
+    EXPECT_EQ(0, db->createStatement("SELECT COUNT(*) FROM sqlite_master WHERE name = 'notes_epoch'")->execute<int>());
+}
+
+TEST_F(NoteDatabaseInitializerTest, givenInterruptedMigrationWhenInitializeIsInvokedThenCopyIsResumed) {
+    changeVersion(5);
+    createNotesTable();
+    Db::Client::create(testDbPath);
+    auto db = Db::Client::get();
+    db->createStatement("INSERT INTO notes (title, description, last_update_date) "
+                        "VALUES ('first', 'first', '2019-10-26T10:19:25Z'), "
+                        "('second', 'second', '2019-10-26T10:19:26Z')")->execute<void>();
+    // The first note was already copied by a migration which was interrupted.
+    db->createStatement("CREATE TABLE notes_epoch ("
+                        "id INTEGER PRIMARY KEY, "
+                        "title TEXT NOT NULL, "
+                        "description TEXT NOT NULL, "
+                        "last_update_date INTEGER NOT NULL"
+                        ")")->execute<void>();
+    db->createStatement("INSERT INTO notes_epoch (id, title, description, last_update_date) "
+                        "VALUES (1, 'first', 'first', 1572085165)")->execute<void>();
+    db = nullptr;
+    Db::Client::release();
+
+    NoteDb::initialize(testDbPath);
+
+    auto rows = Db::Client::get()->createStatement("SELECT rowid, title, last_update_date FROM notes ORDER BY rowid")->
+        execute<std::shared_ptr<Db::Cursor>>()->rows<int, std::string, long long>();
+    EXPECT_EQ((std::vector<std::tuple<int, std::string, long long>>({
+        std::make_tuple(1, std::string("first"), 1572085165LL),
+        std::make_tuple(2, std::string("second"), 1572085166LL)
+    })), rows);
+}
+
+TEST_F(NoteDatabaseInitializerTest, givenVersion5WithSubstringIndexWhenInitializeIsInvokedThenIndexIsKeptInSync) {
+    NoteDb::initialize(testDbPath);
+    Db::Client::release();
+    // Replace the table with the one of the version 5, keeping the substring index.
+    Db::Client::create(testDbPath);
+    auto db = Db::Client::get();
+    db->createStatement("DROP TABLE draft_log_checkpoint")->execute<void>();
+    db->createStatement("DROP TABLE notes")->execute<void>();
+    db->createStatement("CREATE TABLE notes ("
+                        "title TEXT NOT NULL, "
+                        "description TEXT NOT NULL, "
+                        "last_update_date TEXT NOT NULL"
+                        ")")->execute<void>();
+    db->createStatement("INSERT INTO notes (title, description, last_update_date) "
+                        "VALUES ('dummy-title', 'dummy-description', '2019-10-26T10:19:25Z')")->execute<void>();
+    db->createStatement("INSERT INTO notes_trigram (notes_trigram) VALUES ('rebuild')")->execute<void>();
+    db->createStatement("PRAGMA user_version = 5")->execute<void>();
+    db = nullptr;
+    Db::Client::release();
+
+    NoteDb::initialize(testDbPath);
+
+    db = Db::Client::get();
+    db->createStatement("INSERT INTO notes (title, description, last_update_date) "
+                        "VALUES ('other-title', 'other-description', 1572085166)")->execute<void>();
+    auto matches = db->createStatement("SELECT rowid FROM notes_trigram WHERE notes_trigram MATCH '\"title\"' "
+                                       "ORDER BY rowid")->execute<std::shared_ptr<Db::Cursor>>()->rows<int>();
+    EXPECT_EQ((std::vector<std::tuple<int>>({std::make_tuple(1), std::make_tuple(2)})), matches);
+}
+
+TEST_F(NoteDatabaseInitializerTest, givenVersion4WhenInitializeIsInvokedThenRecencyIndexIsCreated) {
+    changeVersion(4);
+    createNotesTable();
+
+    NoteDb::initialize(testDbPath);
+
+    auto db = Db::Client::get();
+    auto indexes = db->createStatement("SELECT COUNT(*) FROM sqlite_master "
+                                       "WHERE type = 'index' AND name = 'notes_last_update_date'")->execute<int>();
+    EXPECT_EQ(1, indexes);
+}
+
+TEST_F(NoteDatabaseInitializerTest, givenVersion6WhenInitializeIsInvokedThenDraftLogCheckpointTableIsCreated) {
+    changeVersion(6);
+    createNotesTable();
+
+    NoteDb::initialize(testDbPath);
+
+    auto db = Db::Client::get();
+    auto tables = db->createStatement("SELECT COUNT(*) FROM sqlite_master "
+                                      "WHERE type = 'table' AND name = 'draft_log_checkpoint'")->execute<int>();
+    EXPECT_EQ(1, tables);
+}
+
+TEST_F(NoteDatabaseInitializerTest, givenVersion5WithNotesWhenInitializeIsInvokedThenRowidsAreKeptAsIds) {
+    changeVersion(5);
+    createNotesTable();
+    Db::Client::create(testDbPath);
+    Db::Client::get()->createStatement("INSERT INTO notes (rowid, title, description, last_update_date) "
+                                       "VALUES (3, 'dummy-title', 'dummy-description', '2019-10-26T10:19:25Z')")->
+        execute<void>();
+    Db::Client::release();
+
+    NoteDb::initialize(testDbPath);
+
+    auto db = Db::Client::get();
+    EXPECT_EQ(1, db->createStatement("SELECT pk FROM pragma_table_info('notes') WHERE name = 'id'")->execute<int>());
+    EXPECT_EQ(3, db->createStatement("SELECT id FROM notes")->execute<int>());
+}
+
+TEST_F(NoteDatabaseInitializerTest, givenDeletedNotesWhenDatabaseIsVacuumedThenIdsAndIndexAreKept) {
+    NoteDb::initialize(testDbPath);
+    auto db = Db::Client::get();
+    db->createStatement("INSERT INTO notes (title, description, last_update_date) "
+                        "VALUES ('first', 'dummy', 1), ('second', 'dummy', 2), ('third', 'dummy', 3)")->execute<void>();
+    db->createStatement("DELETE FROM notes WHERE title = 'first'")->execute<void>();
+
+    db->createStatement("VACUUM")->execute<void>();
+
+    auto ids = db->createStatement("SELECT id FROM notes ORDER BY id")->
+        execute<std::shared_ptr<Db::Cursor>>()->rows<int>();
+    EXPECT_EQ((std::vector<std::tuple<int>>({std::make_tuple(2), std::make_tuple(3)})), ids);
+    auto matches = db->createStatement("SELECT notes.title FROM notes_trigram "
+                                       "JOIN notes ON notes.id = notes_trigram.rowid "
+                                       "WHERE notes_trigram MATCH '\"third\"'")->execute<stdx::optional<std::string>>();
+    EXPECT_EQ(std::string("third"), *matches);
+}
@@ -12,5 +12,7 @@ class NoteDatabaseInitializerTest : public ::testing::Test {
 
     static void changeVersion(int version);
 
+    static void createNotesTable();
+
     void TearDown() override;
 };
\ No newline at end of file
@@ -0,0 +1,29 @@
+#include <gtest/gtest.h>
+#include "core/include_macros.hpp"
+#include AMALGAMATION(note_match.hpp)
+
+TEST(NoteMatchTest, givenFieldsInConstructorWhenGettersAreInvokedThenFieldsAreReturned) {
+    auto match = NoteMatch(2, "dummy-title", "dummy-snippet", {{0, 5}}, {{6, 3}, {10, 3}}, 1572694125);
+
+    EXPECT_EQ(2, match.getId());
+    EXPECT_EQ("dummy-title", match.getTitle());
+    EXPECT_EQ("dummy-snippet", match.getSnippet());
+    EXPECT_EQ(std::vector<NoteMatch::Range>({{0, 5}}), match.getTitleMatches());
+    EXPECT_EQ(std::vector<NoteMatch::Range>({{6, 3}, {10, 3}}), match.getSnippetMatches());
+    EXPECT_EQ(1572694125, match.getLastUpdateTime());
+}
+
+TEST(NoteMatchTest, givenEqualFieldsWhenEqualityOperatorIsInvokedThenItReturnsTrue) {
+    ASSERT_TRUE(NoteMatch(1, "a", "b", {{0, 1}}, {}, 1572694125) == NoteMatch(1, "a", "b", {{0, 1}}, {}, 1572694125));
+}
+
+TEST(NoteMatchTest, givenDifferentFieldsWhenEqualityOperatorIsInvokedThenItReturnsFalse) {
+    auto match = NoteMatch(1, "a", "b", {{0, 1}}, {}, 1572694125);
+
+    EXPECT_FALSE(match == NoteMatch(2, "a", "b", {{0, 1}}, {}, 1572694125));
+    EXPECT_FALSE(match == NoteMatch(1, "c", "b", {{0, 1}}, {}, 1572694125));
+    EXPECT_FALSE(match == NoteMatch(1, "a", "c", {{0, 1}}, {}, 1572694125));
+    EXPECT_FALSE(match == NoteMatch(1, "a", "b", {{1, 1}}, {}, 1572694125));
+    EXPECT_FALSE(match == NoteMatch(1, "a", "b", {{0, 1}}, {{0, 1}}, 1572694125));
+    EXPECT_FALSE(match == NoteMatch(1, "a", "b", {{0, 1}}, {}, 1572694124));
+}
@@ -0,0 +1,23 @@
+#include <gtest/gtest.h>
+#include "core/include_macros.hpp"
+#include AMALGAMATION(note_summary.hpp)
+
+TEST(NoteSummaryTest, givenFieldsInConstructorWhenGettersAreInvokedThenFieldsAreReturned) {
+    auto summary = NoteSummary(2, "dummy-title", "dummy-snippet", 1572694125);
+
+    EXPECT_EQ(2, summary.getId());
+    EXPECT_EQ("dummy-title", summary.getTitle());
+    EXPECT_EQ("dummy-snippet", summary.getSnippet());
+    EXPECT_EQ(1572694125, summary.getLastUpdateTime());
+}
+
+TEST(NoteSummaryTest, givenEqualFieldsWhenEqualityOperatorIsInvokedThenItReturnsTrue) {
+    ASSERT_TRUE(NoteSummary(1, "a", "b", 1572694125) == NoteSummary(1, "a", "b", 1572694125));
+}
+
+TEST(NoteSummaryTest, givenDifferentFieldsWhenEqualityOperatorIsInvokedThenItReturnsFalse) {
+    EXPECT_FALSE(NoteSummary(1, "a", "b", 1572694125) == NoteSummary(2, "a", "b", 1572694125));
+    EXPECT_FALSE(NoteSummary(1, "a", "b", 1572694125) == NoteSummary(1, "c", "b", 1572694125));
+    EXPECT_FALSE(NoteSummary(1, "a", "b", 1572694125) == NoteSummary(1, "a", "c", 1572694125));
+    EXPECT_FALSE(NoteSummary(1, "a", "b", 1572694125) == NoteSummary(1, "a", "b", 1572694124));
+}
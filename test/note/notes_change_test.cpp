@@ -0,0 +1,21 @@
+#include <gtest/gtest.h>
+#include "core/include_macros.hpp"
+#include AMALGAMATION(notes_change.hpp)
+
+TEST(NotesChangeTest, givenIdsInConstructorWhenGettersAreInvokedThenIdsAreReturned) {
+    auto change = NotesChange({1, 2}, {3}, {4, 5});
+
+    EXPECT_EQ(std::vector<int>({1, 2}), change.getInsertedIds());
+    EXPECT_EQ(std::vector<int>({3}), change.getUpdatedIds());
+    EXPECT_EQ(std::vector<int>({4, 5}), change.getDeletedIds());
+}
+
+TEST(NotesChangeTest, givenEqualIdsWhenEqualityOperatorIsInvokedThenItReturnsTrue) {
+    ASSERT_TRUE(NotesChange({1}, {2}, {3}) == NotesChange({1}, {2}, {3}));
+}
+
+TEST(NotesChangeTest, givenDifferentIdsWhenEqualityOperatorIsInvokedThenItReturnsFalse) {
+    EXPECT_FALSE(NotesChange({1}, {2}, {3}) == NotesChange({4}, {2}, {3}));
+    EXPECT_FALSE(NotesChange({1}, {2}, {3}) == NotesChange({1}, {4}, {3}));
+    EXPECT_FALSE(NotesChange({1}, {2}, {3}) == NotesChange({1}, {2}, {4}));
+}
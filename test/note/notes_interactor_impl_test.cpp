@@ -3,6 +3,7 @@
 #include "note/notes_interactor_impl.hpp"
 #include "notes_interactor_impl_test.hpp"
 
+using ::testing::_;
 using ::testing::AtLeast;
 using ::testing::Return;
 
@@ -20,20 +21,26 @@ void NotesInteractorImplTest::TearDown() {
 
 TEST_F(NotesInteractorImplTest, givenDraftWhenInsertNoteIsInvokedThenNoteIsInsertedInRepositoryAndDraftIsDeleted) {
     auto draft = Draft("dummy-title", "dummy-description");
-    EXPECT_CALL(*notesRepository, insert(draft)).Times(1);
+    auto note = Note(4, "dummy-title", "dummy-description", 1572694125);
+    EXPECT_CALL(*notesRepository, insert(draft)).Times(1).WillOnce(Return(note));
     EXPECT_CALL(*draftsRepository, deleteNew()).Times(1);
 
-    interactor->insertNote(draft);
+    auto insertedNote = interactor->insertNote(draft);
+
+    EXPECT_EQ(note, insertedNote);
 }
 
 TEST_F(NotesInteractorImplTest,
        givenNoteIdAndDraftWhenUpdateNoteIsInvokedThenNoteIsUpdatedInRepositoryAndDraftIsDeleted) {
     int id = 3;
     auto draft = Draft("dummy-title", "dummy-description");
-    EXPECT_CALL(*notesRepository, update(id, draft)).Times(1);
+    auto note = Note(id, "dummy-title", "dummy-description", 1572694125);
+    EXPECT_CALL(*notesRepository, update(id, draft)).Times(1).WillOnce(Return(stdx::optional<Note>(note)));
     EXPECT_CALL(*draftsRepository, deleteExisting(id)).Times(1);
 
-    interactor->updateNote(id, draft);
+    auto updatedNote = interactor->updateNote(id, draft);
+
+    EXPECT_EQ(stdx::optional<Note>(note), updatedNote);
 }
 
 TEST_F(NotesInteractorImplTest, whenGetAllNotesIsInvokedThenRepositoryReturnsAllNotes) {
@@ -45,6 +52,44 @@ TEST_F(NotesInteractorImplTest, whenGetAllNotesIsInvokedThenRepositoryReturnsAll
     ASSERT_EQ(notes, interactor->getAllNotes());
 }
 
+TEST_F(NotesInteractorImplTest, givenKeyWhenGetNotesPageIsInvokedThenRepositoryReturnsPage) {
+    auto key = NotesPage::Key(1572694127, 3);
+    auto page = NotesPage({Note(2, "second-title", "second-description", 1572694126)},
+                          NotesPage::Key(1572694126, 2));
+    EXPECT_CALL(*notesRepository, getPage(1, stdx::optional<NotesPage::Key>(key))).Times(1).WillOnce(Return(page));
+
+    ASSERT_EQ(page, interactor->getNotesPage(1, key));
+}
+
+TEST_F(NotesInteractorImplTest, givenConsumerWhenForEachNoteIsInvokedThenRepositoryStreamsNotes) {
+    auto note = Note(1, "first-title", "first-description", 1572694125);
+    EXPECT_CALL(*notesRepository, forEach(_)).Times(1).WillOnce([&note](const std::function<void(Note)> &consumer) {
+        consumer(note);
+    });
+    std::vector<Note> notes;
+
+    interactor->forEachNote([&notes](Note streamedNote) {
+        notes.push_back(std::move(streamedNote));
+    });
+
+    ASSERT_EQ(std::vector<Note>({note}), notes);
+}
+
+TEST_F(NotesInteractorImplTest, whenGetNoteSummariesIsInvokedThenRepositoryReturnsSummaries) {
+    std::vector<NoteSummary> summaries;
+    summaries.emplace_back(1, "first-title", "first-snippet", 1572694125);
+    EXPECT_CALL(*notesRepository, getSummaries()).Times(1).WillOnce(Return(summaries));
+
+    ASSERT_EQ(summaries, interactor->getNoteSummaries());
+}
+
+TEST_F(NotesInteractorImplTest, givenIdWhenGetNoteByIdIsInvokedThenRepositoryReturnsNote) {
+    auto note = Note(1, "first-title", "first-description", 1572694125);
+    EXPECT_CALL(*notesRepository, getById(1)).Times(1).WillOnce(Return(note));
+
+    ASSERT_EQ(note, interactor->getNoteById(1));
+}
+
 TEST_F(NotesInteractorImplTest, givenTextFilterWhenGetNotesByTextIsInvokedThenRepositoryReturnsFilteredNotes) {
     std::string text = "filter";
     std::vector<Note> notes;
@@ -108,6 +153,30 @@ TEST_F(NotesInteractorImplTest,
     interactor->updateExistingDraftDescription(id, description);
 }
 
+TEST_F(NotesInteractorImplTest, givenTextWhenInsertInNewDraftDescriptionIsInvokedThenNewDraftIsEdited) {
+    EXPECT_CALL(*draftsRepository, insertInNewDescription(5, std::string("dummy"))).Times(1);
+
+    interactor->insertInNewDraftDescription(5, "dummy");
+}
+
+TEST_F(NotesInteractorImplTest, givenRangeWhenEraseFromNewDraftDescriptionIsInvokedThenNewDraftIsEdited) {
+    EXPECT_CALL(*draftsRepository, eraseFromNewDescription(5, 2)).Times(1);
+
+    interactor->eraseFromNewDraftDescription(5, 2);
+}
+
+TEST_F(NotesInteractorImplTest, givenTextWhenInsertInExistingDraftDescriptionIsInvokedThenExistingDraftIsEdited) {
+    EXPECT_CALL(*draftsRepository, insertInExistingDescription(3, 5, std::string("dummy"))).Times(1);
+
+    interactor->insertInExistingDraftDescription(3, 5, "dummy");
+}
+
+TEST_F(NotesInteractorImplTest, givenRangeWhenEraseFromExistingDraftDescriptionIsInvokedThenExistingDraftIsEdited) {
+    EXPECT_CALL(*draftsRepository, eraseFromExistingDescription(3, 5, 2)).Times(1);
+
+    interactor->eraseFromExistingDraftDescription(3, 5, 2);
+}
+
 TEST_F(NotesInteractorImplTest, givenNoteIdWhenDeleteNoteIsInvokedThenRepositoryDeletesNoteAndDraft) {
     int id = 3;
     EXPECT_CALL(*notesRepository, deleteWithId(id)).Times(1);
@@ -134,3 +203,27 @@ TEST_F(NotesInteractorImplTest, whenPersistChangesIsInvokedThenChangesArePersist
 
     interactor->persistChanges();
 }
+
+TEST_F(NotesInteractorImplTest, givenTextAndLimitWhenGetNotesByTextIsInvokedThenRepositoryReturnsRankedNotes) {
+    std::string text = "filter";
+    std::vector<NoteMatch> matches;
+    matches.emplace_back(2, "second-filter", "second-description", std::vector<NoteMatch::Range>{{7, 6}},
+                         std::vector<NoteMatch::Range>{}, 1572694126);
+    EXPECT_CALL(*notesRepository, getRankedByText(text, 10)).Times(1).WillOnce(Return(matches));
+
+    ASSERT_EQ(matches, interactor->getNotesByText(text, 10));
+}
+
+TEST_F(NotesInteractorImplTest, givenListenerWhenSubscribeIsInvokedThenRepositorySubscribesListener) {
+    EXPECT_CALL(*notesRepository, subscribe(_)).Times(1).WillOnce(Return(3));
+
+    auto subscriptionId = interactor->subscribe([](const NotesChange &) {});
+
+    EXPECT_EQ(3, subscriptionId);
+}
+
+TEST_F(NotesInteractorImplTest, givenSubscriptionIdWhenUnsubscribeIsInvokedThenRepositoryUnsubscribesListener) {
+    EXPECT_CALL(*notesRepository, unsubscribe(3)).Times(1);
+
+    interactor->unsubscribe(3);
+}
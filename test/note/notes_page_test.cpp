@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+#include "core/include_macros.hpp"
+#include AMALGAMATION(notes_page.hpp)
+
+TEST(NotesPageTest, givenFieldsInKeyConstructorWhenGettersAreInvokedThenFieldsAreReturned) {
+    auto key = NotesPage::Key(1572694125, 2);
+
+    EXPECT_EQ(1572694125, key.getLastUpdateTime());
+    EXPECT_EQ(2, key.getId());
+}
+
+TEST(NotesPageTest, givenKeysWhenEqualityOperatorIsInvokedThenFieldsAreCompared) {
+    EXPECT_TRUE(NotesPage::Key(1572694125, 2) == NotesPage::Key(1572694125, 2));
+    EXPECT_FALSE(NotesPage::Key(1572694125, 2) == NotesPage::Key(1572694124, 2));
+    EXPECT_FALSE(NotesPage::Key(1572694125, 2) == NotesPage::Key(1572694125, 3));
+}
+
+TEST(NotesPageTest, givenFieldsInConstructorWhenGettersAreInvokedThenFieldsAreReturned) {
+    std::vector<Note> notes = {Note(2, "dummy-title", "dummy-description", 1572694125)};
+    auto page = NotesPage(notes, NotesPage::Key(1572694125, 2));
+
+    EXPECT_EQ(notes, page.getNotes());
+    ASSERT_TRUE(page.getNextKey());
+    EXPECT_EQ(NotesPage::Key(1572694125, 2), *page.getNextKey());
+}
+
+TEST(NotesPageTest, givenPagesWhenEqualityOperatorIsInvokedThenFieldsAreCompared) {
+    std::vector<Note> notes = {Note(2, "dummy-title", "dummy-description", 1572694125)};
+    auto page = NotesPage(notes, NotesPage::Key(1572694125, 2));
+
+    EXPECT_TRUE(page == NotesPage(notes, NotesPage::Key(1572694125, 2)));
+    EXPECT_FALSE(page == NotesPage({}, NotesPage::Key(1572694125, 2)));
+    EXPECT_FALSE(page == NotesPage(notes, NotesPage::Key(1572694125, 3)));
+    EXPECT_FALSE(page == NotesPage(notes, stdx::nullopt));
+}
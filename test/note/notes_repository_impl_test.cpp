@@ -1,5 +1,9 @@
+#include <set>
+#include <stdexcept>
+#include <thread>
 #include "core/include_macros.hpp"
 #include "notes_repository_impl_test.hpp"
+#include "database/sqlite_database.hpp"
 #include AMALGAMATION(database_client.hpp)
 #include AMALGAMATION(note_database_initializer.hpp)
 
@@ -89,6 +93,32 @@ TEST_F(NotesRepositoryImplTest, givenExistentIdWhenUpdateIsInvokedThenNoteIsUpda
     ASSERT_FALSE(cursor->next());
 }
 
+TEST_F(NotesRepositoryImplTest, givenDraftWhenInsertIsInvokedThenInsertedNoteIsReturned) {
+    EXPECT_CALL(*clock, currentTimeSeconds()).WillOnce(Return(1572085165));
+
+    auto note = repository->insert(Draft("dummy-title", "dummy-description"));
+
+    EXPECT_EQ(Note(getLastRowId(), "dummy-title", "dummy-description", 1572085165), note);
+}
+
+TEST_F(NotesRepositoryImplTest, givenExistentIdWhenUpdateIsInvokedThenUpdatedNoteIsReturned) {
+    EXPECT_CALL(*clock, currentTimeSeconds())
+        .WillOnce(Return(1572085165))
+        .WillOnce(Return(1572085166));
+    auto insertedNote = repository->insert(Draft("dummy-title", "dummy-description"));
+
+    auto note = repository->update(insertedNote.getId(), Draft("updated-title", "updated-description"));
+
+    EXPECT_EQ(Note(insertedNote.getId(), "updated-title", "updated-description", 1572085166), note);
+}
+
+TEST_F(NotesRepositoryImplTest, givenInexistentIdWhenUpdateIsInvokedThenNothingIsReturned) {
+    auto note = repository->update(5, Draft("updated-title", "updated-description"));
+
+    EXPECT_FALSE(note);
+    EXPECT_EQ(0, getNotesCount());
+}
+
 TEST_F(NotesRepositoryImplTest, givenZeroInsertedNotesWhenDeleteAllIsInvokedThenNoNotesAreDeleted) {
     repository->deleteAll();
 
@@ -130,6 +160,146 @@ TEST_F(NotesRepositoryImplTest, givenMultipleNotesWhenGetAllIsInvokedThenListCon
     EXPECT_EQ(Note(secondId, secondDraft.getTitle(), secondDraft.getDescription(), 1572085166), notes[1]);
 }
 
+TEST_F(NotesRepositoryImplTest, givenZeroNotesWhenGetPageIsInvokedThenLastEmptyPageIsReturned) {
+    auto page = repository->getPage(10, stdx::nullopt);
+
+    EXPECT_EQ(NotesPage({}, stdx::nullopt), page);
+}
+
+TEST_F(NotesRepositoryImplTest, givenMultipleNotesWhenGetPageIsInvokedThenPagesFollowRecencyAndRowId) {
+    EXPECT_CALL(*clock, currentTimeSeconds())
+        .WillOnce(Return(1572085166))
+        .WillOnce(Return(1572085165))
+        .WillOnce(Return(1572085166))
+        .WillOnce(Return(1572085167))
+        .WillOnce(Return(1572085164));
+    std::vector<int> ids;
+    for (int i = 0; i < 5; i++) {
+        repository->insert(Draft("title-" + std::to_string(i), "description-" + std::to_string(i)));
+        ids.push_back(getLastRowId());
+    }
+
+    auto firstPage = repository->getPage(2, stdx::nullopt);
+    ASSERT_TRUE(firstPage.getNextKey());
+    auto secondPage = repository->getPage(2, firstPage.getNextKey());
+    ASSERT_TRUE(secondPage.getNextKey());
+    auto thirdPage = repository->getPage(2, secondPage.getNextKey());
+
+    // The notes updated in the same second are sorted from the highest rowid.
+    EXPECT_EQ(std::vector<Note>({
+        Note(ids[3], "title-3", "description-3", 1572085167),
+        Note(ids[2], "title-2", "description-2", 1572085166)
+    }), firstPage.getNotes());
+    EXPECT_EQ(NotesPage::Key(1572085166, ids[2]), *firstPage.getNextKey());
+    EXPECT_EQ(std::vector<Note>({
+        Note(ids[0], "title-0", "description-0", 1572085166),
+        Note(ids[1], "title-1", "description-1", 1572085165)
+    }), secondPage.getNotes());
+    EXPECT_EQ(NotesPage(std::vector<Note>({
+        Note(ids[4], "title-4", "description-4", 1572085164)
+    }), stdx::nullopt), thirdPage);
+}
+
+TEST_F(NotesRepositoryImplTest, givenPageSizeEqualToNotesWhenGetPageIsInvokedThenLastPageIsReturned) {
+    EXPECT_CALL(*clock, currentTimeSeconds()).WillRepeatedly(Return(1572085165));
+    repository->insert(Draft("first", "first"));
+    repository->insert(Draft("second", "second"));
+
+    auto page = repository->getPage(2, stdx::nullopt);
+
+    EXPECT_EQ(2, page.getNotes().size());
+    EXPECT_FALSE(page.getNextKey());
+}
+
+TEST_F(NotesRepositoryImplTest, givenZeroSizeWhenGetPageIsInvokedThenEmptyPageKeepsKey) {
+    EXPECT_CALL(*clock, currentTimeSeconds()).WillRepeatedly(Return(1572085165));
+    repository->insert(Draft("first", "first"));
+    auto key = NotesPage::Key(1572085166, 1);
+
+    EXPECT_EQ(NotesPage({}, key), repository->getPage(0, key));
+}
+
+TEST_F(NotesRepositoryImplTest, givenKeyWhenGetPageQueryIsPlannedThenIndexIsScannedWithoutSorting) {
+    auto cursor = db->createStatement(
+        "EXPLAIN QUERY PLAN "
+        "SELECT rowid, title, description, last_update_date "
+        "FROM notes "
+        "WHERE (last_update_date, rowid) < (1572085165, 1) "
+        "ORDER BY last_update_date DESC, rowid DESC "
+        "LIMIT 10"
+    )->execute<std::shared_ptr<Db::Cursor>>();
+    std::string plan;
+    cursor->forEachRow<int, int, int, std::string>([&plan](int, int, int, std::string detail) {
+        plan += detail + "\n";
+    });
+
+    EXPECT_NE(std::string::npos, plan.find("USING INDEX notes_last_update_date (last_update_date<?)")) << plan;
+    EXPECT_EQ(std::string::npos, plan.find("TEMP B-TREE")) << plan;
+}
+
+TEST_F(NotesRepositoryImplTest, givenMultipleNotesWhenForEachIsInvokedThenNotesAreStreamedByRecency) {
+    EXPECT_CALL(*clock, currentTimeSeconds())
+        .WillOnce(Return(1572085165))
+        .WillOnce(Return(1572085166));
+    repository->insert(Draft("first", "first-description"));
+    int firstId = getLastRowId();
+    repository->insert(Draft("second", "second-description"));
+    int secondId = getLastRowId();
+    std::vector<Note> notes;
+
+    repository->forEach([&notes](Note note) {
+        notes.push_back(std::move(note));
+    });
+
+    EXPECT_EQ(std::vector<Note>({
+        Note(secondId, "second", "second-description", 1572085166),
+        Note(firstId, "first", "first-description", 1572085165)
+    }), notes);
+}
+
+TEST_F(NotesRepositoryImplTest, givenNotesWhenGetSummariesIsInvokedThenFirstLinesAreReturnedByRecency) {
+    EXPECT_CALL(*clock, currentTimeSeconds())
+        .WillOnce(Return(1572085165))
+        .WillOnce(Return(1572085167))
+        .WillOnce(Return(1572085166))
+        .WillOnce(Return(1572085164));
+    repository->insert(Draft("single line", "the only line"));
+    int singleLineId = getLastRowId();
+    repository->insert(Draft("multiple lines", "first line\nsecond line"));
+    int multipleLinesId = getLastRowId();
+    repository->insert(Draft("long line", std::string(30, 'a') + "è" + std::string(100, 'b')));
+    int longLineId = getLastRowId();
+    repository->insert(Draft("empty first line", "\nsecond line"));
+    int emptyFirstLineId = getLastRowId();
+
+    auto summaries = repository->getSummaries();
+
+    EXPECT_EQ(std::vector<NoteSummary>({
+        NoteSummary(multipleLinesId, "multiple lines", "first line", 1572085167),
+        // The snippet is truncated to 80 characters, not bytes.
+        NoteSummary(longLineId, "long line", std::string(30, 'a') + "è" + std::string(49, 'b'), 1572085166),
+        NoteSummary(singleLineId, "single line", "the only line", 1572085165),
+        NoteSummary(emptyFirstLineId, "empty first line", "", 1572085164)
+    }), summaries);
+}
+
+TEST_F(NotesRepositoryImplTest, givenExistentIdWhenGetByIdIsInvokedThenWholeNoteIsReturned) {
+    EXPECT_CALL(*clock, currentTimeSeconds()).WillRepeatedly(Return(1572085165));
+    auto description = "first line\n" + std::string(1000, 'a');
+    repository->insert(Draft("dummy-title", description));
+    int id = getLastRowId();
+    repository->insert(Draft("other-title", "other-description"));
+
+    auto note = repository->getById(id);
+
+    ASSERT_TRUE(note);
+    EXPECT_EQ(Note(id, "dummy-title", description, 1572085165), *note);
+}
+
+TEST_F(NotesRepositoryImplTest, givenInexistentIdWhenGetByIdIsInvokedThenEmptyOptionalIsReturned) {
+    EXPECT_FALSE(repository->getById(1));
+}
+
 TEST_F(NotesRepositoryImplTest, givenZeroNotesWhenGetByTextIsInvokedThenEmptyListIsReturned) {
     auto notes = repository->getByText("dummy-text");
 
@@ -187,4 +357,484 @@ TEST_F(NotesRepositoryImplTest, givenZeroNotesMatchingFilterWhenGetByTextIsInvok
     auto notes = repository->getByText("fifth");
 
     ASSERT_TRUE(notes.empty());
-}
\ No newline at end of file
+}
+
+TEST_F(NotesRepositoryImplTest, givenTextInsideWordsWhenGetByTextIsInvokedThenNotesContainingTextAreReturned) {
+    EXPECT_CALL(*clock, currentTimeSeconds()).WillRepeatedly(Return(1572085165));
+    repository->insert(Draft("shopping list", "buy some milk"));
+    int firstId = getLastRowId();
+    repository->insert(Draft("shopping", "buy a new phone"));
+
+    // The text spans two words and its case doesn't match the note.
+    auto notes = repository->getByText("ME MIL");
+
+    ASSERT_EQ(1, notes.size());
+    EXPECT_EQ(firstId, notes[0].getId());
+}
+
+TEST_F(NotesRepositoryImplTest, givenMultibyteTextWhenGetByTextIsInvokedThenNotesContainingTextAreReturned) {
+    EXPECT_CALL(*clock, currentTimeSeconds()).WillRepeatedly(Return(1572085165));
+    repository->insert(Draft("caffè latte", "città"));
+    int firstId = getLastRowId();
+    repository->insert(Draft("caffe latte", "citta"));
+
+    auto longNotes = repository->getByText("ffè l");
+    auto shortNotes = repository->getByText("tà");
+
+    ASSERT_EQ(1, longNotes.size());
+    EXPECT_EQ(firstId, longNotes[0].getId());
+    ASSERT_EQ(1, shortNotes.size());
+    EXPECT_EQ(firstId, shortNotes[0].getId());
+}
+
+TEST_F(NotesRepositoryImplTest, givenTextWithFullTextSyntaxWhenGetByTextIsInvokedThenItIsMatchedLiterally) {
+    EXPECT_CALL(*clock, currentTimeSeconds()).WillRepeatedly(Return(1572085165));
+    repository->insert(Draft("it's a \"quoted\" title", "a description with OR and NOT*"));
+    int id = getLastRowId();
+    repository->insert(Draft("quoted", "OR NOT"));
+
+    auto quotedNotes = repository->getByText("\"quoted\"");
+    auto operatorNotes = repository->getByText("OR and NOT*");
+
+    ASSERT_EQ(1, quotedNotes.size());
+    EXPECT_EQ(id, quotedNotes[0].getId());
+    ASSERT_EQ(1, operatorNotes.size());
+    EXPECT_EQ(id, operatorNotes[0].getId());
+}
+
+TEST_F(NotesRepositoryImplTest, givenShortTextWithWildcardsWhenGetByTextIsInvokedThenItIsMatchedLiterally) {
+    EXPECT_CALL(*clock, currentTimeSeconds()).WillRepeatedly(Return(1572085165));
+    repository->insert(Draft("discount", "50% off"));
+    int id = getLastRowId();
+    repository->insert(Draft("snake_case", "a_b"));
+
+    auto percentNotes = repository->getByText("0%");
+    auto underscoreNotes = repository->getByText("_");
+
+    ASSERT_EQ(1, percentNotes.size());
+    EXPECT_EQ(id, percentNotes[0].getId());
+    EXPECT_EQ(1, underscoreNotes.size());
+    EXPECT_NE(id, underscoreNotes[0].getId());
+}
+
+TEST_F(NotesRepositoryImplTest, givenEmptyTextWhenGetByTextIsInvokedThenAllNotesAreReturned) {
+    EXPECT_CALL(*clock, currentTimeSeconds()).WillRepeatedly(Return(1572085165));
+    repository->insert(Draft("first", "second"));
+    repository->insert(Draft("third", "fourth"));
+
+    auto notes = repository->getByText("");
+
+    EXPECT_EQ(2, notes.size());
+}
+
+TEST_F(NotesRepositoryImplTest, givenUpdatedAndDeletedNotesWhenGetByTextIsInvokedThenIndexIsInSync) {
+    EXPECT_CALL(*clock, currentTimeSeconds()).WillRepeatedly(Return(1572085165));
+    repository->insert(Draft("first", "second"));
+    int firstId = getLastRowId();
+    repository->insert(Draft("third", "fourth"));
+    int secondId = getLastRowId();
+
+    repository->update(firstId, Draft("fifth", "sixth"));
+    repository->deleteWithId(secondId);
+
+    EXPECT_TRUE(repository->getByText("irs").empty());
+    EXPECT_TRUE(repository->getByText("hir").empty());
+    auto notes = repository->getByText("ift");
+    ASSERT_EQ(1, notes.size());
+    EXPECT_EQ(firstId, notes[0].getId());
+
+    repository->deleteAll();
+
+    EXPECT_TRUE(repository->getByText("ift").empty());
+    EXPECT_EQ(0, db->createStatement("SELECT COUNT(*) FROM notes_trigram")->execute<int>());
+}
+
+TEST_F(NotesRepositoryImplTest, givenMatchingNotesWhenGetRankedByTextIsInvokedThenMostRelevantNotesAreFirst) {
+    EXPECT_CALL(*clock, currentTimeSeconds()).WillRepeatedly(Return(1572085165));
+    repository->insert(Draft("groceries", "a long description which mentions the milk only once, among many words"));
+    int rareId = getLastRowId();
+    repository->insert(Draft("milk", "milk and more milk"));
+    int frequentId = getLastRowId();
+    repository->insert(Draft("unrelated", "nothing to see here"));
+
+    auto matches = repository->getRankedByText("milk", 10);
+
+    ASSERT_EQ(2, matches.size());
+    EXPECT_EQ(frequentId, matches[0].getId());
+    EXPECT_EQ(rareId, matches[1].getId());
+}
+
+TEST_F(NotesRepositoryImplTest, givenEquallyRelevantNotesWhenGetRankedByTextIsInvokedThenRecentNotesAreFirst) {
+    EXPECT_CALL(*clock, currentTimeSeconds())
+        .WillOnce(Return(1572085165 - 86400 * 365))
+        .WillOnce(Return(1572085165 - 86400))
+        .WillRepeatedly(Return(1572085165));
+    repository->insert(Draft("old note", "same text"));
+    int oldId = getLastRowId();
+    repository->insert(Draft("new note", "same text"));
+    int newId = getLastRowId();
+
+    auto matches = repository->getRankedByText("note", 10);
+
+    ASSERT_EQ(2, matches.size());
+    EXPECT_EQ(newId, matches[0].getId());
+    EXPECT_EQ(oldId, matches[1].getId());
+}
+
+TEST_F(NotesRepositoryImplTest, givenLimitWhenGetRankedByTextIsInvokedThenAtMostLimitNotesAreReturned) {
+    EXPECT_CALL(*clock, currentTimeSeconds()).WillRepeatedly(Return(1572085165));
+    for (int i = 0; i < 5; i++) {
+        repository->insert(Draft("note " + std::to_string(i), "description"));
+    }
+
+    EXPECT_EQ(3, repository->getRankedByText("note", 3).size());
+    EXPECT_EQ(3, repository->getRankedByText("e", 3).size());
+    EXPECT_TRUE(repository->getRankedByText("note", 0).empty());
+}
+
+TEST_F(NotesRepositoryImplTest, givenLongDescriptionWhenGetRankedByTextIsInvokedThenBoundedSnippetIsReturned) {
+    EXPECT_CALL(*clock, currentTimeSeconds()).WillRepeatedly(Return(1572085165));
+    auto description = std::string(200, 'a') + " the Needle and the needle " + std::string(200, 'b');
+    repository->insert(Draft("needle in the title", description));
+    int id = getLastRowId();
+
+    auto matches = repository->getRankedByText("NEEDLE", 10);
+
+    ASSERT_EQ(1, matches.size());
+    auto expectedSnippet = description.substr(description.find("Needle") - 20, 80);
+    EXPECT_EQ(NoteMatch(id,
+                        "needle in the title",
+                        expectedSnippet,
+                        {{0, 6}},
+                        {{20, 6}, {35, 6}},
+                        1572085165), matches[0]);
+}
+
+TEST_F(NotesRepositoryImplTest, givenTextOnlyInTitleWhenGetRankedByTextIsInvokedThenSnippetIsDescriptionStart) {
+    EXPECT_CALL(*clock, currentTimeSeconds()).WillRepeatedly(Return(1572085165));
+    auto description = std::string(100, 'a');
+    repository->insert(Draft("shopping list", description));
+    int id = getLastRowId();
+
+    auto matches = repository->getRankedByText("list", 10);
+    auto shortMatches = repository->getRankedByText("li", 10);
+
+    ASSERT_EQ(1, matches.size());
+    EXPECT_EQ(NoteMatch(id, "shopping list", std::string(80, 'a'), {{9, 4}}, {}, 1572085165), matches[0]);
+    ASSERT_EQ(1, shortMatches.size());
+    EXPECT_EQ(NoteMatch(id, "shopping list", std::string(80, 'a'), {{9, 2}}, {}, 1572085165), shortMatches[0]);
+}
+
+TEST_F(NotesRepositoryImplTest, givenMultibyteDescriptionWhenGetRankedByTextIsInvokedThenSnippetIsNotCutInCharacters) {
+    EXPECT_CALL(*clock, currentTimeSeconds()).WillRepeatedly(Return(1572085165));
+    std::string description;
+    for (int i = 0; i < 30; i++) {
+        description += "è";
+    }
+    description += "target";
+    repository->insert(Draft("title", description));
+
+    auto matches = repository->getRankedByText("target", 10);
+
+    ASSERT_EQ(1, matches.size());
+    // The snippet starts 20 characters, so 40 bytes, before the text.
+    EXPECT_EQ(description.substr(20), matches[0].getSnippet());
+    EXPECT_EQ(std::vector<NoteMatch::Range>({{40, 6}}), matches[0].getSnippetMatches());
+}
+
+TEST_F(NotesRepositoryImplTest, givenMultibytePrefixWhenGetRankedByTextIsInvokedThenMatchesAreBytesOfSnippet) {
+    EXPECT_CALL(*clock, currentTimeSeconds()).WillRepeatedly(Return(1572085165));
+    // Every character of the prefix takes 3 bytes.
+    std::string prefix;
+    for (int i = 0; i < 25; i++) {
+        prefix += "日";
+    }
+    repository->insert(Draft("日本 Target", prefix + " Target and target"));
+
+    auto matches = repository->getRankedByText("target", 10);
+
+    ASSERT_EQ(1, matches.size());
+    // The snippet starts 20 characters before the text, the space and 19 characters of the prefix, so 58 bytes.
+    auto snippet = matches[0].getSnippet();
+    EXPECT_EQ(prefix.substr(18) + " Target and target", snippet);
+    EXPECT_EQ(std::vector<NoteMatch::Range>({{58, 6}, {69, 6}}), matches[0].getSnippetMatches());
+    EXPECT_EQ("Target", snippet.substr(58, 6));
+    EXPECT_EQ("target", snippet.substr(69, 6));
+    EXPECT_EQ(std::vector<NoteMatch::Range>({{7, 6}}), matches[0].getTitleMatches());
+}
+
+TEST_F(NotesRepositoryImplTest, givenShortTextWhenGetRankedByTextIsInvokedThenNotesAreRankedByRecency) {
+    EXPECT_CALL(*clock, currentTimeSeconds())
+        .WillOnce(Return(1572085166))
+        .WillOnce(Return(1572085165))
+        .WillRepeatedly(Return(1572085167));
+    repository->insert(Draft("ab", "first"));
+    int firstId = getLastRowId();
+    repository->insert(Draft("ab", "second"));
+    int secondId = getLastRowId();
+    repository->insert(Draft("cd", "third"));
+
+    auto matches = repository->getRankedByText("AB", 10);
+
+    ASSERT_EQ(2, matches.size());
+    EXPECT_EQ(firstId, matches[0].getId());
+    EXPECT_EQ(secondId, matches[1].getId());
+}
+
+TEST_F(NotesRepositoryImplTest, givenCacheWhenGetAllIsInvokedTwiceThenNotesAreReadFromCache) {
+    EXPECT_CALL(*clock, currentTimeSeconds()).WillRepeatedly(Return(1572085165));
+    repository = std::make_shared<NotesRepositoryImpl>(db, clock, 1024 * 1024);
+    repository->insert(Draft("first-title", "first-description"));
+
+    auto firstNotes = repository->getAll();
+    auto secondNotes = repository->getAll();
+
+    EXPECT_EQ(firstNotes, secondNotes);
+    ASSERT_EQ(1, secondNotes.size());
+    auto stats = repository->getCacheStats();
+    ASSERT_TRUE(stats);
+    EXPECT_EQ(1, stats->hits);
+    EXPECT_EQ(1, stats->misses);
+    EXPECT_DOUBLE_EQ(0.5, stats->hitRatio());
+    EXPECT_LT(0, stats->bytes);
+    EXPECT_EQ(1024 * 1024, stats->budget);
+}
+
+TEST_F(NotesRepositoryImplTest, givenCacheWhenNotesAreChangedThenCachedNotesAreKeptInSync) {
+    EXPECT_CALL(*clock, currentTimeSeconds()).WillRepeatedly(Return(1572085165));
+    repository = std::make_shared<NotesRepositoryImpl>(db, clock, 1024 * 1024);
+    repository->insert(Draft("first-title", "first-description"));
+    int firstId = getLastRowId();
+    repository->insert(Draft("second-title", "second-description"));
+    int secondId = getLastRowId();
+    // Load the cache.
+    repository->getAll();
+
+    repository->insert(Draft("third-title", "third-description"));
+    int thirdId = getLastRowId();
+    repository->update(firstId, Draft("updated-title", "updated-description"));
+    repository->deleteWithId(secondId);
+
+    auto expectedNotes = std::vector<Note>({
+        Note(firstId, "updated-title", "updated-description", 1572085165),
+        Note(thirdId, "third-title", "third-description", 1572085165)
+    });
+    EXPECT_EQ(expectedNotes, repository->getAll());
+    EXPECT_EQ(std::vector<Note>({expectedNotes[1]}), repository->getByText("third"));
+    repository->deleteAll();
+    EXPECT_TRUE(repository->getAll().empty());
+    // All the reads after the first one were served by the cache.
+    EXPECT_EQ(3, repository->getCacheStats()->hits);
+    EXPECT_EQ(1, repository->getCacheStats()->misses);
+}
+
+TEST_F(NotesRepositoryImplTest, givenCacheWhenGetByTextIsInvokedThenCachedNotesContainingTextAreReturned) {
+    EXPECT_CALL(*clock, currentTimeSeconds()).WillRepeatedly(Return(1572085165));
+    repository = std::make_shared<NotesRepositoryImpl>(db, clock, 1024 * 1024);
+    repository->insert(Draft("dummy-title", "first"));
+    int firstId = getLastRowId();
+    repository->insert(Draft("other", "ab"));
+    int secondId = getLastRowId();
+    repository->insert(Draft("dummy-title", "third"));
+    int thirdId = getLastRowId();
+    repository->getAll();
+
+    auto longTextNotes = repository->getByText("DUMMY");
+    auto shortTextNotes = repository->getByText("b");
+
+    EXPECT_EQ(std::vector<Note>({
+        Note(firstId, "dummy-title", "first", 1572085165),
+        Note(thirdId, "dummy-title", "third", 1572085165)
+    }), longTextNotes);
+    EXPECT_EQ(std::vector<Note>({Note(secondId, "other", "ab", 1572085165)}), shortTextNotes);
+    EXPECT_EQ(2, repository->getCacheStats()->hits);
+}
+
+TEST_F(NotesRepositoryImplTest, givenCacheWhenAnotherConnectionChangesNotesThenCacheIsInvalidated) {
+    const std::string dbPath = "notes_repository_impl_test.db";
+    EXPECT_CALL(*clock, currentTimeSeconds()).WillRepeatedly(Return(1572085165));
+    db = nullptr;
+    Db::Client::release();
+    NoteDb::initialize(dbPath);
+    db = Db::Client::get();
+    repository = std::make_shared<NotesRepositoryImpl>(db, clock, 1024 * 1024);
+    repository->insert(Draft("first-title", "first-description"));
+    repository->getAll();
+    {
+        auto otherDb = Db::Sql::Database(dbPath, SQLITE_OPEN_READWRITE);
+        otherDb.createStatement("INSERT INTO notes (title, description, last_update_date) "
+                                "VALUES ('second-title', 'second-description', 1572085166)")->execute<void>();
+    }
+
+    auto notes = repository->getAll();
+
+    ASSERT_EQ(2, notes.size());
+    EXPECT_EQ("second-title", notes[1].getTitle());
+    EXPECT_EQ(1, repository->getCacheStats()->invalidations);
+    EXPECT_EQ(2, repository->getCacheStats()->misses);
+    repository = nullptr;
+    db = nullptr;
+    Db::Client::release();
+    std::remove(dbPath.c_str());
+}
+
+TEST_F(NotesRepositoryImplTest, givenCacheWhenTransactionChangingNotesIsRolledBackThenCacheIsNotChanged) {
+    EXPECT_CALL(*clock, currentTimeSeconds()).WillRepeatedly(Return(1572085165));
+    repository = std::make_shared<NotesRepositoryImpl>(db, clock, 1024 * 1024);
+    repository->insert(Draft("first-title", "first-description"));
+    int firstId = getLastRowId();
+    repository->insert(Draft("second-title", "second-description"));
+    int secondId = getLastRowId();
+    // Load the cache.
+    auto expectedNotes = repository->getAll();
+
+    EXPECT_THROW(db->executeTransaction([&] {
+        repository->insert(Draft("third-title", "third-description"));
+        repository->update(firstId, Draft("updated-title", "updated-description"));
+        repository->deleteWithId(secondId);
+        throw std::runtime_error("dummy-error");
+    }), std::runtime_error);
+    EXPECT_THROW(db->executeTransaction([&] {
+        repository->deleteAll();
+        throw std::runtime_error("dummy-error");
+    }), std::runtime_error);
+
+    EXPECT_EQ(expectedNotes, repository->getAll());
+    EXPECT_EQ(std::vector<Note>({expectedNotes[1]}), repository->getByText("second"));
+    EXPECT_EQ(2, repository->getCacheStats()->hits);
+}
+
+TEST_F(NotesRepositoryImplTest, givenCacheWhenNotesAreChangedInTransactionThenTheyAreReadUntilItIsCommitted) {
+    EXPECT_CALL(*clock, currentTimeSeconds()).WillRepeatedly(Return(1572085165));
+    repository = std::make_shared<NotesRepositoryImpl>(db, clock, 1024 * 1024);
+    repository->insert(Draft("first-title", "first-description"));
+    // Load the cache.
+    repository->getAll();
+
+    db->executeTransaction([&] {
+        repository->insert(Draft("second-title", "second-description"));
+        // The transaction reads its own changes, which aren't cached yet.
+        EXPECT_EQ(2, repository->getAll().size());
+        EXPECT_EQ(1, repository->getByText("second").size());
+    });
+
+    EXPECT_EQ(2, repository->getAll().size());
+    // Only the read after the commit was served by the cache.
+    EXPECT_EQ(1, repository->getCacheStats()->hits);
+}
+
+TEST_F(NotesRepositoryImplTest, givenWriterThreadWhenNotesAreInsertedConcurrentlyThenTheyAreWrittenByIt) {
+    repository = nullptr;
+    db = nullptr;
+    Db::Client::release();
+    auto options = Db::Options();
+    options.writerThread = true;
+    NoteDb::initialize(":memory:", options);
+    db = Db::Client::get();
+    EXPECT_CALL(*clock, currentTimeSeconds()).WillRepeatedly(Return(1572085165));
+    repository = std::make_shared<NotesRepositoryImpl>(db, clock, 1024 * 1024);
+    // Load the cache.
+    repository->getAll();
+
+    std::vector<std::thread> callers;
+    std::vector<std::vector<int>> ids(4);
+    for (size_t caller = 0; caller < ids.size(); caller++) {
+        callers.emplace_back([this, &ids, caller] {
+            for (int i = 0; i < 10; i++) {
+                ids[caller].push_back(repository->insert(Draft("dummy-title", "dummy-description")).getId());
+            }
+        });
+    }
+    for (auto &caller : callers) {
+        caller.join();
+    }
+
+    std::set<int> distinctIds;
+    for (const auto &callerIds : ids) {
+        distinctIds.insert(callerIds.begin(), callerIds.end());
+    }
+    EXPECT_EQ(40, distinctIds.size());
+    EXPECT_EQ(40, getNotesCount());
+    // The cache was changed by the writer thread after each commit.
+    EXPECT_EQ(40, repository->getAll().size());
+    EXPECT_EQ(1, repository->getCacheStats()->hits);
+    auto sqlDb = std::dynamic_pointer_cast<Db::Sql::Database>(db);
+    EXPECT_EQ(40, sqlDb->writeExecutorStats().transactions);
+}
+
+TEST_F(NotesRepositoryImplTest, givenNoCacheWhenGetCacheStatsIsInvokedThenNothingIsReturned) {
+    EXPECT_FALSE(repository->getCacheStats());
+}
+
+TEST_F(NotesRepositoryImplTest, givenSubscribedListenerWhenNotesAreChangedThenChangedIdsAreNotified) {
+    EXPECT_CALL(*clock, currentTimeSeconds()).WillRepeatedly(Return(1572085165));
+    repository->insert(Draft("first-title", "first-description"));
+    int firstId = getLastRowId();
+    std::vector<NotesChange> changes;
+    repository->subscribe([&changes](NotesChange change) {
+        changes.push_back(std::move(change));
+    });
+
+    repository->insert(Draft("second-title", "second-description"));
+    int secondId = getLastRowId();
+    repository->update(firstId, Draft("updated-title", "updated-description"));
+    repository->deleteWithId(secondId);
+
+    // The changes of the substring index aren't notified.
+    EXPECT_EQ(std::vector<NotesChange>({
+        NotesChange({secondId}, {}, {}),
+        NotesChange({}, {firstId}, {}),
+        NotesChange({}, {}, {secondId})
+    }), changes);
+}
+
+TEST_F(NotesRepositoryImplTest, givenChangesInTransactionWhenItIsCommittedThenCoalescedChangesAreNotified) {
+    EXPECT_CALL(*clock, currentTimeSeconds()).WillRepeatedly(Return(1572085165));
+    repository->insert(Draft("first-title", "first-description"));
+    int firstId = getLastRowId();
+    std::vector<NotesChange> changes;
+    repository->subscribe([&changes](NotesChange change) {
+        changes.push_back(std::move(change));
+    });
+
+    int secondId = 0;
+    db->executeTransaction([&] {
+        repository->insert(Draft("second-title", "second-description"));
+        secondId = getLastRowId();
+        repository->update(secondId, Draft("updated-title", "updated-description"));
+        repository->deleteWithId(firstId);
+    });
+
+    EXPECT_EQ(std::vector<NotesChange>({NotesChange({secondId}, {}, {firstId})}), changes);
+}
+
+TEST_F(NotesRepositoryImplTest, givenUnsubscribedListenerWhenNotesAreChangedThenItIsNotNotified) {
+    EXPECT_CALL(*clock, currentTimeSeconds()).WillRepeatedly(Return(1572085165));
+    int notifications = 0;
+    auto subscriptionId = repository->subscribe([&notifications](const NotesChange &) {
+        notifications++;
+    });
+
+    repository->unsubscribe(subscriptionId);
+    repository->insert(Draft("dummy-title", "dummy-description"));
+
+    EXPECT_EQ(0, notifications);
+}
+
+TEST_F(NotesRepositoryImplTest, givenOldNoteWhenGetByShortTextIsInvokedThenItIsFound) {
+    EXPECT_CALL(*clock, currentTimeSeconds()).WillRepeatedly(Return(1572085165));
+    repository->insert(Draft("old", "xy"));
+    int id = getLastRowId();
+    // More notes than the ones which were scanned for a short text, updated after the first one.
+    std::vector<std::tuple<std::string>> rows(10001, std::make_tuple(std::string("dummy")));
+    db->createStatement("INSERT INTO notes (title, description, last_update_date) VALUES (?, '', 1572085166)")->
+        executeBatch(rows);
+
+    auto notes = repository->getByText("xy");
+    auto matches = repository->getRankedByText("xy", 10);
+
+    ASSERT_EQ(1, notes.size());
+    EXPECT_EQ(id, notes[0].getId());
+    ASSERT_EQ(1, matches.size());
+    EXPECT_EQ(id, matches[0].getId());
+}
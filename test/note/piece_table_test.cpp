@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <stdexcept>
+#include <gtest/gtest.h>
+#include "note/piece_table.hpp"
+#include "core/test_exceptions_macros.hpp"
+
+TEST(PieceTableTest, givenOriginalTextWhenToStringIsInvokedThenOriginalTextIsReturned) {
+    auto table = PieceTable("dummy-text");
+
+    EXPECT_EQ("dummy-text", table.toString());
+    EXPECT_EQ(10, table.size());
+    EXPECT_EQ(1, table.pieceCount());
+}
+
+TEST(PieceTableTest, givenEmptyTextWhenInsertIsInvokedThenTextIsInserted) {
+    auto table = PieceTable();
+
+    table.insert(0, "dummy");
+
+    EXPECT_EQ("dummy", table.toString());
+    EXPECT_EQ(5, table.size());
+}
+
+TEST(PieceTableTest, givenOffsetsInsideTheTextWhenInsertIsInvokedThenTextIsInsertedAtTheOffsets) {
+    auto table = PieceTable("dummy-text");
+
+    table.insert(0, "[");
+    table.insert(6, "+");
+    table.insert(12, "]");
+
+    EXPECT_EQ("[dummy+-text]", table.toString());
+}
+
+TEST(PieceTableTest, givenConsecutiveInsertionsWhenInsertIsInvokedThenTheyShareOnePiece) {
+    auto table = PieceTable("dummy-text");
+
+    table.insert(5, "a");
+    table.insert(6, "b");
+    table.insert(7, "c");
+
+    EXPECT_EQ("dummyabc-text", table.toString());
+    // The original text is split in two pieces around the inserted one.
+    EXPECT_EQ(3, table.pieceCount());
+}
+
+TEST(PieceTableTest, givenRangesWhenEraseIsInvokedThenTheyAreDeleted) {
+    auto table = PieceTable("dummy-text");
+    table.insert(5, "abc");
+
+    // The range spans the inserted text and the original one.
+    table.erase(4, 5);
+    table.erase(0, 1);
+
+    EXPECT_EQ("ummtext", table.toString());
+    EXPECT_EQ(7, table.size());
+}
+
+TEST(PieceTableTest, givenTypedTextWhenEraseIsInvokedAtItsEndThenTextIsDeleted) {
+    auto table = PieceTable("dummy");
+    table.insert(5, "abc");
+
+    table.erase(7, 1);
+    table.erase(6, 1);
+    table.insert(6, "d");
+
+    EXPECT_EQ("dummyad", table.toString());
+    EXPECT_EQ(2, table.pieceCount());
+}
+
+TEST(PieceTableTest, givenWholeTextWhenEraseIsInvokedThenTextIsEmpty) {
+    auto table = PieceTable("dummy-text");
+    table.insert(10, "-other");
+
+    table.erase(0, 16);
+
+    EXPECT_EQ("", table.toString());
+    EXPECT_EQ(0, table.pieceCount());
+}
+
+TEST(PieceTableTest, givenManyScatteredEditsWhenTheyAreAppliedThenPiecesAreCompacted) {
+    auto table = PieceTable(std::string(2000, '-'));
+    std::string expected(2000, '-');
+
+    for (size_t i = 0; i < 1000; i++) {
+        auto offset = (i * 7919) % expected.size();
+        table.insert(offset, "x");
+        expected.insert(offset, "x");
+    }
+
+    EXPECT_EQ(expected, table.toString());
+    EXPECT_LE(table.pieceCount(), 514);
+}
+
+TEST(PieceTableTest, givenMixedEditsWhenTheyAreAppliedThenTextIsEqualToTheSameEditsOnString) {
+    auto table = PieceTable("dummy-text");
+    std::string expected("dummy-text");
+    unsigned int seed = 42;
+    auto next = [&seed]() {
+        // A linear congruential generator, so the edits are the same in every run.
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 16) & 0x7fff;
+    };
+
+    for (int i = 0; i < 5000; i++) {
+        auto offset = next() % (expected.size() + 1);
+        if (next() % 3 == 0 && offset < expected.size()) {
+            auto count = std::min<size_t>(next() % 4 + 1, expected.size() - offset);
+            table.erase(offset, count);
+            expected.erase(offset, count);
+        } else {
+            auto text = std::string(next() % 3 + 1, static_cast<char>('a' + i % 26));
+            table.insert(offset, text);
+            expected.insert(offset, text);
+        }
+        ASSERT_EQ(expected.size(), table.size());
+    }
+
+    EXPECT_EQ(expected, table.toString());
+}
+
+TEST(PieceTableTest, givenOffsetAfterTheEndWhenInsertIsInvokedThenExceptionIsThrown) {
+    auto table = PieceTable("dummy");
+
+    ASSERT_LIB_THROW(table.insert(6, "x"), std::out_of_range);
+}
+
+TEST(PieceTableTest, givenRangeAfterTheEndWhenEraseIsInvokedThenExceptionIsThrown) {
+    auto table = PieceTable("dummy");
+
+    ASSERT_LIB_THROW(table.erase(3, 3), std::out_of_range);
+}
+
+TEST(PieceTableTest, givenRangeAfterTheEndWhenCheckRangeIsInvokedThenExceptionIsThrownAndTextIsNotChanged) {
+    auto table = PieceTable("dummy");
+
+    table.checkRange(5, 0);
+    table.checkRange(2, 3);
+    ASSERT_LIB_THROW(table.checkRange(6, 0), std::out_of_range);
+    ASSERT_LIB_THROW(table.checkRange(3, 3), std::out_of_range);
+    EXPECT_EQ("dummy", table.toString());
+}
+
+TEST(PieceTableTest, givenSameTextWithDifferentPiecesWhenEqualityOperatorIsInvokedThenItReturnsTrue) {
+    auto first = PieceTable("dummy-text");
+    auto second = PieceTable("dummy");
+    second.insert(5, "-text");
+
+    EXPECT_TRUE(first == second);
+}
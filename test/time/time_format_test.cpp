@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
+#include <iomanip>
+#include <sstream>
 #include "core/include_macros.hpp"
+#include "core/test_exceptions_macros.hpp"
 #include AMALGAMATION(time_format.hpp)
 
 TEST(TimeFormatTest, givenTimeInSecondsWhenFormatIsInvokedThenISO_8601TimeIsReturned) {
@@ -8,8 +11,76 @@ TEST(TimeFormatTest, givenTimeInSecondsWhenFormatIsInvokedThenISO_8601TimeIsRetu
     ASSERT_EQ("2019-10-26T10:19:25Z", formattedTime);
 }
 
+TEST(TimeFormatTest, givenBufferWhenFormatIsInvokedThenTimeIsWrittenWithoutTerminator) {
+    char buffer[Time::Format::length + 1];
+    buffer[Time::Format::length] = '#';
+
+    auto end = Time::Format::format(1572085165, buffer);
+
+    EXPECT_EQ(buffer + Time::Format::length, end);
+    EXPECT_EQ("2019-10-26T10:19:25Z#", std::string(buffer, Time::Format::length + 1));
+}
+
+TEST(TimeFormatTest, givenLimitTimesWhenFormatIsInvokedThenDatesAreCorrect) {
+    EXPECT_EQ("1970-01-01T00:00:00Z", Time::Format::format(0));
+    EXPECT_EQ("1969-12-31T23:59:59Z", Time::Format::format(-1));
+    EXPECT_EQ("2000-02-29T12:00:00Z", Time::Format::format(951825600));
+    EXPECT_EQ("2038-01-19T03:14:08Z", Time::Format::format(static_cast<std::time_t>(2147483648LL)));
+    EXPECT_EQ("0000-01-01T00:00:00Z", Time::Format::format(static_cast<std::time_t>(-62167219200LL)));
+    EXPECT_EQ("9999-12-31T23:59:59Z", Time::Format::format(static_cast<std::time_t>(253402300799LL)));
+}
+
+TEST(TimeFormatTest, givenTimeOutsideSupportedYearsWhenFormatIsInvokedThenExceptionIsThrown) {
+    EXPECT_LIB_THROW(Time::Format::format(static_cast<std::time_t>(-62167219201LL)), std::out_of_range);
+    EXPECT_LIB_THROW(Time::Format::format(static_cast<std::time_t>(253402300800LL)), std::out_of_range);
+}
+
 TEST(TimeFormatTest, givenISO_8601TimeWhenParseIsInvokedThenTimeInSecondsIsReturned) {
     time_t time = Time::Format::parse("2019-10-26T10:19:25Z");
 
     ASSERT_EQ(1572085165, time);
-}
\ No newline at end of file
+}
+
+TEST(TimeFormatTest, givenInvalidTimeWhenParseIsInvokedThenExceptionIsThrown) {
+    EXPECT_LIB_THROW(Time::Format::parse("2019-10-26 10:19:25"), std::invalid_argument);
+}
+
+TEST(TimeFormatTest, givenInvalidTimesWhenTryParseIsInvokedThenEmptyOptionalIsReturned) {
+    // Wrong length or separators.
+    EXPECT_FALSE(Time::Format::tryParse(""));
+    EXPECT_FALSE(Time::Format::tryParse("2019-10-26T10:19:25"));
+    EXPECT_FALSE(Time::Format::tryParse("2019-10-26T10:19:25+00:00"));
+    EXPECT_FALSE(Time::Format::tryParse("2019/10/26T10:19:25Z"));
+    EXPECT_FALSE(Time::Format::tryParse("2019-10-26 10:19:25Z"));
+    // Characters which aren't digits.
+    EXPECT_FALSE(Time::Format::tryParse("2O19-10-26T10:19:25Z"));
+    EXPECT_FALSE(Time::Format::tryParse("2019-10-2+T10:19:25Z"));
+    // Fields out of range.
+    EXPECT_FALSE(Time::Format::tryParse("2019-00-26T10:19:25Z"));
+    EXPECT_FALSE(Time::Format::tryParse("2019-13-26T10:19:25Z"));
+    EXPECT_FALSE(Time::Format::tryParse("2019-10-00T10:19:25Z"));
+    EXPECT_FALSE(Time::Format::tryParse("2019-04-31T10:19:25Z"));
+    EXPECT_FALSE(Time::Format::tryParse("2019-02-29T10:19:25Z"));
+    EXPECT_FALSE(Time::Format::tryParse("1900-02-29T10:19:25Z"));
+    EXPECT_FALSE(Time::Format::tryParse("2019-10-26T24:00:00Z"));
+    EXPECT_FALSE(Time::Format::tryParse("2019-10-26T10:60:25Z"));
+    EXPECT_FALSE(Time::Format::tryParse("2019-10-26T10:19:60Z"));
+}
+
+TEST(TimeFormatTest, givenLeapDaysWhenTryParseIsInvokedThenTimeIsReturned) {
+    EXPECT_EQ(951782400, *Time::Format::tryParse("2000-02-29T00:00:00Z"));
+    EXPECT_EQ(1582934400, *Time::Format::tryParse("2020-02-29T00:00:00Z"));
+}
+
+TEST(TimeFormatTest, givenTimesWhenFormatAndParseAreInvokedThenTheyMatchTheStandardLibrary) {
+    // One time every 5 days and 7 hours, from 1900 to 2100.
+    for (long long time = -2208988800LL; time < 4102444800LL; time += 457200 + 1) {
+        auto formattedTime = Time::Format::format(static_cast<std::time_t>(time));
+
+        tm tm{};
+        std::istringstream ss(formattedTime);
+        ss >> std::get_time(&tm, "%Y-%m-%dT%H:%M:%SZ");
+        ASSERT_EQ(time, static_cast<long long>(timegm(&tm))) << formattedTime;
+        ASSERT_EQ(time, static_cast<long long>(Time::Format::parse(formattedTime))) << formattedTime;
+    }
+}